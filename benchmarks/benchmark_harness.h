@@ -0,0 +1,120 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <chrono>           // For std::chrono::steady_clock
+#include <cstdint>          // For uint64_t
+#include <cstdio>           // For printf
+#include <cstdlib>          // For atoi
+#include <cstring>          // For strcmp, strstr
+#include <algorithm>        // For std::sort
+
+// =============================================================================
+// CONSTANTS - Benchmark runs
+// =============================================================================
+
+const int BENCHMARK_DEFAULT_MIN_TIME_MS = 200;  // Each repetition runs at least this long
+const int BENCHMARK_DEFAULT_REPETITIONS = 5;    // Median and minimum over this many repetitions
+const int BENCHMARK_MAX_REPETITIONS = 32;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+// Keeps a computed value alive, so the compiler cannot drop the work that produced it
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Prevents the compiler from caching memory across this point
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+// =============================================================================
+// BENCHMARK RUNNER - Self-contained harness (no Google Benchmark needed)
+// =============================================================================
+
+/*
+* Runs benchmark bodies and prints one table line each
+*
+* A body gets an iteration count and runs its operation that often:
+*
+*   runner.run("decode/knob_values", [&](uint64_t iterations) {
+*       for (uint64_t i = 0; i < iterations; i++) { ... }
+*   });
+*
+* The iteration count grows until one repetition takes --min-time-ms, then the
+* body is repeated --repetitions times. Median and minimum ns/op are printed,
+* so before/after numbers of a change can be compared line by line.
+*
+* Command line: [--filter text] [--min-time-ms n] [--repetitions n]
+*/
+class BenchmarkRunner {
+private:
+    const char* filter = nullptr;
+    int min_time_ms = BENCHMARK_DEFAULT_MIN_TIME_MS;
+    int repetitions = BENCHMARK_DEFAULT_REPETITIONS;
+
+    template <typename Body>
+    static double timeRun(Body& body, uint64_t iterations) {
+        auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+public:
+    // @return: false on invalid options (usage is printed)
+    bool parseArguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+                filter = argv[++i];
+            } else if (strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+                min_time_ms = std::max(1, atoi(argv[++i]));
+            } else if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+                repetitions = std::min(std::max(1, atoi(argv[++i])), BENCHMARK_MAX_REPETITIONS);
+            } else {
+                printf("Usage: %s [--filter text] [--min-time-ms n] [--repetitions n]\n", argv[0]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void printHeader() const {
+        printf("%-44s %14s %14s %14s\n", "Benchmark", "ns/op median", "ns/op min", "iterations");
+        printf("%-44s %14s %14s %14s\n", "---------", "------------", "---------", "----------");
+    }
+
+    template <typename Body>
+    void run(const char* name, Body body) {
+        // Step 1: Skip benchmarks not matching --filter
+        if (filter != nullptr && strstr(name, filter) == nullptr) {
+            return;
+        }
+
+        // Step 2: Warm up and find an iteration count that takes min_time_ms
+        double min_time_ns = min_time_ms * 1e6;
+        uint64_t iterations = 1;
+        double elapsed_ns = timeRun(body, iterations);
+        while (elapsed_ns < min_time_ns) {
+            double factor = elapsed_ns > 0.0 ? (min_time_ns / elapsed_ns) * 1.2 : 10.0;
+            factor = std::min(std::max(factor, 2.0), 100.0);
+            iterations = (uint64_t)(iterations * factor);
+            elapsed_ns = timeRun(body, iterations);
+        }
+
+        // Step 3: Repeat, report median and minimum
+        double ns_per_op[BENCHMARK_MAX_REPETITIONS];
+        for (int r = 0; r < repetitions; r++) {
+            ns_per_op[r] = timeRun(body, iterations) / (double)iterations;
+        }
+        std::sort(ns_per_op, ns_per_op + repetitions);
+        printf("%-44s %14.2f %14.2f %14llu\n", name, ns_per_op[repetitions / 2], ns_per_op[0],
+               (unsigned long long)iterations);
+        fflush(stdout);
+    }
+};
+
+#endif // BENCHMARK_HARNESS_H
@@ -0,0 +1,253 @@
+// Hot path benchmarks against a mock F1 (no hidapi, no hardware)
+// Build: cmake -S benchmarks -B build-bench && cmake --build build-bench
+// Run:   ./build-bench/traktor_benchmark [--filter text] [--min-time-ms n] [--repetitions n]
+
+#include <cstdint>
+#include <cstring>
+
+#include "benchmark_harness.h"              // BenchmarkRunner, doNotOptimize
+#include "mock_hid_device.h"                // Mock F1 (hid_write counts, scripted reads)
+#include "headers/input_reader.h"           // isMatrixButtonPressed, isSpecialButtonPressed
+#include "headers/input_reader_knob.h"      // KnobInputReader
+#include "headers/input_reader_fader.h"     // FaderInputReader
+#include "headers/led_controller.h"         // getColorWithBrightness, LED frames
+#include "headers/led_controller_toggle.h"  // ButtonToggleSystem
+#include "headers/led_scene_controller.h"   // SceneController
+
+
+// =============================================================================
+// TEST INPUT - Deterministic input reports
+// =============================================================================
+
+const int BENCH_REPORT_COUNT = 64;      // Power of two, reports are picked with & (count - 1)
+
+static unsigned char random_reports[BENCH_REPORT_COUNT][INPUT_REPORT_SIZE];
+static unsigned char press_release_reports[BENCH_REPORT_COUNT][INPUT_REPORT_SIZE];
+static unsigned char idle_report[INPUT_REPORT_SIZE];
+
+/*
+* xorshift32 - same sequence on every run, so numbers are comparable
+*/
+static uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*
+* Fills the report sets
+* random_reports: random buttons and 12-bit analog values
+* press_release_reports: pad n pressed, all released, pad n+1 pressed, ... (one toggle edge per report)
+*/
+static void buildReports() {
+    uint32_t state = 0x1234567u;
+    for (int r = 0; r < BENCH_REPORT_COUNT; r++) {
+        unsigned char* report = random_reports[r];
+        report[0] = INPUT_REPORT_ID;
+        for (int i = 1; i < INPUT_REPORT_SIZE; i++) {
+            report[i] = (unsigned char)nextRandom(state);
+        }
+        for (int i = KNOB_BYTE_START + 1; i < INPUT_REPORT_SIZE; i += 2) {
+            report[i] &= 0x0f;      // 12-bit values, MSB byte holds 4 bits
+        }
+    }
+
+    memset(idle_report, 0, sizeof(idle_report));
+    idle_report[0] = INPUT_REPORT_ID;
+
+    for (int r = 0; r < BENCH_REPORT_COUNT; r++) {
+        unsigned char* report = press_release_reports[r];
+        memcpy(report, idle_report, INPUT_REPORT_SIZE);
+        if (r % 2 == 0) {
+            int pad = (r / 2) % 16;
+            report[BUTTON_BYTE_MATRIX_TOP + pad / 8] = (unsigned char)(0x80 >> (pad % 8));
+        }
+    }
+}
+
+
+// =============================================================================
+// BENCHMARKS - Report decoding
+// =============================================================================
+
+static void benchmarkDecoding(BenchmarkRunner& runner) {
+    runner.run("decode/isMatrixButtonPressed x16", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            const unsigned char* report = random_reports[i & (BENCH_REPORT_COUNT - 1)];
+            int pressed = 0;
+            for (int pad = 0; pad < MATRIX_PAD_COUNT; pad++) {
+                pressed += isMatrixButtonPressed(report, MatrixPad::fromIndex(pad));
+            }
+            doNotOptimize(pressed);
+        }
+    });
+
+    runner.run("decode/isSpecialButtonPressed x6", [](uint64_t iterations) {
+        static const SpecialButton buttons[] = { SpecialButton::SHIFT, SpecialButton::REVERSE, SpecialButton::TYPE,
+                                                 SpecialButton::SIZE, SpecialButton::BROWSE, SpecialButton::SELECTOR_WHEEL };
+        for (uint64_t i = 0; i < iterations; i++) {
+            const unsigned char* report = random_reports[i & (BENCH_REPORT_COUNT - 1)];
+            int pressed = 0;
+            for (SpecialButton button : buttons) {
+                pressed += isSpecialButtonPressed(report, button);
+            }
+            doNotOptimize(pressed);
+        }
+    });
+
+    runner.run("decode/getPressedButtonMask", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            uint32_t mask = ButtonToggleSystem::getPressedButtonMask(random_reports[i & (BENCH_REPORT_COUNT - 1)]);
+            doNotOptimize(mask);
+        }
+    });
+
+    KnobInputReader knob_reader;
+    knob_reader.initialize();
+    runner.run("decode/getKnobValue x4", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            const unsigned char* report = random_reports[i & (BENCH_REPORT_COUNT - 1)];
+            float sum = 0.0f;
+            for (int knob = 1; knob <= KNOB_COUNT; knob++) {
+                sum += knob_reader.getKnobValue(report, knob);
+            }
+            doNotOptimize(sum);
+        }
+    });
+
+    FaderInputReader fader_reader;
+    fader_reader.initialize();
+    runner.run("decode/getFaderValue x4", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            const unsigned char* report = random_reports[i & (BENCH_REPORT_COUNT - 1)];
+            float sum = 0.0f;
+            for (int fader = 1; fader <= FADER_COUNT; fader++) {
+                sum += fader_reader.getFaderValue(report, fader);
+            }
+            doNotOptimize(sum);
+        }
+    });
+
+    runner.run("decode/hasKnobMoved+hasFaderMoved x8", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            const unsigned char* report = random_reports[i & (BENCH_REPORT_COUNT - 1)];
+            int moved = 0;
+            for (int n = 1; n <= KNOB_COUNT; n++) {
+                moved += knob_reader.hasKnobMoved(report, n);
+                moved += fader_reader.hasFaderMoved(report, n);
+            }
+            doNotOptimize(moved);
+        }
+    });
+}
+
+
+// =============================================================================
+// BENCHMARKS - Colors and LED frames
+// =============================================================================
+
+static void benchmarkLEDs(BenchmarkRunner& runner) {
+    runner.run("color/getColorWithBrightness", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            LEDColor color = (LEDColor)(i % LED_COLOR_COUNT);
+            float brightness = (float)(i & 7) * (1.0f / 7.0f);
+            BRGColor result = getColorWithBrightness(color, brightness);
+            doNotOptimize(result);
+        }
+    });
+
+    // 16 pads change every frame: one hid_write per frame
+    runner.run("led/frame 16 pads changed", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            beginLEDFrame();
+            for (int pad = 0; pad < 16; pad++) {
+                LEDColor color = (LEDColor)(1 + (pad + i) % (LED_COLOR_COUNT - 1));
+                setMatrixButtonLED(MatrixPad::fromIndex(pad), color, 1.0f, false);
+            }
+            endLEDFrame();
+        }
+    });
+
+    // Same colors every frame: the frame is assembled, the write is skipped
+    runner.run("led/frame 16 pads unchanged", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            beginLEDFrame();
+            for (int pad = 0; pad < 16; pad++) {
+                setMatrixButtonLED(MatrixPad::fromIndex(pad), LEDColor::blue, 0.5f, false);
+            }
+            endLEDFrame();
+        }
+    });
+}
+
+
+// =============================================================================
+// BENCHMARKS - Toggle processing and scene loading
+// =============================================================================
+
+static void benchmarkToggles(BenchmarkRunner& runner, ButtonToggleSystem& toggle_system) {
+    // Common case: report without button edges
+    runner.run("toggle/processInputReport idle", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            beginLEDFrame();
+            toggle_system.processInputReport(idle_report, i);
+            endLEDFrame();
+        }
+    });
+
+    // Every report is a pad press or release (latch toggles LEDs on press)
+    runner.run("toggle/processInputReport press/release", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            beginLEDFrame();
+            toggle_system.processInputReport(press_release_reports[i & (BENCH_REPORT_COUNT - 1)], i);
+            endLEDFrame();
+        }
+    });
+
+    runner.run("toggle/updateTimedBehaviors", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            toggle_system.updateTimedBehaviors(i);
+        }
+    });
+
+    // Page load as on a selector wheel press: scene, zones and behaviors in one LED frame
+    runner.run("scene/load page (scene+zones+behaviors)", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            int page = 1 + (int)(i % 3);
+            beginLEDFrame();
+            SceneController::setEffectsPageScene(page);
+            SceneController::setEffectsPageZones(toggle_system, page);
+            SceneController::setEffectsPageBehaviors(toggle_system, page);
+            toggle_system.resetAllToggleStates();
+            endLEDFrame();
+        }
+    });
+}
+
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner;
+    if (!runner.parseArguments(argc, argv)) {
+        return 1;
+    }
+
+    // Mock F1: LED reports go to memory
+    buildReports();
+    const int mock_index = 0;
+    hid_device* device = mockHidOpenDevice(mock_index);
+    if (!initializeLEDController(device)) {
+        return 1;
+    }
+    ButtonToggleSystem toggle_system;
+    toggle_system.initialize();
+    printf("\n");
+
+    runner.printHeader();
+    benchmarkDecoding(runner);
+    benchmarkLEDs(runner);
+    benchmarkToggles(runner, toggle_system);
+
+    printf("\nMock F1 LED reports written: %llu\n", (unsigned long long)mockHidGetWriteCount(mock_index));
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include "headers/allocation_counter.h"     // Include header file
+
+#ifdef TRAKTOR_COUNT_ALLOCATIONS
+
+#include <atomic>               // For std::atomic (counters shared by all threads)
+#include <cstdlib>              // For std::malloc, std::aligned_alloc, std::free
+#include <cerrno>               // For EINVAL, ENOMEM (posix_memalign)
+#include <new>                  // For std::bad_alloc, std::align_val_t, std::nothrow_t
+#include <execinfo.h>           // For backtrace, backtrace_symbols_fd
+#include <unistd.h>             // For write, STDERR_FILENO
+
+// =============================================================================
+// STATE
+// =============================================================================
+
+static std::atomic<uint64_t> allocation_count{0};
+static std::atomic<uint64_t> allocated_bytes{0};
+static constinit thread_local uint64_t thread_allocation_count = 0;
+static std::atomic<bool> print_backtraces{false};
+static constinit thread_local bool printing_backtrace = false;     // backtrace() itself may allocate
+
+const int ALLOCATION_BACKTRACE_DEPTH = 24;
+
+/*
+* Counts one allocation (and prints where it came from if asked to)
+*/
+static void countAllocation(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    thread_allocation_count++;
+
+    if (print_backtraces.load(std::memory_order_relaxed) && !printing_backtrace) {
+        printing_backtrace = true;
+        static const char header[] = "Allocation Counter: allocation in a checked section\n";
+        ssize_t written = write(STDERR_FILENO, header, sizeof(header) - 1);
+        (void)written;
+        void* frames[ALLOCATION_BACKTRACE_DEPTH];
+        int frame_count = backtrace(frames, ALLOCATION_BACKTRACE_DEPTH);
+        backtrace_symbols_fd(frames, frame_count, STDERR_FILENO);
+        printing_backtrace = false;
+    }
+}
+
+// =============================================================================
+// SYSTEM ALLOCATOR - What the replacements forward to
+// =============================================================================
+
+#ifdef __GLIBC__
+// glibc's own entry points, so malloc can be replaced without recursion
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* pointer, size_t size);
+extern "C" void* __libc_memalign(size_t alignment, size_t size);
+
+static void* allocateRaw(size_t size) {
+    return __libc_malloc(size);
+}
+
+static void* allocateAlignedRaw(size_t alignment, size_t size) {
+    return __libc_memalign(alignment, size);
+}
+#else
+static void* allocateRaw(size_t size) {
+    return std::malloc(size);
+}
+
+static void* allocateAlignedRaw(size_t alignment, size_t size) {
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+#endif
+
+static void* allocateOrThrow(size_t size) {
+    countAllocation(size);
+    void* pointer = allocateRaw(size != 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+static void* allocateAlignedOrThrow(size_t size, std::align_val_t alignment) {
+    countAllocation(size);
+    void* pointer = allocateAlignedRaw((size_t)alignment, size != 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+// =============================================================================
+// OPERATOR NEW / DELETE - Every form the standard library can call
+// =============================================================================
+
+void* operator new(size_t size) { return allocateOrThrow(size); }
+void* operator new[](size_t size) { return allocateOrThrow(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    countAllocation(size);
+    return allocateRaw(size != 0 ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    countAllocation(size);
+    return allocateRaw(size != 0 ? size : 1);
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    countAllocation(size);
+    return allocateAlignedRaw((size_t)alignment, size != 0 ? size : 1);
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    countAllocation(size);
+    return allocateAlignedRaw((size_t)alignment, size != 0 ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+// =============================================================================
+// MALLOC FAMILY - glibc only (other C libraries cannot be replaced this way)
+// =============================================================================
+
+#ifdef __GLIBC__
+extern "C" {
+
+void* malloc(size_t size) {
+    countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+    countAllocation(size);
+    return __libc_realloc(pointer, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size) {
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    countAllocation(size);
+    void* pointer = __libc_memalign(alignment, size);
+    if (pointer == nullptr) {
+        return ENOMEM;
+    }
+    *result = pointer;
+    return 0;
+}
+
+}
+#endif
+
+// =============================================================================
+// COUNTERS
+// =============================================================================
+
+uint64_t getAllocationCount() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+uint64_t getAllocatedBytes() {
+    return allocated_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t getThreadAllocationCount() {
+    return thread_allocation_count;
+}
+
+bool isAllocationCountingEnabled() {
+    return true;
+}
+
+void setAllocationBacktraces(bool enabled) {
+    if (enabled) {
+        // The first backtrace() loads the unwinder (and allocates), do it now
+        printing_backtrace = true;
+        void* frames[1];
+        backtrace(frames, 1);
+        printing_backtrace = false;
+    }
+    print_backtraces.store(enabled);
+}
+
+#else
+
+// =============================================================================
+// COUNTERS - Not compiled in
+// =============================================================================
+
+uint64_t getAllocationCount() {
+    return 0;
+}
+
+uint64_t getAllocatedBytes() {
+    return 0;
+}
+
+uint64_t getThreadAllocationCount() {
+    return 0;
+}
+
+bool isAllocationCountingEnabled() {
+    return false;
+}
+
+void setAllocationBacktraces(bool) {
+}
+
+#endif
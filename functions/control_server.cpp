@@ -0,0 +1,529 @@
+#include "headers/control_server.h"     // Include header file
+
+#include <iostream>                     // For std::cout and std::cerr
+#include <cstdio>                       // For snprintf
+#include <cstring>                      // For strcmp, strlen, memcpy, memmove, strtok_r
+#include <cstdlib>                      // For strtol, strtof
+#include <cerrno>                       // For errno
+#include <unistd.h>                     // For ::close, read, unlink
+#include <poll.h>                       // For poll
+#include <sys/socket.h>                 // For socket, bind, listen, accept, send
+#include <sys/un.h>                     // For sockaddr_un
+#include <sys/stat.h>                   // For lstat, S_ISSOCK (stale socket check)
+
+// =============================================================================
+// CONSTANTS - Names used in commands
+// =============================================================================
+
+// Same order as SpecialLEDButton / ControlLEDButton
+static const char* const SPECIAL_BUTTON_NAMES[5] = {"browse", "size", "type", "reverse", "shift"};
+static const char* const CONTROL_BUTTON_NAMES[3] = {"capture", "quant", "sync"};
+
+static const SpecialLEDButton SPECIAL_BUTTONS[5] = {
+    SpecialLEDButton::BROWSE, SpecialLEDButton::SIZE, SpecialLEDButton::TYPE,
+    SpecialLEDButton::REVERSE, SpecialLEDButton::SHIFT
+};
+static const ControlLEDButton CONTROL_BUTTONS[3] = {
+    ControlLEDButton::CAPTURE, ControlLEDButton::QUANT, ControlLEDButton::SYNC
+};
+static const StopLEDButton STOP_BUTTONS[4] = {
+    StopLEDButton::STOP1, StopLEDButton::STOP2, StopLEDButton::STOP3, StopLEDButton::STOP4
+};
+
+struct ZoneModeName {
+    const char* name;
+    MatrixToggleZone mode;
+};
+
+static const ZoneModeName ZONE_MODE_NAMES[] = {
+    {"full", MatrixToggleZone::FULL_MATRIX},
+    {"split", MatrixToggleZone::LEFT_RIGHT_SPLIT},
+    {"rows", MatrixToggleZone::ROWS},
+    {"columns", MatrixToggleZone::COLUMNS},
+    {"quadrants", MatrixToggleZone::QUADRANTS},
+    {"free", MatrixToggleZone::FREE}
+};
+
+// =============================================================================
+// COMMAND PARSING
+// =============================================================================
+
+// Parse whole-string integer in range
+static bool parseInt(const char* text, int min_value, int max_value, int& value) {
+    if (text == nullptr) return false;
+    char* end = nullptr;
+    long number = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || number < min_value || number > max_value) return false;
+    value = (int)number;
+    return true;
+}
+
+// Parse whole-string brightness 0.0-1.0
+static bool parseBrightness(const char* text, float& value) {
+    if (text == nullptr) return false;
+    char* end = nullptr;
+    value = strtof(text, &end);
+    return end != text && *end == '\0' && value >= 0.0f && value <= 1.0f;
+}
+
+/*
+* Parses one command of a request
+*
+* @param text: Command text, split in place
+* @param command: Receives the parsed command
+* @param error: Receives the reason on failure
+* @return: true if the command is valid
+*/
+bool parseControlCommand(char* text, ControlCommand& command, const char*& error) {
+    // Step 1: Split into words
+    const char* words[7] = {};
+    int word_count = 0;
+    char* save = nullptr;
+    for (char* word = strtok_r(text, " \t", &save); word != nullptr; word = strtok_r(nullptr, " \t", &save)) {
+        if (word_count == 7) {
+            error = "too many arguments";
+            return false;
+        }
+        words[word_count++] = word;
+    }
+    if (word_count == 0) {
+        error = "empty command";
+        return false;
+    }
+
+    command = {};
+    int number = 0;
+
+    // Step 2: LED commands
+    if (strcmp(words[0], "led") == 0 && word_count >= 2) {
+        if (strcmp(words[1], "matrix") == 0) {
+            int row, col;
+            if (word_count < 5 || word_count > 6 || !parseInt(words[2], 1, 4, row) || !parseInt(words[3], 1, 4, col)) {
+                error = "usage: led matrix <row 1-4> <col 1-4> <color> [brightness]";
+                return false;
+            }
+            if (!getLEDColorByName(words[4], command.color)) {
+                error = "unknown color";
+                return false;
+            }
+            command.brightness = 1.0f;
+            if (word_count == 6 && !parseBrightness(words[5], command.brightness)) {
+                error = "brightness must be 0.0-1.0";
+                return false;
+            }
+            command.type = ControlCommandType::MATRIX_LED;
+            MatrixPad::fromRowCol(row, col, command.pad);
+            return true;
+        }
+        if (strcmp(words[1], "button") == 0) {
+            if (word_count != 4 || !parseBrightness(words[3], command.brightness)) {
+                error = "usage: led button <name> <brightness 0.0-1.0>";
+                return false;
+            }
+            for (int i = 0; i < 5; i++) {
+                if (strcmp(words[2], SPECIAL_BUTTON_NAMES[i]) == 0) {
+                    command.type = ControlCommandType::SPECIAL_LED;
+                    command.button_index = (uint8_t)i;
+                    return true;
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                if (strcmp(words[2], CONTROL_BUTTON_NAMES[i]) == 0) {
+                    command.type = ControlCommandType::CONTROL_LED;
+                    command.button_index = (uint8_t)i;
+                    return true;
+                }
+            }
+            error = "unknown button";
+            return false;
+        }
+        if (strcmp(words[1], "stop") == 0) {
+            if (word_count != 4 || !parseInt(words[2], 1, 4, number) || !parseBrightness(words[3], command.brightness)) {
+                error = "usage: led stop <1-4> <brightness 0.0-1.0>";
+                return false;
+            }
+            command.type = ControlCommandType::STOP_LED;
+            command.button_index = (uint8_t)(number - 1);
+            return true;
+        }
+        error = "unknown led target";
+        return false;
+    }
+
+    // Step 3: Display commands
+    if (strcmp(words[0], "display") == 0 && word_count == 3) {
+        if (strcmp(words[1], "number") == 0 && parseInt(words[2], 1, 99, command.value)) {
+            command.type = ControlCommandType::DISPLAY_NUMBER;
+            return true;
+        }
+        if (strcmp(words[1], "text") == 0 && strlen(words[2]) <= 2) {
+            command.type = ControlCommandType::DISPLAY_TEXT;
+            memcpy(command.text, words[2], strlen(words[2]) + 1);
+            return true;
+        }
+        error = "usage: display number <1-99> | display text <1-2 characters>";
+        return false;
+    }
+
+    // Step 4: Page and zone commands
+    if (strcmp(words[0], "page") == 0) {
+        if (word_count != 2 || !parseInt(words[1], 1, 99, command.value)) {
+            error = "usage: page <1-99>";
+            return false;
+        }
+        command.type = ControlCommandType::LOAD_PAGE;
+        return true;
+    }
+    if (strcmp(words[0], "zone") == 0) {
+        if (word_count == 2) {
+            for (const ZoneModeName& entry : ZONE_MODE_NAMES) {
+                if (strcmp(words[1], entry.name) == 0) {
+                    command.type = ControlCommandType::ZONE_MODE;
+                    command.zone_mode = entry.mode;
+                    return true;
+                }
+            }
+        }
+        error = "usage: zone <full|split|rows|columns|quadrants|free>";
+        return false;
+    }
+
+    error = "unknown command";
+    return false;
+}
+
+// =============================================================================
+// CONTROL SERVER - Setup
+// =============================================================================
+
+/*
+* Binds the Unix socket and starts the socket thread
+* All socket work happens on that thread; the main loop only pops batches
+*
+* @param path: Socket path (an old socket file at this path is replaced)
+* @param state_segment: Snapshot for "state" queries (may be nullptr)
+* @return: true if the server is running
+*/
+/*
+* Removes a socket file left over after a crash
+* Anything else at the path (a regular file, a socket another instance still
+* listens on) is kept and reported
+*
+* @param address: Address of the control socket
+* @return: true if the path is free now, false if it must not be used
+*/
+static bool removeStaleSocket(const sockaddr_un& address) {
+    // Step 1: Nothing there - nothing to do
+    struct stat file_info;
+    if (lstat(address.sun_path, &file_info) != 0) {
+        return errno == ENOENT;
+    }
+    if (!S_ISSOCK(file_info.st_mode)) {
+        std::cerr << "ControlServer Error: " << address.sun_path << " exists and is not a socket" << std::endl;
+        return false;
+    }
+
+    // Step 2: A socket that still accepts connections belongs to a running instance
+    int probe_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe_fd < 0) {
+        return false;
+    }
+    bool in_use = connect(probe_fd, (const sockaddr*)&address, sizeof(address)) == 0;
+    ::close(probe_fd);
+    if (in_use) {
+        std::cerr << "ControlServer Error: " << address.sun_path << " is in use by another instance" << std::endl;
+        return false;
+    }
+
+    // Step 3: Stale socket file
+    return unlink(address.sun_path) == 0;
+}
+
+bool ControlServer::start(const char* path, const SharedStateSegment* state_segment_in) {
+    stop();
+
+    // Step 1: Check path
+    if (path == nullptr || strlen(path) >= sizeof(socket_path)) {
+        std::cerr << "ControlServer Error: Invalid socket path" << std::endl;
+        return false;
+    }
+
+    // Step 2: Bind and listen (only a stale socket file left over after a crash is replaced)
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path, strlen(path) + 1);
+    if (!removeStaleSocket(address)) {
+        std::cerr << "ControlServer Error: Cannot use " << path << " for the control socket" << std::endl;
+        return false;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "ControlServer Error: Cannot open Unix socket" << std::endl;
+        return false;
+    }
+
+    if (bind(fd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(fd, CONTROL_MAX_CLIENTS) != 0) {
+        std::cerr << "ControlServer Error: Cannot listen on " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    // Step 3: Reset clients and start thread
+    listen_fd = fd;
+    memcpy(socket_path, path, strlen(path) + 1);
+    state_segment = state_segment_in;
+    for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+        client_fds[i] = -1;
+        client_line_lengths[i] = 0;
+    }
+    stop_requested.store(false);
+    server_thread = std::thread(&ControlServer::run, this);
+
+    std::cout << "- Control socket listening on " << path << std::endl;
+    return true;
+}
+
+/*
+* Stops the socket thread, closes all connections and removes the socket file
+*/
+void ControlServer::stop() {
+    if (server_thread.joinable()) {
+        stop_requested.store(true);
+        server_thread.join();
+    }
+    if (listen_fd >= 0) {
+        ::close(listen_fd);
+        listen_fd = -1;
+        unlink(socket_path);
+    }
+}
+
+bool ControlServer::isRunning() const {
+    return listen_fd >= 0;
+}
+
+ControlServer::~ControlServer() {
+    stop();
+}
+
+bool ControlServer::popBatch(ControlBatch& batch) {
+    return batch_queue.pop(batch);
+}
+
+// =============================================================================
+// CONTROL SERVER - Socket thread
+// =============================================================================
+
+/*
+* Sends a reply to a client
+* MSG_NOSIGNAL: a client that already disconnected gives EPIPE instead of SIGPIPE
+*
+* @return: false if the client is gone (drop it)
+*/
+static bool sendReply(int fd, const char* reply, size_t length) {
+    return send(fd, reply, length, MSG_NOSIGNAL) >= 0;
+}
+
+/*
+* Socket thread: waits for new clients and request lines
+* Wakes up every CONTROL_POLL_TIMEOUT_MS to check the stop flag
+*/
+void ControlServer::run() {
+    while (!stop_requested.load()) {
+        // Step 1: Collect listening socket and clients
+        pollfd fds[1 + CONTROL_MAX_CLIENTS];
+        int slots[1 + CONTROL_MAX_CLIENTS];
+        int count = 0;
+        fds[count] = {listen_fd, POLLIN, 0};
+        slots[count++] = -1;
+        for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+            if (client_fds[i] >= 0) {
+                fds[count] = {client_fds[i], POLLIN, 0};
+                slots[count++] = i;
+            }
+        }
+
+        // Step 2: Wait for activity
+        if (poll(fds, count, CONTROL_POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+
+        // Step 3: Handle it
+        for (int i = 0; i < count; i++) {
+            if (fds[i].revents == 0) continue;
+            if (slots[i] < 0) {
+                acceptClient();
+            } else {
+                readClient(slots[i]);
+            }
+        }
+    }
+
+    for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+        closeClient(i);
+    }
+}
+
+void ControlServer::acceptClient() {
+    int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+        if (client_fds[i] < 0) {
+            client_fds[i] = fd;
+            client_line_lengths[i] = 0;
+            return;
+        }
+    }
+    const char reply[] = "error too many clients\n";
+    sendReply(fd, reply, sizeof(reply) - 1);
+    ::close(fd);
+}
+
+void ControlServer::closeClient(int slot) {
+    if (client_fds[slot] >= 0) {
+        ::close(client_fds[slot]);
+        client_fds[slot] = -1;
+    }
+    client_line_lengths[slot] = 0;
+}
+
+/*
+* Reads from one client and handles every complete line
+*/
+void ControlServer::readClient(int slot) {
+    char* line = client_lines[slot];
+    int& length = client_line_lengths[slot];
+
+    // Step 1: Read what is available (keep room for the terminator)
+    ssize_t bytes_read = read(client_fds[slot], line + length, CONTROL_LINE_SIZE - 1 - length);
+    if (bytes_read <= 0) {
+        closeClient(slot);
+        return;
+    }
+    length += (int)bytes_read;
+
+    // Step 2: Handle complete lines
+    int start = 0;
+    for (int i = 0; i < length; i++) {
+        if (line[i] == '\n') {
+            line[i] = '\0';
+            if (i > start && line[i - 1] == '\r') line[i - 1] = '\0';
+            if (!handleRequest(client_fds[slot], line + start)) {
+                closeClient(slot);
+                return;
+            }
+            start = i + 1;
+        }
+    }
+
+    // Step 3: Keep the incomplete rest, drop lines that do not fit
+    length -= start;
+    memmove(line, line + start, length);
+    if (length == CONTROL_LINE_SIZE - 1) {
+        const char reply[] = "error line too long\n";
+        length = 0;
+        if (!sendReply(client_fds[slot], reply, sizeof(reply) - 1)) {
+            closeClient(slot);
+        }
+    }
+}
+
+/*
+* Parses one request line, queues its commands as one batch and replies
+* @return: false if the reply could not be sent (client disconnected)
+*/
+bool ControlServer::handleRequest(int fd, char* line) {
+    ControlBatch batch;
+    batch.count = 0;
+    bool wants_state = false;
+    char reply[256];
+
+    // Step 1: Parse all commands first (nothing is applied if one is invalid)
+    int command_number = 0;
+    char* save = nullptr;
+    for (char* text = strtok_r(line, ";", &save); text != nullptr; text = strtok_r(nullptr, ";", &save)) {
+        command_number++;
+
+        // Skip empty commands ("a; ; b" or trailing ';')
+        char* first = text + strspn(text, " \t");
+        if (*first == '\0') continue;
+
+        if (strncmp(first, "state", 5) == 0 && first[5 + strspn(first + 5, " \t")] == '\0') {
+            wants_state = true;
+            continue;
+        }
+
+        if (batch.count == CONTROL_MAX_COMMANDS_PER_BATCH) {
+            snprintf(reply, sizeof(reply), "error %d: too many commands (max %d)\n", command_number, CONTROL_MAX_COMMANDS_PER_BATCH);
+            return sendReply(fd, reply, strlen(reply));
+        }
+
+        const char* error = nullptr;
+        if (!parseControlCommand(first, batch.commands[batch.count], error)) {
+            snprintf(reply, sizeof(reply), "error %d: %s\n", command_number, error);
+            return sendReply(fd, reply, strlen(reply));
+        }
+        batch.count++;
+    }
+
+    // Step 2: Hand batch to the main loop
+    if (batch.count > 0 && !batch_queue.push(batch)) {
+        const char busy[] = "error busy\n";
+        return sendReply(fd, busy, sizeof(busy) - 1);
+    }
+
+    // Step 3: Reply (state from the latest published snapshot, before this batch is applied)
+    ControllerState state;
+    uint32_t sequence = 0;
+    if (wants_state && readState(state_segment, state, &sequence)) {
+        snprintf(reply, sizeof(reply),
+                 "ok seq=%u time=%llu reports=%llu page=%d buttons=0x%07x toggled=0x%07x wheel=%d"
+                 " analog=%u,%u,%u,%u,%u,%u,%u,%u\n",
+                 sequence, (unsigned long long)state.timestamp_ms, (unsigned long long)state.report_count,
+                 state.current_page, state.button_mask, state.toggled_mask, state.wheel_position,
+                 state.analog_raw[0], state.analog_raw[1], state.analog_raw[2], state.analog_raw[3],
+                 state.analog_raw[4], state.analog_raw[5], state.analog_raw[6], state.analog_raw[7]);
+    } else if (wants_state) {
+        snprintf(reply, sizeof(reply), "error state unavailable\n");
+    } else {
+        snprintf(reply, sizeof(reply), "ok\n");
+    }
+    return sendReply(fd, reply, strlen(reply));
+}
+
+// =============================================================================
+// APPLYING (main loop)
+// =============================================================================
+
+/*
+* Applies one LED or display command of a batch
+* Call inside beginLEDFrame()/endLEDFrame(), so a whole batch results in one LED report
+* Page and zone commands need main loop state and are handled there
+*
+* @param command: Parsed command
+* @param display: Display controller for display commands
+* @return: false for page/zone commands (not handled here)
+*/
+bool applyControlCommand(const ControlCommand& command, DisplayController& display) {
+    switch (command.type) {
+        case ControlCommandType::MATRIX_LED:
+            return setMatrixButtonLED(command.pad, command.color, command.brightness);
+        case ControlCommandType::SPECIAL_LED:
+            return setSpecialButtonLED(SPECIAL_BUTTONS[command.button_index], command.brightness);
+        case ControlCommandType::CONTROL_LED:
+            return setControlButtonLED(CONTROL_BUTTONS[command.button_index], command.brightness);
+        case ControlCommandType::STOP_LED:
+            return setStopButtonLED(STOP_BUTTONS[command.button_index], command.brightness);
+        case ControlCommandType::DISPLAY_NUMBER:
+            display.setDisplayNumber(command.value);
+            return true;
+        case ControlCommandType::DISPLAY_TEXT:
+            display.setDisplayText(command.text);
+            return true;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,275 @@
+#include "headers/device_context.h"    // Include header file
+
+#include <iostream>                     // For std::cout and std::cerr
+#include <cstring>                      // For strcmp, strncpy
+#include <mutex>                        // For std::mutex (hidapi enumerate/open from device threads)
+#include "headers/startup_sequence.h"   // For startupSequence
+#include "headers/trace_recorder.h"     // For traceBegin, traceEnd, traceInstant
+#include "headers/metrics_registry.h"   // For bindDeviceMetrics, connection gauge
+
+// =============================================================================
+// DEVICE ENUMERATION
+// =============================================================================
+
+// hid_enumerate/hid_open_path are not guaranteed to be thread-safe, device threads take turns
+static std::mutex hid_open_mutex;
+
+/*
+* Copies a wide USB string descriptor into a narrow buffer
+* Serial numbers are plain ASCII, anything else becomes '?'
+*/
+static void copyWideString(const wchar_t* text, char* buffer, int buffer_size) {
+    int length = 0;
+    if (text != nullptr) {
+        for (; text[length] != L'\0' && length < buffer_size - 1; length++) {
+            buffer[length] = (text[length] > 0 && text[length] < 128) ? (char)text[length] : '?';
+        }
+    }
+    buffer[length] = '\0';
+}
+
+/*
+* Finds all connected F1s
+* Some platforms list one device several times (one entry per HID usage),
+* so entries with a path or serial number seen before are skipped.
+*
+* @param vendor_id: USB vendor id
+* @param product_id: USB product id
+* @param devices: Output array
+* @param max_devices: Size of the output array
+* @return: Number of devices found (sorted by serial number, so numbering is stable)
+*/
+int enumerateF1Devices(unsigned short vendor_id, unsigned short product_id, F1DeviceInfo* devices, int max_devices) {
+    // Step 1: Ask hidapi for all matching HID interfaces
+    hid_device_info* list = hid_enumerate(vendor_id, product_id);
+    int count = 0;
+
+    // Step 2: Collect one entry per device
+    for (hid_device_info* entry = list; entry != nullptr && count < max_devices; entry = entry->next) {
+        F1DeviceInfo info;
+        info.vendor_id = entry->vendor_id;
+        info.product_id = entry->product_id;
+        copyWideString(entry->serial_number, info.serial, sizeof(info.serial));
+        strncpy(info.path, entry->path, sizeof(info.path) - 1);
+        info.path[sizeof(info.path) - 1] = '\0';
+
+        bool duplicate = false;
+        for (int i = 0; i < count; i++) {
+            if (strcmp(devices[i].path, info.path) == 0 ||
+                (info.serial[0] != '\0' && strcmp(devices[i].serial, info.serial) == 0)) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) {
+            devices[count++] = info;
+        }
+    }
+    hid_free_enumeration(list);
+
+    // Step 3: Sort by serial number (insertion sort, a handful of entries)
+    for (int i = 1; i < count; i++) {
+        F1DeviceInfo info = devices[i];
+        int j = i - 1;
+        while (j >= 0 && strcmp(devices[j].serial, info.serial) > 0) {
+            devices[j + 1] = devices[j];
+            j--;
+        }
+        devices[j + 1] = info;
+    }
+
+    return count;
+}
+
+// =============================================================================
+// DEVICE CONTEXT
+// =============================================================================
+
+/*
+* Prepares the F1 for the main loop - call on the device's own thread
+*
+* @return: false if the LED controller could not be initialized
+*/
+bool DeviceContext::initialize() {
+    // Step 1: All LED functions and metrics on this thread now work on this F1
+    bindLEDController(&led_context);
+    bindDeviceMetrics(number);
+    setMetricGauge(MetricGauge::CONNECTED, 1);
+
+    // Step 2: Initialize the LED controller and run startup sequence
+    if (!initializeLEDController(device)) {
+        return false;
+    }
+    startupSequence(device);
+
+    // Step 3: Initialize toggle system and input readers
+    btn_toggle_system.initialize();
+    wheel_input_reader.initialize();
+    knob_input_reader.initialize();     // Movement detection for value overlay
+    fader_input_reader.initialize();
+
+    // Step 4: Set first effects page on display (left dot = page is loaded), load its scene and zones
+    display_controller.setDisplayNumber(current_effect_page);
+    display_controller.setDisplayDot(1, true);
+    scene_controller.setEffectsPageScene(current_effect_page);
+    scene_controller.setEffectsPageZones(btn_toggle_system, current_effect_page);
+    scene_controller.setEffectsPageBehaviors(btn_toggle_system, current_effect_page);
+
+    std::cout << "- F1 #" << number << " ready" << (info.serial[0] ? " (serial " : "")
+              << info.serial << (info.serial[0] ? ")" : "") << std::endl;
+    return true;
+}
+
+/*
+* Loads an effects page: scene, matrix toggle zones and behaviors
+* Used by the selector wheel press and the control socket
+*
+* @param page: Effects page (1-99)
+* @param now_ms: Current tick time (starts the page name marquee)
+*/
+void DeviceContext::loadEffectsPage(int page, uint64_t now_ms) {
+    uint64_t trace_start = traceBegin();
+    traceInstant(TraceName::PAGE_CHANGE, page);
+    current_effect_page = page;
+    // Show page number, turn on left dot to indicate page is loaded
+    display_controller.setDisplayNumber(current_effect_page);
+    display_controller.setDisplayDot(1, true);
+    // Load effects page scene and its matrix toggle zones
+    scene_controller.setEffectsPageScene(current_effect_page);
+    scene_controller.setEffectsPageZones(btn_toggle_system, current_effect_page);
+    scene_controller.setEffectsPageBehaviors(btn_toggle_system, current_effect_page);
+    // Reset button states
+    btn_toggle_system.resetAllToggleStates();
+    // Scroll page name once (if the page has one), then show the page number again
+    display_controller.startMarquee(scene_controller.getEffectsPageName(current_effect_page), now_ms);
+    traceEnd(TraceName::SCENE_LOAD, trace_start, page);
+}
+
+// =============================================================================
+// HOT-PLUG - Disconnect and reconnect without losing state
+// =============================================================================
+
+bool DeviceContext::isConnected() const {
+    return device != nullptr;
+}
+
+/*
+* Releases the device after reading from it failed (cable pulled, USB reset)
+* Everything else stays: page, toggles, scene, display and the LED buffer, so the
+* main loop keeps ticking (OSC feedback, control socket, ...) into the buffer
+*
+* @param now_ms: Current tick time
+*/
+void DeviceContext::handleDisconnect(uint64_t now_ms) {
+    if (device == nullptr) {
+        return;
+    }
+    hid_close(device);
+    device = nullptr;
+    setLEDControllerDevice(nullptr);
+    setMetricGauge(MetricGauge::CONNECTED, 0);
+
+    disconnected_since_ms = now_ms;
+    next_reconnect_ms = now_ms;
+    std::cout << std::endl << "- F1 #" << number << " disconnected, waiting for it to come back..." << std::endl;
+}
+
+/*
+* Checks whether an opened device reports the expected serial number
+*/
+static bool hasSerial(hid_device* device, const char* serial) {
+    wchar_t wide_serial[DEVICE_SERIAL_SIZE];
+    if (hid_get_serial_number_string(device, wide_serial, DEVICE_SERIAL_SIZE) != 0) {
+        return false;
+    }
+    char narrow_serial[DEVICE_SERIAL_SIZE];
+    copyWideString(wide_serial, narrow_serial, sizeof(narrow_serial));
+    return strcmp(narrow_serial, serial) == 0;
+}
+
+/*
+* Looks for the disconnected F1 (at most every DEVICE_RECONNECT_POLL_MS) and reopens it
+* The old path is tried first; if the F1 came back under a new path, it is found by serial number.
+* After reopening, the full current LED frame is sent as one report.
+*
+* @param now_ms: Current tick time
+* @return: true if the device is connected again
+*/
+bool DeviceContext::tryReconnect(uint64_t now_ms) {
+    // Step 1: Poll at a fixed interval
+    if (device != nullptr) {
+        return true;
+    }
+    if (now_ms < next_reconnect_ms) {
+        return false;
+    }
+    next_reconnect_ms = now_ms + DEVICE_RECONNECT_POLL_MS;
+
+    // Step 2: Find and open the device (device threads take turns)
+    hid_device* reopened = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(hid_open_mutex);
+
+        // Same path, but only if it is still our F1
+        reopened = hid_open_path(info.path);
+        if (reopened != nullptr && info.serial[0] != '\0' && !hasSerial(reopened, info.serial)) {
+            hid_close(reopened);
+            reopened = nullptr;
+        }
+
+        // New path, same serial number
+        if (reopened == nullptr && info.serial[0] != '\0') {
+            F1DeviceInfo found[MAX_F1_DEVICES];
+            int found_count = enumerateF1Devices(info.vendor_id, info.product_id, found, MAX_F1_DEVICES);
+            for (int i = 0; i < found_count && reopened == nullptr; i++) {
+                if (strcmp(found[i].serial, info.serial) == 0) {
+                    reopened = hid_open_path(found[i].path);
+                    if (reopened != nullptr) {
+                        info = found[i];
+                    }
+                }
+            }
+        }
+    }
+    if (reopened == nullptr) {
+        return false;
+    }
+
+    // Step 3: Fresh input baselines (no page jump from the wheel counter, no overlay flash,
+    // buttons held during the disconnect are released inside a frame, so they only change the buffer)
+    device = reopened;
+    setLEDControllerDevice(device);
+    beginLEDFrame();
+    wheel_input_reader.initialize();
+    knob_input_reader.initialize();
+    fader_input_reader.initialize();
+    btn_toggle_system.releaseAllButtons(now_ms);
+    osc_sender.resendAll();
+
+    // Step 4: Show the current frame again, in one report (the replay sends the open frame,
+    // so closing it has nothing left to send)
+    replayLEDFrame();
+    endLEDFrame();
+    reconnect_count++;
+    countMetric(MetricCounter::RECONNECTS);
+    setMetricGauge(MetricGauge::CONNECTED, 1);
+    std::cout << "- F1 #" << number << " reconnected after " << (now_ms - disconnected_since_ms) << " ms" << std::endl;
+    return true;
+}
+
+/*
+* Closes the control socket, OSC/MIDI/DMX output, shared memory and the device
+*/
+void DeviceContext::close() {
+    control_server.stop();
+    osc_sender.close();
+    osc_listener.close();
+    dmx_output.close();
+    state_publisher.close();
+    led_frame_receiver.close();
+    midi_output.close();
+    if (device != nullptr) {
+        hid_close(device);
+        device = nullptr;
+    }
+}
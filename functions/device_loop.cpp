@@ -0,0 +1,284 @@
+#include "headers/device_loop.h"        // Include header file
+
+#include <iostream>                     // For std::cout and std::cerr
+#include <iomanip>                      // For std::setprecision (knob/fader debug line)
+#include <cstdio>                       // For snprintf
+#include <algorithm>                    // For std::min, std::max
+#include <chrono>                       // For std::chrono::milliseconds
+#include <thread>                       // For std::this_thread::sleep_for
+#include "headers/input_reader.h"       // For readInputReportTimeout, isSpecialButtonPressed
+#include "headers/tick_clock.h"         // For getTickTimeMs, MAIN_LOOP_TICK_MS
+#include "headers/latency_tracer.h"     // For LATENCY_* (-DTRAKTOR_LATENCY_TRACING)
+#include "headers/trace_recorder.h"     // For traceBegin, traceEnd, registerTraceThread
+#include "headers/allocation_counter.h" // For getThreadAllocationCount (-DTRAKTOR_COUNT_ALLOCATIONS)
+
+// =============================================================================
+// DEVICE LOOP - One thread per F1
+// =============================================================================
+
+/*
+* One tick of the device loop: timers, feedback and control batches, then the
+* input report (if any), with all LED changes sent as at most one LED report
+* The clock is a parameter, so replays can run the same code on scripted time.
+*
+* @param context: The device's context (LED functions bound to the calling thread)
+* @param input_report_buffer: Report read this tick, nullptr if none
+* @param now_ms: Current tick time
+*/
+void runDeviceTick(DeviceContext& context, const unsigned char* input_report_buffer, uint64_t now_ms) {
+    // =======================================
+    // Collect all LED changes of this tick into one LED report
+    // =======================================
+    beginLEDFrame();
+
+    // =======================================
+    // Tick timed behaviors and display animations (every loop, also without input)
+    // =======================================
+    context.btn_toggle_system.updateTimedBehaviors(now_ms);
+    context.display_controller.tick(now_ms);
+    context.midi_output.tick(now_ms);
+
+    // =======================================
+    // Apply LED/display feedback from the visual software (inside this tick's LED frame)
+    // =======================================
+    context.osc_listener.poll(context.display_controller);
+
+    // =======================================
+    // Apply newest LED frame from an external renderer (same LED frame, one report)
+    // =======================================
+    context.led_frame_receiver.poll(context.display_controller);
+
+    // =======================================
+    // Apply queued control socket batches (each batch completely, same LED frame)
+    // =======================================
+    while (context.control_server.popBatch(context.control_batch)) {
+        for (int i = 0; i < context.control_batch.count; i++) {
+            const ControlCommand& command = context.control_batch.commands[i];
+            if (command.type == ControlCommandType::LOAD_PAGE) {
+                context.loadEffectsPage(command.value, now_ms);
+                // Page and reset toggles are visible to state queries right away
+                context.published_state.timestamp_ms = now_ms;
+                context.published_state.toggled_mask = context.btn_toggle_system.toggled_mask;
+                context.published_state.current_page = context.current_effect_page;
+                context.state_publisher.publish(context.published_state);
+            } else if (command.type == ControlCommandType::ZONE_MODE) {
+                context.btn_toggle_system.setMatrixToggleMode(command.zone_mode);
+            } else {
+                applyControlCommand(command, context.display_controller);
+            }
+        }
+    }
+
+    // Latency histograms requested (kill -USR1)
+    LATENCY_POLL_DUMP();
+
+    // No new input report this tick
+    if (input_report_buffer == nullptr) {
+        context.dmx_output.tick(context.btn_toggle_system.toggled_mask, now_ms);
+        endLEDFrame();
+        return;
+    }
+
+    uint64_t trace_decode = traceBegin();
+
+    // =======================================
+    // Read and update Selector Wheel rotation
+    // =======================================
+    // Get wheel direction
+    WheelDirection selector_wheel_direction = context.wheel_input_reader.checkWheelRotation(input_report_buffer);
+
+    // Select effects page accordingly
+    if (selector_wheel_direction == WheelDirection::CLOCKWISE) {
+        // increase page by 1
+        context.current_effect_page = std::min(context.current_effect_page + 1, 99);
+        // Update display
+        context.display_controller.stopMarquee();           // Stop page name scrolling
+        context.display_controller.setDisplayDot(1, false); // Turn off left dot when changing page
+        context.display_controller.setDisplayNumber(context.current_effect_page);
+    }
+    else if (selector_wheel_direction == WheelDirection::COUNTER_CLOCKWISE) {
+        // decrease page by 1
+        context.current_effect_page = std::max(context.current_effect_page - 1, 1);
+        // Update display
+        context.display_controller.stopMarquee();           // Stop page name scrolling
+        context.display_controller.setDisplayDot(1, false); // Turn off left dot when changing page
+        context.display_controller.setDisplayNumber(context.current_effect_page);
+    }
+
+    // Load effects page on selector wheel button press
+    if (isSpecialButtonPressed(input_report_buffer, SpecialButton::SELECTOR_WHEEL)) {
+        context.loadEffectsPage(context.current_effect_page, now_ms);
+    }
+
+    // =======================================
+    // Read and update Knob values
+    // =======================================
+    //context.knob_input_reader.printKnobValues(input_report_buffer);
+    float knob_value_1 = context.knob_input_reader.getKnobValue(input_report_buffer, 1);
+    float knob_value_2 = context.knob_input_reader.getKnobValue(input_report_buffer, 2);
+    float knob_value_3 = context.knob_input_reader.getKnobValue(input_report_buffer, 3);
+    float knob_value_4 = context.knob_input_reader.getKnobValue(input_report_buffer, 4);
+
+    // =======================================
+    // Read and update Fader values
+    // =======================================
+    //context.fader_input_reader.printFaderValues(input_report_buffer);
+    float fader_value_1 = context.fader_input_reader.getFaderValue(input_report_buffer, 1);
+    float fader_value_2 = context.fader_input_reader.getFaderValue(input_report_buffer, 2);
+    float fader_value_3 = context.fader_input_reader.getFaderValue(input_report_buffer, 3);
+    float fader_value_4 = context.fader_input_reader.getFaderValue(input_report_buffer, 4);
+
+    // Print knob and fader values for debugging (first F1 of the program only, the line is overwritten in place)
+    if (context.print_analog_values) {
+        std::cout << "Knob Values: "
+                  << "1: " << std::fixed << std::setprecision(3) << knob_value_1 << " | "
+                  << "2: " << std::fixed << std::setprecision(3) << knob_value_2 << " | "
+                  << "3: " << std::fixed << std::setprecision(3) << knob_value_3 << " | "
+                  << "4: " << std::fixed << std::setprecision(3) << knob_value_4 << " || "
+                  << "Fader Values: "
+                  << "1: " << std::fixed << std::setprecision(3) << fader_value_1 << " | "
+                  << "2: " << std::fixed << std::setprecision(3) << fader_value_2 << " | "
+                  << "3: " << std::fixed << std::setprecision(3) << fader_value_3 << " | "
+                  << "4: " << std::fixed << std::setprecision(3) << fader_value_4 << " || "
+                  << "        \r"; // Carriage return to overwrite the line
+        std::cout.flush();
+    }
+
+    // =======================================
+    // Show moved knob/fader value on the display (00-99) for a moment
+    // =======================================
+    for (int i = 1; i <= KNOB_COUNT; i++) {
+        if (context.knob_input_reader.hasKnobMoved(input_report_buffer, i)) {
+            int value = (int)(context.knob_input_reader.getKnobValue(input_report_buffer, i) * 99.0f + 0.5f);
+            context.display_controller.showValueOverlay(OVERLAY_SOURCE_KNOB_BASE + i, value, now_ms);
+        }
+    }
+    for (int i = 1; i <= FADER_COUNT; i++) {
+        if (context.fader_input_reader.hasFaderMoved(input_report_buffer, i)) {
+            int value = (int)(context.fader_input_reader.getFaderValue(input_report_buffer, i) * 99.0f + 0.5f);
+            context.display_controller.showValueOverlay(OVERLAY_SOURCE_FADER_BASE + i, value, now_ms);
+        }
+    }
+
+    traceEnd(TraceName::DECODE, trace_decode);
+    LATENCY_MARK(DECODE);
+
+    // =======================================
+    // Check for button toggles
+    // =======================================
+
+    // All special, control, stop and matrix buttons in one pass
+    // Each press/release is handled by the button's behavior (latch, radio, momentary, cycle, one-shot)
+    // Also updates button states for next frame
+    uint64_t trace_toggles = traceBegin();
+    context.btn_toggle_system.processInputReport(input_report_buffer, now_ms);
+    traceEnd(TraceName::TOGGLE_HANDLING, trace_toggles);
+    LATENCY_MARK(DISPATCH);
+
+    // =======================================
+    // Send all knob/fader/button changes of this report as one OSC bundle
+    // =======================================
+    context.osc_sender.sendInputChanges(input_report_buffer);
+
+    // =======================================
+    // Send button changes and queue knob/fader changes as MIDI (rate limited)
+    // =======================================
+    context.midi_output.processInputReport(input_report_buffer, now_ms);
+
+    // =======================================
+    // Store knob/fader/toggle states in the DMX universes, send them at the refresh rate
+    // =======================================
+    context.dmx_output.processInputReport(input_report_buffer);
+    context.dmx_output.tick(context.btn_toggle_system.toggled_mask, now_ms);
+
+    // =======================================
+    // Publish state snapshot in shared memory (seqlock, never blocks)
+    // =======================================
+    if (context.state_publisher.isOpen()) {
+        ControllerState& state = context.published_state;
+        state.timestamp_ms = now_ms;
+        state.report_count++;
+        state.button_mask = ButtonToggleSystem::getPressedButtonMask(input_report_buffer);
+        state.toggled_mask = context.btn_toggle_system.toggled_mask;
+        for (int i = 0; i < KNOB_COUNT; i++) {
+            state.analog_raw[i] = context.knob_input_reader.getRawKnobValue(input_report_buffer, i + 1);
+        }
+        for (int i = 0; i < FADER_COUNT; i++) {
+            state.analog_raw[KNOB_COUNT + i] = context.fader_input_reader.getRawFaderValue(input_report_buffer, i + 1);
+        }
+        state.wheel_position = input_report_buffer[WHEEL_BYTE_POSITION];
+        state.current_page = context.current_effect_page;
+        context.state_publisher.publish(state);
+    }
+
+    // =======================================
+    // Send all LED changes of this tick (at most one report)
+    // =======================================
+    LATENCY_MARK(LED_FRAME);
+    endLEDFrame();
+    LATENCY_END_REPORT();
+}
+
+/*
+* Services one F1 until asked to stop
+* Runs on the device's own thread, so several F1s never wait for each other.
+* If the F1 is unplugged, the loop keeps ticking and reopens it when it is back.
+*
+* @param context: The device's context (integrations are only open on the first F1)
+* @param realtime: Real-time mode (--rt), applied to this thread before anything else
+*/
+void serviceDevice(DeviceContext& context, const RealtimeConfig& realtime) {
+    char thread_name[16];
+    snprintf(thread_name, sizeof(thread_name), "f1-device-%d", context.number);
+
+    // Step 1: Pin, SCHED_FIFO and prefaulted stack (falls back to normal scheduling without privileges)
+    if (realtime.enabled) {
+        applyRealtimeToThread(realtime, context.number - 1, thread_name);
+    }
+
+    // Step 2: Trace ring for this thread (--trace)
+    registerTraceThread(thread_name);
+
+    // Step 3: Bind this thread's LED functions to the device, startup sequence, first page
+    if (!context.initialize()) {
+        std::cerr << "Error, F1 #" << context.number << " could not be initialized" << std::endl;
+        return;
+    }
+    context.running.store(true);
+    uint64_t startup_allocations = getThreadAllocationCount();
+
+    // Step 4: One tick per input report (or per MAIN_LOOP_TICK_MS without input)
+    while (!context.stop_requested.load(std::memory_order_relaxed)) {
+
+        // =======================================
+        // Read input report (wait at most one tick)
+        // =======================================
+        unsigned char input_report_buffer[INPUT_REPORT_SIZE];
+        int read_result = 0;
+        if (context.isConnected()) {
+            uint64_t trace_read = traceBegin();
+            read_result = readInputReportTimeout(context.device, input_report_buffer, MAIN_LOOP_TICK_MS);
+            traceEnd(TraceName::HID_READ, trace_read);
+            if (read_result > 0) {
+                LATENCY_BEGIN_REPORT();     // Latency tracing: report read
+            }
+            if (read_result < 0) {
+                // Cable pulled or USB reset: keep all state, look for the F1 again
+                context.handleDisconnect(getTickTimeMs());
+                read_result = 0;
+            }
+        } else if (!context.tryReconnect(getTickTimeMs())) {
+            // Still gone: keep ticking without input (LED changes stay in the buffer)
+            std::this_thread::sleep_for(std::chrono::milliseconds(MAIN_LOOP_TICK_MS));
+        }
+
+        runDeviceTick(context, read_result > 0 ? input_report_buffer : nullptr, getTickTimeMs());
+    }
+
+    // Step 5: Heap use of the loop itself (0 expected, reconnects open the device again and may allocate)
+    if (isAllocationCountingEnabled()) {
+        std::cout << "- F1 #" << context.number << ": " << (getThreadAllocationCount() - startup_allocations)
+                  << " allocations in the device loop" << std::endl;
+    }
+    context.running.store(false);
+}
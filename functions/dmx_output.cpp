@@ -0,0 +1,412 @@
+#include "headers/dmx_output.h"     // Include header file
+
+#include <iostream>                 // For std::cout and std::cerr
+#include <cstring>                  // For memcpy, memset, strcmp
+#include <cerrno>                   // For errno
+#include <random>                   // For std::random_device (sACN source id)
+#include <unistd.h>                 // For ::close
+#include <netdb.h>                  // For getaddrinfo
+#include <sys/socket.h>             // For socket, sendto, setsockopt
+#include <arpa/inet.h>              // For htons, htonl
+
+// =============================================================================
+// CONSTANTS - Packet layout
+// =============================================================================
+
+// Art-Net ArtDmx
+static const unsigned char ARTNET_ID[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+static const uint16_t ARTNET_OPCODE_DMX = 0x5000;
+static const uint8_t ARTNET_PROTOCOL_VERSION = 14;
+static const int ARTNET_SEQUENCE_OFFSET = 12;
+static const int ARTNET_MAX_UNIVERSE = 32767;       // 15-bit port address
+
+// sACN (E1.31) root, framing and DMP layer
+static const unsigned char SACN_ACN_ID[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+static const int SACN_FRAMING_OFFSET = 38;
+static const int SACN_DMP_OFFSET = 115;
+static const int SACN_SEQUENCE_OFFSET = 111;
+static const uint8_t SACN_DEFAULT_PRIORITY = 100;
+static const int SACN_MIN_UNIVERSE = 1;
+static const int SACN_MAX_UNIVERSE = 63999;
+
+// Matrix toggle bits 0-15 and stop toggle bits 24-27 (see led_controller_toggle.h)
+static const int MATRIX_TOGGLE_FIRST_BIT = 0;
+static const int STOP_TOGGLE_FIRST_BIT = 24;
+
+// =============================================================================
+// MAPPING
+// =============================================================================
+
+DmxMappingConfig getDefaultDmxMapping() {
+    DmxMappingConfig config = {};
+    for (int i = 0; i < FADER_COUNT; i++) {
+        config.mappings[config.mapping_count++] = {DmxSource::FADER, (uint8_t)(i + 1), 0, (uint16_t)(1 + i), false};
+    }
+    for (int i = 0; i < KNOB_COUNT; i++) {
+        config.mappings[config.mapping_count++] = {DmxSource::KNOB, (uint8_t)(i + 1), 0, (uint16_t)(5 + i), false};
+    }
+    for (int i = 0; i < 16; i++) {
+        config.mappings[config.mapping_count++] = {DmxSource::TOGGLE, (uint8_t)(MATRIX_TOGGLE_FIRST_BIT + i), 0, (uint16_t)(9 + i), false};
+    }
+    for (int i = 0; i < 4; i++) {
+        config.mappings[config.mapping_count++] = {DmxSource::TOGGLE, (uint8_t)(STOP_TOGGLE_FIRST_BIT + i), 0, (uint16_t)(25 + i), false};
+    }
+    return config;
+}
+
+/*
+* Checks one mapping entry
+*
+* @return: nullptr if valid, otherwise the reason
+*/
+static const char* checkMapping(const DmxChannelMapping& entry) {
+    if (entry.universe_index >= DMX_MAX_UNIVERSES) return "universe index too large";
+    if (entry.channel < 1 || entry.channel > DMX_UNIVERSE_SIZE - (entry.fine ? 1 : 0)) return "channel out of range";
+    switch (entry.source) {
+        case DmxSource::KNOB:
+            return (entry.source_index >= 1 && entry.source_index <= KNOB_COUNT) ? nullptr : "knob must be 1-4";
+        case DmxSource::FADER:
+            return (entry.source_index >= 1 && entry.source_index <= FADER_COUNT) ? nullptr : "fader must be 1-4";
+        case DmxSource::TOGGLE:
+            if (entry.fine) return "toggles have no fine channel";
+            return (entry.source_index < TOGGLE_BIT_COUNT) ? nullptr : "toggle bit must be 0-27";
+    }
+    return "unknown source";
+}
+
+/*
+* Checks and stores a new mapping
+* If the output is open, the mapping is compiled right away and all channels restart at 0
+*
+* @param new_mapping: Mapping to use
+* @return: false if an entry is invalid (old mapping stays)
+*/
+bool DmxOutput::setMapping(const DmxMappingConfig& new_mapping) {
+    if (new_mapping.mapping_count < 0 || new_mapping.mapping_count > DMX_MAX_MAPPINGS) {
+        std::cerr << "DmxOutput Error: Invalid mapping count" << std::endl;
+        return false;
+    }
+    for (int i = 0; i < new_mapping.mapping_count; i++) {
+        const char* error = checkMapping(new_mapping.mappings[i]);
+        if (error != nullptr) {
+            std::cerr << "DmxOutput Error: Mapping " << i << ": " << error << std::endl;
+            return false;
+        }
+    }
+
+    mapping = new_mapping;
+    if (socket_fd >= 0) {
+        compileMapping();
+    }
+    return true;
+}
+
+/*
+* Turns the mapping into flat target tables with offsets into the packet buffers
+* Clears all channel data and marks every used universe for sending
+*
+* @return: true (mapping was checked by setMapping)
+*/
+bool DmxOutput::compileMapping() {
+    // Step 1: Clear channel data
+    for (int u = 0; u < DMX_MAX_UNIVERSES; u++) {
+        memset(packets[u] + data_offset, 0, DMX_UNIVERSE_SIZE);
+    }
+
+    // Step 2: Build target tables
+    analog_target_count = 0;
+    toggle_target_count = 0;
+    universe_count = 0;
+    for (int i = 0; i < mapping.mapping_count; i++) {
+        const DmxChannelMapping& entry = mapping.mappings[i];
+        uint16_t offset = (uint16_t)(data_offset + entry.channel - 1);
+
+        if (entry.source == DmxSource::TOGGLE) {
+            toggle_targets[toggle_target_count++] = {entry.source_index, entry.universe_index, offset};
+        } else {
+            uint8_t analog_index = (uint8_t)(entry.source_index - 1 + (entry.source == DmxSource::FADER ? KNOB_COUNT : 0));
+            uint16_t fine_offset = entry.fine ? (uint16_t)(offset + 1) : 0;
+            analog_targets[analog_target_count++] = {analog_index, entry.universe_index, offset, fine_offset};
+        }
+
+        if (entry.universe_index + 1 > universe_count) {
+            universe_count = entry.universe_index + 1;
+        }
+    }
+
+    // Step 3: Send all used universes with the next refresh (toggles are re-applied)
+    last_toggle_mask = 0;
+    dirty_universes = (1u << universe_count) - 1;
+    return true;
+}
+
+// =============================================================================
+// DMX OUTPUT - Setup
+// =============================================================================
+
+/*
+* Writes the protocol header of every universe packet
+* Only the sequence byte and the channel data change afterwards
+*
+* @param first_universe: Universe number of universe index 0
+*/
+void DmxOutput::buildPackets(int first_universe) {
+    memset(packets, 0, sizeof(packets));
+
+    // sACN identifies a source by a random 16-byte id (CID), kept for this run
+    unsigned char cid[16];
+    std::random_device random;
+    for (int i = 0; i < 16; i += 4) {
+        uint32_t bits = random();
+        memcpy(cid + i, &bits, 4);
+    }
+
+    for (int u = 0; u < DMX_MAX_UNIVERSES; u++) {
+        unsigned char* packet = packets[u];
+        int universe = first_universe + u;
+
+        if (protocol == DmxProtocol::ARTNET) {
+            memcpy(packet, ARTNET_ID, 8);
+            packet[8] = ARTNET_OPCODE_DMX & 0xFF;           // Opcode is little endian
+            packet[9] = ARTNET_OPCODE_DMX >> 8;
+            packet[11] = ARTNET_PROTOCOL_VERSION;
+            packet[14] = universe & 0xFF;                   // SubUni
+            packet[15] = (universe >> 8) & 0x7F;            // Net
+            packet[16] = DMX_UNIVERSE_SIZE >> 8;            // Length is big endian
+            packet[17] = DMX_UNIVERSE_SIZE & 0xFF;
+            continue;
+        }
+
+        // sACN root layer
+        packet[1] = 0x10;                                   // Preamble size
+        memcpy(packet + 4, SACN_ACN_ID, 12);
+        packet[16] = 0x70 | ((packet_size - 16) >> 8);      // Flags and length
+        packet[17] = (packet_size - 16) & 0xFF;
+        packet[21] = 0x04;                                  // VECTOR_ROOT_E131_DATA
+        memcpy(packet + 22, cid, 16);
+
+        // Framing layer
+        packet[SACN_FRAMING_OFFSET] = 0x70 | ((packet_size - SACN_FRAMING_OFFSET) >> 8);
+        packet[SACN_FRAMING_OFFSET + 1] = (packet_size - SACN_FRAMING_OFFSET) & 0xFF;
+        packet[SACN_FRAMING_OFFSET + 5] = 0x02;             // VECTOR_E131_DATA_PACKET
+        memcpy(packet + 44, DMX_SOURCE_NAME, sizeof(DMX_SOURCE_NAME));
+        packet[108] = SACN_DEFAULT_PRIORITY;
+        packet[113] = universe >> 8;
+        packet[114] = universe & 0xFF;
+
+        // DMP layer
+        packet[SACN_DMP_OFFSET] = 0x70 | ((packet_size - SACN_DMP_OFFSET) >> 8);
+        packet[SACN_DMP_OFFSET + 1] = (packet_size - SACN_DMP_OFFSET) & 0xFF;
+        packet[117] = 0x02;                                 // VECTOR_DMP_SET_PROPERTY
+        packet[118] = 0xA1;                                 // Address and data type
+        packet[122] = 0x01;                                 // Address increment
+        packet[123] = (DMX_UNIVERSE_SIZE + 1) >> 8;         // Property count incl. start code
+        packet[124] = (DMX_UNIVERSE_SIZE + 1) & 0xFF;
+    }
+}
+
+/*
+* Opens a UDP socket, resolves the targets and builds the packets
+* Sending never blocks: if the socket buffer is full the packet is dropped
+*
+* @param protocol: Art-Net or sACN
+* @param host: Target host or broadcast address; "multicast" sends sACN to each universe's multicast group
+* @param port: UDP port (ARTNET_DEFAULT_PORT or SACN_DEFAULT_PORT)
+* @param first_universe: Universe number of universe index 0 (Art-Net 0-32767, sACN 1-63999)
+* @param refresh_hz: Packets per second for changed universes (1-44)
+* @return: true if the output is ready
+*/
+bool DmxOutput::initialize(DmxProtocol new_protocol, const char* host, int port, int first_universe, int refresh_hz) {
+    // Step 1: Close previous socket and check arguments
+    close();
+    protocol = new_protocol;
+    bool multicast = protocol == DmxProtocol::SACN && strcmp(host, SACN_MULTICAST_HOST) == 0;
+    int min_universe = protocol == DmxProtocol::SACN ? SACN_MIN_UNIVERSE : 0;
+    int max_universe = protocol == DmxProtocol::SACN ? SACN_MAX_UNIVERSE : ARTNET_MAX_UNIVERSE;
+    if (first_universe < min_universe || first_universe + DMX_MAX_UNIVERSES - 1 > max_universe) {
+        std::cerr << "DmxOutput Error: Universe must be " << min_universe << "-" << max_universe - DMX_MAX_UNIVERSES + 1 << std::endl;
+        return false;
+    }
+    if (refresh_hz < 1 || refresh_hz > 44) {
+        std::cerr << "DmxOutput Error: Refresh rate must be 1-44 Hz" << std::endl;
+        return false;
+    }
+
+    // Step 2: Resolve target (IPv4, Art-Net and sACN are IPv4 protocols)
+    sockaddr_in target = {};
+    if (!multicast) {
+        addrinfo hints = {};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* result = nullptr;
+        int error = getaddrinfo(host, nullptr, &hints, &result);
+        if (error != 0) {
+            std::cerr << "DmxOutput Error: Cannot resolve " << host << ": " << gai_strerror(error) << std::endl;
+            return false;
+        }
+        memcpy(&target, result->ai_addr, sizeof(target));
+        freeaddrinfo(result);
+    }
+    target.sin_family = AF_INET;
+    target.sin_port = htons((uint16_t)port);
+
+    for (int u = 0; u < DMX_MAX_UNIVERSES; u++) {
+        destinations[u] = target;
+        if (multicast) {
+            int universe = first_universe + u;
+            destinations[u].sin_addr.s_addr = htonl((239u << 24) | (255u << 16) | (uint32_t)universe);
+        }
+    }
+
+    // Step 3: Open socket (broadcast allowed for Art-Net x.255.255.255 targets)
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        std::cerr << "DmxOutput Error: Cannot open UDP socket" << std::endl;
+        return false;
+    }
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable));
+
+    // Step 4: Build packets and compile mapping
+    if (protocol == DmxProtocol::ARTNET) {
+        data_offset = ARTNET_HEADER_SIZE;
+        sequence_offset = ARTNET_SEQUENCE_OFFSET;
+    } else {
+        data_offset = SACN_HEADER_SIZE;
+        sequence_offset = SACN_SEQUENCE_OFFSET;
+    }
+    packet_size = data_offset + DMX_UNIVERSE_SIZE;
+    buildPackets(first_universe);
+
+    socket_fd = fd;
+    compileMapping();
+    refresh_interval_ms = 1000 / refresh_hz;
+    next_refresh_ms = 0;
+    for (int u = 0; u < DMX_MAX_UNIVERSES; u++) {
+        sequence[u] = 0;
+        last_sent_ms[u] = 0;
+    }
+
+    std::cout << "- DMX output (" << (protocol == DmxProtocol::ARTNET ? "Art-Net" : "sACN") << ") to "
+              << host << ":" << port << ", universe " << first_universe << std::endl;
+    return true;
+}
+
+void DmxOutput::close() {
+    if (socket_fd >= 0) {
+        ::close(socket_fd);
+        socket_fd = -1;
+    }
+}
+
+bool DmxOutput::isOpen() const {
+    return socket_fd >= 0;
+}
+
+uint32_t DmxOutput::getSentCount() const {
+    return sent_count;
+}
+
+// =============================================================================
+// DMX OUTPUT - Updating channels
+// =============================================================================
+
+/*
+* Stores the knob/fader values of one input report in the packets
+* 12-bit values are stretched to 16 bit: coarse channel = high byte, fine = low byte
+*
+* @param input_report: The 22-byte input report from readInputReport()
+*/
+void DmxOutput::processInputReport(const unsigned char* input_report) {
+    if (socket_fd < 0 || input_report == nullptr) {
+        return;
+    }
+
+    // Step 1: Read raw values once
+    uint16_t values[DMX_ANALOG_COUNT];
+    for (int i = 0; i < KNOB_COUNT; i++) {
+        uint16_t raw = knob_reader.getRawKnobValue(input_report, i + 1);
+        values[i] = (uint16_t)((raw << 4) | (raw >> 8));
+    }
+    for (int i = 0; i < FADER_COUNT; i++) {
+        uint16_t raw = fader_reader.getRawFaderValue(input_report, i + 1);
+        values[KNOB_COUNT + i] = (uint16_t)((raw << 4) | (raw >> 8));
+    }
+
+    // Step 2: Store in the mapped channels, mark universes that changed
+    for (int i = 0; i < analog_target_count; i++) {
+        const DmxAnalogTarget& target = analog_targets[i];
+        unsigned char* packet = packets[target.universe_index];
+        uint8_t coarse = (uint8_t)(values[target.analog_index] >> 8);
+        uint8_t fine = (uint8_t)(values[target.analog_index] & 0xFF);
+
+        bool changed = packet[target.coarse_offset] != coarse;
+        packet[target.coarse_offset] = coarse;
+        if (target.fine_offset != 0) {
+            changed |= packet[target.fine_offset] != fine;
+            packet[target.fine_offset] = fine;
+        }
+        if (changed) {
+            dirty_universes |= 1u << target.universe_index;
+        }
+    }
+}
+
+/*
+* Stores toggle states and sends universes at the refresh rate
+* Changed universes are sent with the next refresh, unchanged ones every DMX_KEEPALIVE_MS
+*
+* @param toggled_mask: Toggle states (ButtonToggleSystem::toggled_mask)
+* @param now_ms: Current tick time
+*/
+void DmxOutput::tick(uint32_t toggled_mask, uint64_t now_ms) {
+    if (socket_fd < 0) {
+        return;
+    }
+
+    // Step 1: Toggles (only touched when a toggle changed)
+    uint32_t changed_bits = toggled_mask ^ last_toggle_mask;
+    if (changed_bits != 0) {
+        for (int i = 0; i < toggle_target_count; i++) {
+            const DmxToggleTarget& target = toggle_targets[i];
+            if ((changed_bits >> target.bit) & 1) {
+                packets[target.universe_index][target.offset] = ((toggled_mask >> target.bit) & 1) ? 255 : 0;
+                dirty_universes |= 1u << target.universe_index;
+            }
+        }
+        last_toggle_mask = toggled_mask;
+    }
+
+    // Step 2: Wait for the next refresh
+    if (now_ms < next_refresh_ms) {
+        return;
+    }
+    next_refresh_ms = now_ms + refresh_interval_ms;
+
+    // Step 3: Send changed universes and due keep-alives
+    for (int u = 0; u < universe_count; u++) {
+        if (((dirty_universes >> u) & 1) || now_ms - last_sent_ms[u] >= (uint64_t)DMX_KEEPALIVE_MS) {
+            sendUniverse(u, now_ms);
+        }
+    }
+    dirty_universes = 0;
+}
+
+void DmxOutput::sendUniverse(int universe_index, uint64_t now_ms) {
+    // Art-Net sequence 0 means "no sequence", so it runs 1-255
+    uint8_t next_sequence = (uint8_t)(sequence[universe_index] + 1);
+    if (protocol == DmxProtocol::ARTNET && next_sequence == 0) {
+        next_sequence = 1;
+    }
+    sequence[universe_index] = next_sequence;
+    packets[universe_index][sequence_offset] = next_sequence;
+
+    ssize_t sent = sendto(socket_fd, packets[universe_index], packet_size, MSG_DONTWAIT,
+                          (const sockaddr*)&destinations[universe_index], sizeof(sockaddr_in));
+    if (sent >= 0) {
+        sent_count++;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNREFUSED) {
+        std::cerr << "DmxOutput Error: send failed (errno " << errno << ")" << std::endl;
+    }
+    last_sent_ms[universe_index] = now_ms;
+}
@@ -2,8 +2,44 @@
 
 #include <iostream>             // For std::cout and std::cerr
 #include <iomanip>              // For std::hex (hexadecimal printing)
+#include <atomic>               // For std::atomic (invalid report counter, all device threads)
+#include "headers/metrics_registry.h"   // For read counters
+#include "headers/control_layout.h"     // For the generated input tables (byte and bit per button)
 // #include <hidapi/hidapi.h>   // included already in header
 
+// =============================================================================
+// REPORT VALIDATION
+// =============================================================================
+
+const uint64_t INVALID_REPORT_LOG_INTERVAL = 1000;     // Log the first bad report, then every n-th
+
+/*
+* Checks that a read returned a whole F1 input report
+* Shorter reads would leave stale bytes in the buffer for the decoders.
+*
+* @param buffer: Bytes returned by hid_read
+* @param length: Number of bytes hid_read returned
+* @return: true if the decoders may use the buffer
+*/
+bool isValidInputReport(const unsigned char* buffer, int length) {
+    return buffer != nullptr && length >= INPUT_REPORT_SIZE && buffer[0] == INPUT_REPORT_ID;
+}
+
+/*
+* Counts a bad report and logs it, rate limited so a misbehaving device cannot flood the log
+*/
+static void logInvalidInputReport(const unsigned char* buffer, int length) {
+    static std::atomic<uint64_t> invalid_report_count{0};
+    countMetric(MetricCounter::INVALID_REPORTS);
+    uint64_t count = invalid_report_count.fetch_add(1, std::memory_order_relaxed);
+    if (count % INVALID_REPORT_LOG_INTERVAL != 0) {
+        return;
+    }
+    std::cerr << "Input Report Error: Ignoring invalid report (" << length << " bytes, ID 0x" << std::hex
+              << (length > 0 ? (int)buffer[0] : 0) << std::dec << ", expected " << INPUT_REPORT_SIZE
+              << " bytes with ID 0x0" << (int)INPUT_REPORT_ID << "), " << (count + 1) << " so far" << std::endl;
+}
+
 // =============================================================================
 // MAIN INPUT READING FUNCTION
 // =============================================================================
@@ -44,19 +80,59 @@ bool readInputReport(hid_device *device, unsigned char *buffer) {
         return false;
     }
     
-    // Step 6: Verify this is the correct type of report
-    // The F1 always starts input reports with 0x01
-    if (buffer[0] != INPUT_REPORT_ID) {
-        std::cerr << "readInputReport Error: Wrong report ID. Expected 0x"
-                  << std::hex << (int)INPUT_REPORT_ID
-                  << ", got 0x" << std::hex << (int)buffer[0] << std::endl;
+    // Step 5: Verify this is a complete report of the correct type
+    // The F1 always sends 22 bytes starting with 0x01
+    if (!isValidInputReport(buffer, bytes_read)) {
+        logInvalidInputReport(buffer, bytes_read);
         return false;
     }
 
-    // Step 7: Success! There is a valid 22-byte input report
+    // Step 6: Success! There is a valid 22-byte input report
+    countMetric(MetricCounter::INPUT_REPORTS);
     return true;
 }
 
+/*
+* Reads an input report, but waits at most timeout_ms for it
+* Lets the main loop keep ticking when the F1 sends nothing
+*
+* @param device: Pointer to the opened HID device
+* @param buffer: Array to store the 22-byte input report
+* @param timeout_ms: Maximum time to wait in milliseconds
+* @return: 1 if a valid report was read, 0 on timeout or invalid report, -1 on error
+*/
+int readInputReportTimeout(hid_device* device, unsigned char* buffer, int timeout_ms) {
+
+    // Step 1: Check if device and buffer are valid
+    if (device == nullptr || buffer == nullptr) {
+        std::cerr << "readInputReportTimeout Error: Device or buffer is null" << std::endl;
+        return -1;
+    }
+
+    // Step 2: Try to read input report from the F1
+    int bytes_read = hid_read_timeout(device, buffer, INPUT_REPORT_SIZE, timeout_ms);
+
+    // Step 3: Check result: error, timeout or report
+    if (bytes_read < 0) {
+        countMetric(MetricCounter::READ_ERRORS);
+        std::cerr << "readInputReportTimeout Error: hid_read_timeout returned " << bytes_read << std::endl;
+        return -1;
+    }
+    if (bytes_read == 0) {
+        return 0;
+    }
+
+    // Step 4: Verify this is a complete report of the correct type
+    // A bad report is skipped like a timeout: the device is still there, so no reconnect
+    if (!isValidInputReport(buffer, bytes_read)) {
+        logInvalidInputReport(buffer, bytes_read);
+        return 0;
+    }
+
+    countMetric(MetricCounter::INPUT_REPORTS);
+    return 1;
+}
+
 // =============================================================================
 // SPECIAL BUTTON CHECKING FUNCTIONS
 // =============================================================================
@@ -71,48 +147,19 @@ bool readInputReport(hid_device *device, unsigned char *buffer) {
 */
 
 bool isSpecialButtonPressed(const unsigned char* buffer, SpecialButton button) {
-  
-    // Step 1: Safety check - make sure buffer is valid
-    if (buffer == nullptr) {
-        std::cerr << "Error: Buffer is null in isSpecialButtonPressed()" << std::endl;
-        return false;
-    }
 
-    // Step 2: Get the special buttons byte (byte 3 in the report)
-    unsigned char special_byte = buffer[BUTTON_BYTE_SPECIAL];  // buffer[3]
-
-    // Step 3: Determine which bit mask to use based on the button requested
-    unsigned char button_mask;
-
-    switch (button) {
-        case SpecialButton::SHIFT:
-            button_mask = BIT_MASK_SHIFT;           // 0x80 (bit 7)
-            break;
-        case SpecialButton::REVERSE:
-            button_mask = BIT_MASK_REVERSE;         // 0x40 (bit 6)
-            break;
-        case SpecialButton::TYPE:
-            button_mask = BIT_MASK_TYPE;            // 0x20 (bit 5)
-            break;
-        case SpecialButton::SIZE:
-            button_mask = BIT_MASK_SIZE;            // 0x10 (bit 4)
-            break;
-        case SpecialButton::BROWSE:
-            button_mask = BIT_MASK_BROWSE;          // 0x08 (bit 3)
-            break;
-        case SpecialButton::SELECTOR_WHEEL:
-            button_mask = BIT_MASK_SELECTOR_WHEEL;  // 0x04 (bit 2)
-            break;
-        default:
-            std::cerr << "Error: Unknown special button requested" << std::endl;
-            return false;
+    // Step 1: Safety checks - valid buffer and button
+    int index = (int)button;
+    if (buffer == nullptr || index < 0 || index >= SPECIAL_BUTTON_COUNT) {
+        std::cerr << "Error: Null buffer or unknown special button in isSpecialButtonPressed()" << std::endl;
+        return false;
     }
 
-    // Step 4: Use bitwise AND to check if the specific bit is set
-    bool is_pressed = (special_byte & button_mask) != 0;
+    // Step 2: Byte and bit of the button (generated from the controller descriptor)
+    const ControlInput& input = SPECIAL_BUTTON_INPUTS[index];
 
-    // Step 5: Return the result
-    return is_pressed;
+    // Step 3: Use bitwise AND to check if the specific bit is set
+    return (buffer[input.input_byte] & input.input_mask) != 0;
 }
 
 // =============================================================================
@@ -130,41 +177,18 @@ bool isSpecialButtonPressed(const unsigned char* buffer, SpecialButton button) {
 
 bool isStopButtonPressed(const unsigned char* buffer, StopButton button) {
 
-    // Step 1: Safety check - make sure buffer is valid
-    if (buffer == nullptr) {
-        std::cerr << "Error: Buffer is null in isStopButtonPressed()" << std::endl;
+    // Step 1: Safety checks - valid buffer and button
+    int index = (int)button - 1;
+    if (buffer == nullptr || index < 0 || index >= STOP_BUTTON_COUNT) {
+        std::cerr << "Error: Null buffer or unknown stop button in isStopButtonPressed()" << std::endl;
         return false;
     }
 
-    // Step 2: Get the stop buttons byte (byte 3 in the report)
-    unsigned char stop_byte = buffer[BUTTON_BYTE_STOP_AND_CONTROL];  // buffer[4]
-
-    // Step 3: Determine which bit mask to use based on the button requested
-    unsigned char button_mask;
-
-    switch (button) {
-        case StopButton::STOP1:
-            button_mask = BIT_MASK_STOP1;           // 0x80 (bit 7)
-            break;
-        case StopButton::STOP2:
-            button_mask = BIT_MASK_STOP2;           // 0x40 (bit 6)
-            break;
-        case StopButton::STOP3:
-            button_mask = BIT_MASK_STOP3;           // 0x20 (bit 5)
-            break;
-        case StopButton::STOP4:
-            button_mask = BIT_MASK_STOP4;           // 0x10 (bit 4)
-            break;
-        default:
-            std::cerr << "Error: Unknown stop button requested" << std::endl;
-            return false;
-    }
-
-    // Step 4: Use bitwise AND to check if the specific bit is set
-    bool is_pressed = (stop_byte & button_mask) != 0;
+    // Step 2: Byte and bit of the button (generated from the controller descriptor)
+    const ControlInput& input = STOP_BUTTON_INPUTS[index];
 
-    // Step 5: Return the result
-    return is_pressed;
+    // Step 3: Use bitwise AND to check if the specific bit is set
+    return (buffer[input.input_byte] & input.input_mask) != 0;
 }
 
 // =============================================================================
@@ -182,38 +206,18 @@ bool isStopButtonPressed(const unsigned char* buffer, StopButton button) {
 
 bool isControlButtonPressed(const unsigned char* buffer, ControlButton button) {
 
-    // Step 1: Safety check - make sure buffer is valid
-    if (buffer == nullptr) {
-        std::cerr << "Error: Buffer is null in isControlButtonPressed()" << std::endl;
+    // Step 1: Safety checks - valid buffer and button
+    int index = (int)button;
+    if (buffer == nullptr || index < 0 || index >= CONTROL_BUTTON_COUNT) {
+        std::cerr << "Error: Null buffer or unknown control button in isControlButtonPressed()" << std::endl;
         return false;
     }
 
-    // Step 2: Get the control buttons byte (byte 3 in the report)
-    unsigned char control_byte = buffer[BUTTON_BYTE_STOP_AND_CONTROL];  // buffer[4]
-
-    // Step 3: Determine which bit mask to use based on the button requested
-    unsigned char button_mask;
-
-    switch (button) {
-        case ControlButton::SYNC:
-            button_mask = BIT_MASK_SYNC;           // 0x80 (bit 7)
-            break;
-        case ControlButton::QUANT:
-            button_mask = BIT_MASK_QUANT;           // 0x40 (bit 6)
-            break;
-        case ControlButton::CAPTURE:
-            button_mask = BIT_MASK_CAPTURE;       // 0x20 (bit 5)
-            break;
-        default:
-            std::cerr << "Error: Unknown control button requested" << std::endl;
-            return false;
-    }
+    // Step 2: Byte and bit of the button (generated from the controller descriptor)
+    const ControlInput& input = CONTROL_BUTTON_INPUTS[index];
 
-    // Step 4: Use bitwise AND to check if the specific bit is set
-    bool is_pressed = (control_byte & button_mask) != 0;
-
-    // Step 5: Return the result
-    return is_pressed;
+    // Step 3: Use bitwise AND to check if the specific bit is set
+    return (buffer[input.input_byte] & input.input_mask) != 0;
 }
 
 // =============================================================================
@@ -223,87 +227,23 @@ bool isControlButtonPressed(const unsigned char* buffer, ControlButton button) {
 /*
 * Checks if a specific matrix button is currently pressed
  * Matrix is a 4x4 grid: rows 1-4, columns 1-4
+ * The pad is always valid (MatrixPad), so this is a table lookup and one AND
  * 
  * @param buffer: The 22-byte input report from readInputReport()
- * @param row: Matrix row (1-4)  
- * @param col: Matrix column (1-4)
+ * @param pad: Matrix button
  * @return: true if the button is pressed, false if not pressed
 
 Matrix Layout:          Byte Mapping:
-(1,1) (2,1) (3,1) (4,1)   Byte 1: bits 7,6,5,4
-(1,2) (2,2) (3,2) (4,2)   Byte 1: bits 3,2,1,0  
-(1,3) (2,3) (3,3) (4,3)   Byte 2: bits 7,6,5,4
-(1,4) (2,4) (3,4) (4,4)   Byte 2: bits 3,2,1,0
+(1,1) (1,2) (1,3) (1,4)   Byte 1: bits 7,6,5,4
+(2,1) (2,2) (2,3) (2,4)   Byte 1: bits 3,2,1,0  
+(3,1) (3,2) (3,3) (3,4)   Byte 2: bits 7,6,5,4
+(4,1) (4,2) (4,3) (4,4)   Byte 2: bits 3,2,1,0
 
 */
 
-bool isMatrixButtonPressed(const unsigned char* buffer, int row, int col) {
-    
-    // Step 1: Safety checks
-    if (buffer == nullptr) {
-        std::cerr << "Error: Buffer is null in isMatrixButtonPressed()" << std::endl;
-        return false;
-    }
-
-    // Step 2: Validate row and column ranges
-    if (row < 1 || row > 4 || col < 1 || col > 4) {
-        std::cerr << "Error: Invalid matrix position (" << row << "," << col 
-                  << "). Must be 1-4 for both row and column." << std::endl;
-        return false;
-    }
-
-    // Step 3: Determine which byte and bit to check
-    unsigned char matrix_byte;
-    unsigned char bit_mask;
-
-    // Switch statement to handle all 16 combinations
-    switch (row) {
-        case 1:
-            matrix_byte = buffer[BUTTON_BYTE_MATRIX_TOP];  // Byte 1
-            switch (col) {
-                case 1: bit_mask = BIT_MASK_MATRIX_1_1; break;  // 0x80
-                case 2: bit_mask = BIT_MASK_MATRIX_2_1; break;  // 0x40
-                case 3: bit_mask = BIT_MASK_MATRIX_3_1; break;  // 0x20
-                case 4: bit_mask = BIT_MASK_MATRIX_4_1; break;  // 0x10
-            }
-            break;
-            
-        case 2:
-            matrix_byte = buffer[BUTTON_BYTE_MATRIX_TOP];  // Byte 1
-            switch (col) {
-                case 1: bit_mask = BIT_MASK_MATRIX_1_2; break;  // 0x08
-                case 2: bit_mask = BIT_MASK_MATRIX_2_2; break;  // 0x04
-                case 3: bit_mask = BIT_MASK_MATRIX_3_2; break;  // 0x02
-                case 4: bit_mask = BIT_MASK_MATRIX_4_2; break;  // 0x01
-            }
-            break;
-            
-        case 3:
-            matrix_byte = buffer[BUTTON_BYTE_MATRIX_BOTTOM];  // Byte 2
-            switch (col) {
-                case 1: bit_mask = BIT_MASK_MATRIX_1_3; break;  // 0x80
-                case 2: bit_mask = BIT_MASK_MATRIX_2_3; break;  // 0x40
-                case 3: bit_mask = BIT_MASK_MATRIX_3_3; break;  // 0x20
-                case 4: bit_mask = BIT_MASK_MATRIX_4_3; break;  // 0x10
-            }
-            break;
-            
-        case 4:
-            matrix_byte = buffer[BUTTON_BYTE_MATRIX_BOTTOM];  // Byte 2
-            switch (col) {
-                case 1: bit_mask = BIT_MASK_MATRIX_1_4; break;  // 0x08
-                case 2: bit_mask = BIT_MASK_MATRIX_2_4; break;  // 0x04
-                case 3: bit_mask = BIT_MASK_MATRIX_3_4; break;  // 0x02
-                case 4: bit_mask = BIT_MASK_MATRIX_4_4; break;  // 0x01
-            }
-            break;
-    }
-
-    // Step 4: Check if the bit is set using bitwise AND
-    bool is_pressed = (matrix_byte & bit_mask) != 0;
-
-    // Step 5: Return the result
-    return is_pressed;
+bool isMatrixButtonPressed(const unsigned char* buffer, MatrixPad pad) {
+    const ControlLayout& layout = getMatrixPadLayout(pad);
+    return (buffer[layout.input_byte] & layout.input_mask) != 0;
 }
 
 // =============================================================================
@@ -21,6 +21,12 @@ bool FaderInputReader::initialize() {
         previous_values[i] = 0.0f;
     }
     initialized = false;
+
+    // Reset movement detection baselines
+    for (int i = 0; i < FADER_COUNT; i++) {
+        moved_values[i] = 0.0f;
+        moved_initialized[i] = false;
+    }
     return true;
 }
 
@@ -117,6 +123,49 @@ void FaderInputReader::updateFaderStates(const unsigned char* buffer) {
     initialized = true;
 }
 
+/*
+* Check if a fader moved since the last time this function returned true
+* Compares against the value at the last reported movement instead of the last
+* frame, so slow movements with many tiny steps are still detected, while
+* jitter around one value stays below the threshold.
+* The first call per fader only stores the baseline and returns false.
+*
+* @param buffer: The 22-byte input report from readInputReport()
+* @param fader_number: Which fader to check (1-4)
+* @param threshold: Minimum movement to report (default 0.005 = 0.5%)
+* @return: true if the fader moved beyond the threshold, false otherwise
+*/
+bool FaderInputReader::hasFaderMoved(const unsigned char* buffer, int fader_number, float threshold) {
+    // Step 1: Check if buffer is valid
+    if (buffer == nullptr) {
+        std::cerr << "FaderInputReader Error: Buffer is null in hasFaderMoved()" << std::endl;
+        return false;
+    }
+
+    // Step 2: Validate fader number range
+    if (fader_number < 1 || fader_number > FADER_COUNT) {
+        std::cerr << "FaderInputReader Error: Invalid fader number " << fader_number
+                  << " in hasFaderMoved()" << std::endl;
+        return false;
+    }
+
+    // Step 3: Store baseline on first call
+    int index = fader_number - 1;  // Convert to 0-3 indexing
+    float current_value = getFaderValue(buffer, fader_number);
+    if (!moved_initialized[index]) {
+        moved_values[index] = current_value;
+        moved_initialized[index] = true;
+        return false;
+    }
+
+    // Step 4: Compare against the last reported value, move baseline if exceeded
+    if (std::abs(current_value - moved_values[index]) <= threshold) {
+        return false;
+    }
+    moved_values[index] = current_value;
+    return true;
+}
+
 /*
 * Get the raw 12-bit fader value (for debugging or advanced use)
 * 
@@ -21,6 +21,12 @@ bool KnobInputReader::initialize() {
         previous_values[i] = 0.0f;
     }
     initialized = false;
+
+    // Reset movement detection baselines
+    for (int i = 0; i < KNOB_COUNT; i++) {
+        moved_values[i] = 0.0f;
+        moved_initialized[i] = false;
+    }
     return true;
 }
 
@@ -117,6 +123,49 @@ void KnobInputReader::updateKnobStates(const unsigned char* buffer) {
     initialized = true;
 }
 
+/*
+* Check if a knob moved since the last time this function returned true
+* Compares against the value at the last reported movement instead of the last
+* frame, so slow movements with many tiny steps are still detected, while
+* jitter around one value stays below the threshold.
+* The first call per knob only stores the baseline and returns false.
+*
+* @param buffer: The 22-byte input report from readInputReport()
+* @param knob_number: Which knob to check (1-4)
+* @param threshold: Minimum movement to report (default 0.005 = 0.5%)
+* @return: true if the knob moved beyond the threshold, false otherwise
+*/
+bool KnobInputReader::hasKnobMoved(const unsigned char* buffer, int knob_number, float threshold) {
+    // Step 1: Check if buffer is valid
+    if (buffer == nullptr) {
+        std::cerr << "KnobInputReader Error: Buffer is null in hasKnobMoved()" << std::endl;
+        return false;
+    }
+
+    // Step 2: Validate knob number range
+    if (knob_number < 1 || knob_number > KNOB_COUNT) {
+        std::cerr << "KnobInputReader Error: Invalid knob number " << knob_number
+                  << " in hasKnobMoved()" << std::endl;
+        return false;
+    }
+
+    // Step 3: Store baseline on first call
+    int index = knob_number - 1;  // Convert to 0-3 indexing
+    float current_value = getKnobValue(buffer, knob_number);
+    if (!moved_initialized[index]) {
+        moved_values[index] = current_value;
+        moved_initialized[index] = true;
+        return false;
+    }
+
+    // Step 4: Compare against the last reported value, move baseline if exceeded
+    if (std::abs(current_value - moved_values[index]) <= threshold) {
+        return false;
+    }
+    moved_values[index] = current_value;
+    return true;
+}
+
 // =============================================================================
 // PRIVATE HELPER FUNCTIONS
 // =============================================================================
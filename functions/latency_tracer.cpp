@@ -0,0 +1,166 @@
+#include "headers/latency_tracer.h"    // Include header file
+
+#include <iostream>                     // For std::cout
+#include <cstdio>                       // For snprintf
+
+// =============================================================================
+// STATE
+// =============================================================================
+
+thread_local LatencyTrace latency_trace;
+
+static LatencyHistogram latency_histograms[(int)LatencyStage::COUNT];
+static std::atomic<bool> latency_dump_requested{false};
+
+static const char* const LATENCY_STAGE_NAMES[(int)LatencyStage::COUNT] = {
+    "read -> decode",
+    "decode -> dispatch",
+    "dispatch -> LED frame",
+    "LED frame -> hid_write",
+    "read -> hid_write (total)"
+};
+
+// =============================================================================
+// LATENCY HISTOGRAM
+// =============================================================================
+
+/*
+* Log-linear bucket of a value
+* Values below LATENCY_SUB_BUCKETS get one bucket each, above that every power
+* of two is split into LATENCY_SUB_BUCKETS equal buckets.
+*/
+int LatencyHistogram::getBucketIndex(uint64_t value_ns) {
+    if (value_ns < (uint64_t)LATENCY_SUB_BUCKETS) {
+        return (int)value_ns;
+    }
+    int exponent = 63 - __builtin_clzll(value_ns);
+    if (exponent > LATENCY_MAX_EXPONENT) {
+        return LATENCY_BUCKET_COUNT - 1;
+    }
+    int shift = exponent - LATENCY_SUB_BUCKET_BITS;
+    int sub_bucket = (int)((value_ns >> shift) & (LATENCY_SUB_BUCKETS - 1));
+    return (shift + 1) * LATENCY_SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(int index) {
+    if (index < LATENCY_SUB_BUCKETS) {
+        return (uint64_t)index;
+    }
+    int shift = index / LATENCY_SUB_BUCKETS - 1;
+    uint64_t lower = (uint64_t)(LATENCY_SUB_BUCKETS + index % LATENCY_SUB_BUCKETS) << shift;
+    return lower + ((uint64_t)1 << shift) - 1;
+}
+
+/*
+* Adds one value (relaxed atomics: readers may see a count a few values ahead of the buckets)
+*/
+void LatencyHistogram::record(uint64_t value_ns) {
+    buckets[getBucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    uint64_t current_max = max_ns.load(std::memory_order_relaxed);
+    while (value_ns > current_max && !max_ns.compare_exchange_weak(current_max, value_ns, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMax() const {
+    return max_ns.load(std::memory_order_relaxed);
+}
+
+/*
+* Walks the buckets until the percentile's rank is reached
+*
+* @param percentile: 0-100, e.g. 99.9
+* @return: Upper bound of that bucket in ns (never above the maximum), 0 if empty
+*/
+uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    // Step 1: Total from the buckets themselves (consistent with the walk below)
+    uint64_t total = 0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        total += buckets[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Step 2: Find the bucket holding the rank
+    uint64_t rank = (uint64_t)(percentile / 100.0 * (double)total + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            uint64_t upper = getBucketUpperBound(i);
+            uint64_t max_value = getMax();
+            return upper < max_value ? upper : max_value;
+        }
+    }
+    return getMax();
+}
+
+// =============================================================================
+// PER-REPORT TRACE
+// =============================================================================
+
+/*
+* Records the stages of the current report
+* The write stages are only recorded if this report's LED frame was written.
+*/
+void endLatencyTrace() {
+    if (!latency_trace.active) {
+        return;
+    }
+    latency_trace.active = false;
+    const uint64_t* points = latency_trace.point_ns;
+
+    latency_histograms[(int)LatencyStage::READ_TO_DECODE].record(points[(int)LatencyPoint::DECODE] - points[(int)LatencyPoint::READ]);
+    latency_histograms[(int)LatencyStage::DECODE_TO_DISPATCH].record(points[(int)LatencyPoint::DISPATCH] - points[(int)LatencyPoint::DECODE]);
+    latency_histograms[(int)LatencyStage::DISPATCH_TO_LED_FRAME].record(points[(int)LatencyPoint::LED_FRAME] - points[(int)LatencyPoint::DISPATCH]);
+    if (points[(int)LatencyPoint::WRITE] != 0) {
+        latency_histograms[(int)LatencyStage::LED_FRAME_TO_WRITE].record(points[(int)LatencyPoint::WRITE] - points[(int)LatencyPoint::LED_FRAME]);
+        latency_histograms[(int)LatencyStage::READ_TO_WRITE].record(points[(int)LatencyPoint::WRITE] - points[(int)LatencyPoint::READ]);
+    }
+}
+
+// =============================================================================
+// DUMP
+// =============================================================================
+
+const LatencyHistogram& getLatencyHistogram(LatencyStage stage) {
+    return latency_histograms[(int)stage];
+}
+
+void requestLatencyDump() {
+    latency_dump_requested.store(true, std::memory_order_relaxed);
+}
+
+void printLatencyDumpIfRequested() {
+    if (latency_dump_requested.load(std::memory_order_relaxed) &&
+        latency_dump_requested.exchange(false, std::memory_order_relaxed)) {
+        printLatencyHistograms();
+    }
+}
+
+/*
+* Prints one line per stage: count, p50, p99, p99.9 and max in microseconds
+*/
+void printLatencyHistograms() {
+    char line[160];
+    std::cout << std::endl << "=== Latency per stage (us) ===" << std::endl;
+    snprintf(line, sizeof(line), "%-28s %10s %9s %9s %9s %9s", "stage", "count", "p50", "p99", "p99.9", "max");
+    std::cout << line << std::endl;
+    for (int i = 0; i < (int)LatencyStage::COUNT; i++) {
+        const LatencyHistogram& histogram = latency_histograms[i];
+        snprintf(line, sizeof(line), "%-28s %10llu %9.1f %9.1f %9.1f %9.1f", LATENCY_STAGE_NAMES[i],
+                 (unsigned long long)histogram.getCount(),
+                 histogram.getPercentile(50.0) / 1000.0, histogram.getPercentile(99.0) / 1000.0,
+                 histogram.getPercentile(99.9) / 1000.0, histogram.getMax() / 1000.0);
+        std::cout << line << std::endl;
+    }
+    std::cout.flush();
+}
@@ -2,38 +2,44 @@
 
 #include <iostream>             // For std::cout and std::cerr
 #include <iomanip>              // For std::hex (hexadecimal printing)
-#include <cstring>              // For memset (clearing memory)
+#include <cstring>              // For memset (clearing memory) and strcmp
 #include <unistd.h>             // For usleep (sleep function)
+#include "headers/latency_tracer.h"  // For LATENCY_MARK (hid_write completion)
+#include "headers/trace_recorder.h"  // For traceBegin/traceEnd (hid_write span)
+#include "headers/metrics_registry.h" // For LED write counters
+#include "headers/control_layout.h"  // For getMatrixPadLayout (LED bytes per pad)
 // #include <hidapi/hidapi.h>   // included already in header
 
 
 // =============================================================================
-// GLOBAL LED STATE BYTE BUFFER - Persistent byte buffer for all LED states
+// LED CONTROLLER CONTEXT - Per-device LED buffer, frame and state storage
 // =============================================================================
 
 /*
-* This byte buffer holds the current state of all LEDs on the F1.
-* It's persistent, so changing one LED does not affect the others.
-* The byte buffer is always ready to send to the F1 device.
+* All LED functions work on the context bound to the calling thread.
+* Threads that never call bindLEDController() share the default context,
+* so a single-device program works without binding anything.
 */
-unsigned char led_buffer[LED_REPORT_SIZE];
-hid_device* current_device = nullptr;  // Store device for automatic sending
-
-// =============================================================================
-// PARALLEL STATE STORAGE - Preserve original color/brightness values
-// =============================================================================
+static LEDControllerContext default_led_context;
+static thread_local LEDControllerContext* led_context = &default_led_context;
 
 /*
-* Parallel state storage arrays
-* 
-* These arrays store the original color and brightness values that were passed
-* to the LED functions, BEFORE conversion to 7-bit hardware format. This allows
-* other modules, such as the toggle system, to restore exact original values.
+* Binds an LED context to the calling thread
+* Call once at the start of each device thread, before any other LED function
+*
+* @param context: Context of this thread's device (nullptr = default context)
 */
-static LEDStateMatrix matrix_states[5][5];         // Original states for 5x5 matrix
-static LEDState special_states[5];                 // Original states for 5 special buttons
-static LEDState control_states[3];                 // Original states for 3 control buttons
-static LEDState stop_states[4];                    // Original states for 4 stop buttons
+void bindLEDController(LEDControllerContext* context) {
+    led_context = (context != nullptr) ? context : &default_led_context;
+}
+
+LEDControllerContext* getBoundLEDController() {
+    return led_context;
+}
+
+unsigned char* getLEDBuffer() {
+    return led_context->led_buffer;
+}
 
 // =============================================================================
 // HELPER FUNCTIONS - Internal functions for color conversion and validation
@@ -64,15 +70,16 @@ static unsigned char convertTo7Bit(unsigned char value_8bit, float brightness) {
 }
 
 /*
-* Validates matrix button position (row and column)
-* Matrix buttons are arranged in a 4x4 grid, rows 1-4, columns 1-4
-* 
-* @param row: Matrix row (should be 1-4)
-* @param col: Matrix column (should be 1-4)  
-* @return: true if position is valid, false if invalid
+* Writes the same value into every LED byte of a single-color button
+* (1 byte for special/control buttons, right and left LED for stop buttons)
+*
+* @param layout: Button layout from CONTROL_LAYOUT
+* @param led_value: 7-bit LED value
 */
-static bool isValidMatrixPosition(int row, int col) {
-    return (row >= 1 && row <= MATRIX_ROWS && col >= 1 && col <= MATRIX_COLS);
+static void writeButtonLEDs(const ControlLayout& layout, unsigned char led_value) {
+    for (int i = 0; i < layout.led_count; i++) {
+        led_context->led_buffer[layout.led_byte + i] = led_value;
+    }
 }
 
 // =============================================================================
@@ -86,61 +93,43 @@ static bool isValidMatrixPosition(int row, int col) {
 /*
 * Maps SpecialLEDButton enum to array index
 * 
-* This function provides explicit mapping from enum values to array indices.
-* This is safer than relying on implicit enum values and makes the mapping
-* clear and maintainable.
+* The enum value is the button's LED index in the controller descriptor
+* (control_layout.h), which also gives its LED byte and toggle bit.
 * 
 * @param button: The special button enum value
-* @return: Array index (0-7), or -1 if invalid button
+* @return: Array index (0-4), or -1 if invalid button
 */
 int getSpecialButtonIndex(SpecialLEDButton button) {
-    switch (button) {
-        case SpecialLEDButton::BROWSE:  return 0;    // Array index 0
-        case SpecialLEDButton::SIZE:    return 1;    // Array index 1
-        case SpecialLEDButton::TYPE:    return 2;    // Array index 2
-        case SpecialLEDButton::REVERSE: return 3;    // Array index 3
-        case SpecialLEDButton::SHIFT:   return 4;    // Array index 4
-    }
-    return -1; // Error case - should never happen with valid enum
+    int index = (int)button;
+    return (index >= 0 && index < SPECIAL_LED_COUNT) ? index : -1;
 }
 
 /*
 * Maps ControlLEDButton enum to array index
 *
-* This function provides explicit mapping from enum values to array indices.
-* This is safer than relying on implicit enum values and makes the mapping
-* clear and maintainable.
+* The enum value is the button's LED index in the controller descriptor
+* (control_layout.h), which also gives its LED byte and toggle bit.
 *
 * @param button: The control button enum value
 * @return: Array index (0-2), or -1 if invalid button
 */
 int getControlButtonIndex(ControlLEDButton button) {
-    switch (button) {
-        case ControlLEDButton::CAPTURE: return 0;    // Array index 0
-        case ControlLEDButton::QUANT:   return 1;    // Array index 1
-        case ControlLEDButton::SYNC:    return 2;    // Array index 2
-    }
-    return -1; // Error case - should never happen with valid enum
+    int index = (int)button;
+    return (index >= 0 && index < CONTROL_LED_COUNT) ? index : -1;
 }
 
 /*
  * Maps StopLEDButton enum to array index
  *
- * This function provides explicit mapping from enum values to array indices.
- * This is safer than relying on implicit enum values and makes the mapping
- * clear and maintainable.
+ * The enum value is the button's LED index in the controller descriptor
+ * (control_layout.h), which also gives its LED bytes and toggle bit.
  *
  * @param button: The stop button enum value
  * @return: Array index (0-3), or -1 if invalid button
  */
 int getStopButtonIndex(StopLEDButton button) {
-    switch (button) {
-        case StopLEDButton::STOP1: return 0;    // Array index 0
-        case StopLEDButton::STOP2: return 1;    // Array index 1
-        case StopLEDButton::STOP3: return 2;    // Array index 2
-        case StopLEDButton::STOP4: return 3;    // Array index 3
-    }
-    return -1; // Error case - should never happen with valid enum
+    int index = (int)button;
+    return (index >= 0 && index < STOP_LED_COUNT) ? index : -1;
 }
 
 // =======================================
@@ -153,20 +142,11 @@ int getStopButtonIndex(StopLEDButton button) {
 * Returns the original color and brightness that were set for this matrix
 * button position, before any 7-bit conversion or hardware formatting.
 * 
-* @param row: Matrix row (1-4)
-* @param col: Matrix column (1-4)
-* @return: LEDState with original color and brightness, or error state if invalid position
+* @param pad: Matrix button (always valid, see MatrixPad)
+* @return: LEDState with original color and brightness
 */
-LEDStateMatrix getMatrixButtonState(int row, int col) {
-    // Validate position first
-    if (!isValidMatrixPosition(row, col)) {
-        std::cerr << "Error: Invalid matrix position (" << row << "," << col 
-                  << ") in getMatrixButtonState()" << std::endl;
-        return {LEDColor::black, 0.0f}; // Return error state
-    }
-    
-    // Return the stored original state
-    return matrix_states[row][col];
+LEDStateMatrix getMatrixButtonState(MatrixPad pad) {
+    return led_context->matrix_states[pad.index()];
 }
 
 /*
@@ -184,13 +164,13 @@ LEDState getSpecialButtonState(SpecialLEDButton button) {
     int index = getSpecialButtonIndex(button);
     
     // Validate index
-    if (index < 0 || index > 4) {
+    if (index < 0) {
         std::cerr << "Error: Invalid special button in getSpecialButtonState()" << std::endl;
         return {0.0f}; // Return error state
     }
     
     // Return the stored original state
-    return special_states[index];
+    return led_context->special_states[index];
 }
 
 /*
@@ -208,13 +188,13 @@ LEDState getControlButtonState(ControlLEDButton button) {
     int index = getControlButtonIndex(button);
     
     // Validate index
-    if (index < 0 || index > 2) {
+    if (index < 0) {
         std::cerr << "Error: Invalid control button in getControlButtonState()" << std::endl;
         return {0.0f}; // Return error state
     }
     
     // Return the stored original state
-    return control_states[index];
+    return led_context->control_states[index];
 }
 
 /*
@@ -232,13 +212,13 @@ LEDState getStopButtonState(StopLEDButton button) {
     int index = getStopButtonIndex(button);
     
     // Validate index
-    if (index < 0 || index > 3) {
+    if (index < 0) {
         std::cerr << "Error: Invalid stop button in getStopButtonState()" << std::endl;
         return {0.0f}; // Return error state
     }
     
     // Return the stored original state
-    return stop_states[index];
+    return led_context->stop_states[index];
 }
 
 // =============================================================================
@@ -372,6 +352,32 @@ BRGColor getColorWithBrightness(LEDColor color, float brightness) {
     return result;
 }
 
+/*
+* Gets a color by its enum name (e.g. for text or network commands)
+*
+* @param name: Color name in lower case ("red", "lightorange", ...)
+* @param color: Receives the color
+* @return: true if the name is known, false otherwise
+*/
+bool getLEDColorByName(const char* name, LEDColor& color) {
+    // Same order as the LEDColor enum
+    static const char* const COLOR_NAMES[LED_COLOR_COUNT] = {
+        "black", "red", "orange", "lightorange", "warmyellow", "yellow", "lime", "green", "mint",
+        "cyan", "turquise", "blue", "plum", "violet", "purple", "magenta", "fuchsia", "white"
+    };
+
+    if (name == nullptr) {
+        return false;
+    }
+    for (int i = 0; i < LED_COLOR_COUNT; i++) {
+        if (strcmp(name, COLOR_NAMES[i]) == 0) {
+            color = (LEDColor)i;
+            return true;
+        }
+    }
+    return false;
+}
+
 // =============================================================================
 // MAIN LED SYSTEM FUNCTIONS
 // =============================================================================
@@ -393,32 +399,30 @@ bool initializeLEDController(hid_device* device) {
     }
     
     // Step 2: Store device for automatic sending
-    current_device = device;
+    led_context->device = device;
     
     // Step 3: Initialize LED buffer to all zeros (all LEDs off)
-    memset(led_buffer, 0, LED_REPORT_SIZE);
+    memset(led_context->led_buffer, 0, LED_REPORT_SIZE);
     
     // Step 4: Set the report ID (first byte must be 0x80)
-    led_buffer[0] = LED_REPORT_ID;
+    led_context->led_buffer[0] = LED_REPORT_ID;
 
     // Step 5: Initialize state storage arrays to default values
     // SPECIAL BUTTONS: Initialize special button states to off (color irrelevant for special buttons)
     for (int i = 0; i < 5; i++) {
-        special_states[i] = {0.0f};
+        led_context->special_states[i] = {0.0f};
     }
     // CONTROL BUTTONS: Initialize control button states to off (color irrelevant for control buttons)
     for (int i = 0; i < 3; i++) {
-        control_states[i] = {0.0f};
+        led_context->control_states[i] = {0.0f};
     }
     // STOP BUTTONS: Initialize stop button states to off (color irrelevant for stop buttons)
     for (int i = 0; i < 4; i++) {
-        stop_states[i] = {0.0f};
+        led_context->stop_states[i] = {0.0f};
     }
     // MATRIX:Initialize matrix states to black/off
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 1; col <= 4; col++) {
-            matrix_states[row][col] = {LEDColor::black, 0.0f};
-        }
+    for (int pad = 0; pad < MATRIX_PAD_COUNT; pad++) {
+        led_context->matrix_states[pad] = {LEDColor::black, 0.0f};
     }
 
     // Step 6: Send initial empty report to turn off all LEDs
@@ -448,7 +452,11 @@ bool sendLEDReport(hid_device* device) {
     }
     
     // Step 2: Send the 81-byte LED report to the F1
-    int bytes_sent = hid_write(device, led_buffer, LED_REPORT_SIZE);
+    uint64_t trace_start = traceBegin();
+    uint64_t write_start = getLatencyClockNs();
+    int bytes_sent = hid_write(device, led_context->led_buffer, LED_REPORT_SIZE);
+    recordLEDWrite(getLatencyClockNs() - write_start, bytes_sent, LED_REPORT_SIZE);
+    traceEnd(TraceName::LED_WRITE, trace_start);
     
     // Step 3: Check if the send operation was successful
     if (bytes_sent < 0) {
@@ -461,10 +469,109 @@ bool sendLEDReport(hid_device* device) {
     if (bytes_sent != LED_REPORT_SIZE) {
         std::cerr << "Warning: Partial LED report sent. Expected " 
                   << LED_REPORT_SIZE << " bytes, sent " << bytes_sent << " bytes" << std::endl;
+        led_context->last_sent_valid = false;
         return false;
     }
     
-    // Step 5: Success!
+    // Step 5: Success! Remember what the F1 is showing now
+    LATENCY_MARK(WRITE);
+    memcpy(led_context->last_sent_buffer, led_context->led_buffer, LED_REPORT_SIZE);
+    led_context->last_sent_valid = true;
+    return true;
+}
+
+// =============================================================================
+// LED FRAME BATCHING - Collect LED changes and send them as one report
+// =============================================================================
+
+/*
+* Opens an LED frame
+* While a frame is open, the set...LED() functions only change the LED buffer.
+* endLEDFrame() then sends everything as a single report. Frames can be nested,
+* only the outermost endLEDFrame() sends.
+*/
+void beginLEDFrame() {
+    led_context->frame_depth++;
+}
+
+/*
+* Closes an LED frame and sends the LED buffer once if anything changed
+* If the buffer is identical to the last sent report, nothing is sent
+*
+* @return: true if successful (or nothing to send), false if sending failed (frame stays dirty)
+*/
+bool endLEDFrame() {
+    // Step 1: Only the outermost frame sends
+    if (led_context->frame_depth > 0) {
+        led_context->frame_depth--;
+    }
+    if (led_context->frame_depth > 0 || !led_context->frame_dirty) {
+        return true;
+    }
+
+    // Step 2: Skip the report if the F1 already shows exactly this buffer
+    if (led_context->last_sent_valid && memcmp(led_context->last_sent_buffer, led_context->led_buffer, LED_REPORT_SIZE) == 0) {
+        led_context->frame_dirty = false;
+        countMetric(MetricCounter::LED_FRAMES_SUPPRESSED);
+        return true;
+    }
+
+    // Step 3: Send the whole frame as one report (stays dirty if that fails, the next frame retries)
+    if (led_context->device == nullptr || !sendLEDReport(led_context->device)) {
+        return false;
+    }
+    led_context->frame_dirty = false;
+    return true;
+}
+
+/*
+* Sends the LED buffer after a change, or defers it if an LED frame is open
+* Used by all functions that change the LED buffer
+*
+* @return: true if sent or deferred, false if sending failed or no device
+*/
+bool commitLEDBuffer() {
+    // Step 1: Inside a frame - just remember that something changed
+    if (led_context->frame_depth > 0) {
+        led_context->frame_dirty = true;
+        return true;
+    }
+
+    // Step 2: Outside a frame - send immediately
+    if (led_context->device != nullptr) {
+        return sendLEDReport(led_context->device);
+    } else {
+        std::cerr << "Warning: No device connected, LED set in buffer only" << std::endl;
+        return false;
+    }
+}
+
+// =============================================================================
+// HOT-PLUG - Keep the LED state while the F1 is gone
+// =============================================================================
+
+/*
+* Changes the device of the bound context
+* While the device is nullptr (disconnected), LED changes only update the buffer
+*
+* @param device: Reopened device, or nullptr after a disconnect
+*/
+void setLEDControllerDevice(hid_device* device) {
+    led_context->device = device;
+    led_context->last_sent_valid = false;   // The F1 shows nothing we know of
+}
+
+/*
+* Sends the complete current LED buffer as one report
+* Used after a reconnect, so the F1 shows the same frame as before the disconnect
+*
+* @return: true if sent, false if no device or sending failed
+*/
+bool replayLEDFrame() {
+    if (led_context->device == nullptr || !sendLEDReport(led_context->device)) {
+        return false;
+    }
+    led_context->frame_dirty = false;
     return true;
 }
 
@@ -475,34 +582,29 @@ bool sendLEDReport(hid_device* device) {
 */
 void clearAllLEDs() {
     // Step 1: Clear the entire buffer except the report ID
-    memset(led_buffer + 1, 0, LED_REPORT_SIZE - 1);  // Skip first byte (report ID)
+    memset(led_context->led_buffer + 1, 0, LED_REPORT_SIZE - 1);  // Skip first byte (report ID)
     
     // Step 2: Clear state storage arrays to match
     // SPECIAL BUTTONS: Clear special button states to off (color irrelevant for special buttons)
     for (int i = 0; i < 5; i++) {
-        special_states[i] = {0.0f};
+        led_context->special_states[i] = {0.0f};
     }
     // CONTROL BUTTONS: Clear control button states to off (color irrelevant for control buttons)
     for (int i = 0; i < 3; i++) {
-        control_states[i] = {0.0f};
+        led_context->control_states[i] = {0.0f};
     }
     // STOP BUTTONS: Clear stop button states to off (color irrelevant for stop buttons)
     for (int i = 0; i < 4; i++) {
-        stop_states[i] = {0.0f};
+        led_context->stop_states[i] = {0.0f};
     }
     // MATRIX: Clear matrix states to black/off
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 1; col <= 4; col++) {
-            matrix_states[row][col] = {LEDColor::black, 0.0f};
-        }
+    for (int pad = 0; pad < MATRIX_PAD_COUNT; pad++) {
+        led_context->matrix_states[pad] = {LEDColor::black, 0.0f};
     }
 
-    // Step 3: Send the cleared buffer to the F1
-    if (current_device != nullptr) {
-        sendLEDReport(current_device);
+    // Step 3: Send the cleared buffer to the F1 (or defer until the LED frame ends)
+    if (commitLEDBuffer()) {
         std::cout << "All LEDs cleared" << std::endl;
-    } else {
-        std::cerr << "Warning: No device connected, LEDs cleared in buffer only" << std::endl;
     }
 }
 
@@ -515,53 +617,59 @@ void clearAllLEDs() {
 * Saves the original color and brightness in the state storage
 * Matrix buttons are arranged in a 4x4 grid with RGB LEDs (BRG format)
 * 
-* @param row: Matrix row (1-4)
-* @param col: Matrix column (1-4)
+* @param pad: Matrix button (always valid, see MatrixPad)
 * @param color: Color to set (using LEDColor enum)
 * @param brightness: Brightness level (0.0 = off, 1.0 = full brightness)
 * @param store_led_state: Whether to store the LED state (original color/brightness)
-* @return: true if successful, false if error
+* @return: true if successful, false if the report could not be sent
 */
-bool setMatrixButtonLED(int row, int col, LEDColor color, float brightness, bool store_led_state) {
-    // Step 1: Validate matrix position
-    if (!isValidMatrixPosition(row, col)) {
-        std::cerr << "Error: Invalid matrix position (" << row << "," << col 
-                  << "). Must be 1-4 for both row and column." << std::endl;
-        return false;
-    }
-
-    // Step 2: Clamp brightness to valid range
+bool setMatrixButtonLED(MatrixPad pad, LEDColor color, float brightness, bool store_led_state) {
+    // Step 1: Clamp brightness to valid range
     if (brightness < 0.0f) brightness = 0.0f;
     if (brightness > 1.0f) brightness = 1.0f;
 
-    // Step 3: Save the original color and brightness in the state storage
+    // Step 2: Save the original color and brightness in the state storage
     // This happens BEFORE any conversion, preserving exact original values
     // Save state only if requested
     if (store_led_state) {
-        matrix_states[row][col] = {color, brightness};
+        led_context->matrix_states[pad.index()] = {color, brightness};
     }
 
-    // Step 4: Calculate the byte position for this matrix button
-    // Matrix mapping: (row-1) * 4 + (col-1) gives button index (0-15)
-    // Each button has 3 bytes (BRG), so multiply by 3
-    int button_index = (row - 1) * MATRIX_COLS + (col - 1);
-    int base_byte = LED_BYTE_MATRIX_START + (button_index * MATRIX_LEDS_PER_BUTTON);
+    // Step 3: Look up the byte position for this matrix button (3 bytes BRG per pad)
+    int base_byte = getMatrixPadLayout(pad).led_byte;
     
-    // Step 5: Get the color values in BRG format with brightness
+    // Step 4: Get the color values in BRG format with brightness
     BRGColor brg_color = getColorWithBrightness(color, brightness);
     
-    // Step 6: Set the three LED bytes for this button (Blue, Red, Green order)
-    led_buffer[base_byte]     = brg_color.blue;   // Blue LED
-    led_buffer[base_byte + 1] = brg_color.red;    // Red LED  
-    led_buffer[base_byte + 2] = brg_color.green;  // Green LED
+    // Step 5: Set the three LED bytes for this button (Blue, Red, Green order)
+    led_context->led_buffer[base_byte]     = brg_color.blue;   // Blue LED
+    led_context->led_buffer[base_byte + 1] = brg_color.red;    // Red LED  
+    led_context->led_buffer[base_byte + 2] = brg_color.green;  // Green LED
     
-    // Step 7: Send the updated buffer to the F1
-    if (current_device != nullptr) {
-        return sendLEDReport(current_device);
-    } else {
-        std::cerr << "Warning: No device connected, LED set in buffer only" << std::endl;
-        return false;
-    }
+    // Step 6: Send the updated buffer to the F1 (or defer until the LED frame ends)
+    return commitLEDBuffer();
+}
+
+/*
+* Sets a matrix button to any 8-bit RGB color (e.g. from an external renderer)
+* Uses the same 8-bit to 7-bit conversion as the LEDColor palette
+* The state storage is not changed, so toggles still restore the scene color
+*
+* @param pad: Matrix button (always valid, see MatrixPad)
+* @param red, green, blue: Color values (0-255)
+* @param brightness: Brightness level (0.0 = off, 1.0 = full brightness)
+* @return: true if successful, false if the report could not be sent
+*/
+bool setMatrixButtonRGB(MatrixPad pad, unsigned char red, unsigned char green, unsigned char blue, float brightness) {
+    // Step 1: Set the three LED bytes for this button (Blue, Red, Green order)
+    int base_byte = getMatrixPadLayout(pad).led_byte;
+
+    led_context->led_buffer[base_byte]     = convertTo7Bit(blue, brightness);
+    led_context->led_buffer[base_byte + 1] = convertTo7Bit(red, brightness);
+    led_context->led_buffer[base_byte + 2] = convertTo7Bit(green, brightness);
+
+    // Step 2: Send the updated buffer to the F1 (or defer until the LED frame ends)
+    return commitLEDBuffer();
 }
 
 // =============================================================================
@@ -581,7 +689,7 @@ bool setMatrixButtonLED(int row, int col, LEDColor color, float brightness, bool
 bool setSpecialButtonLED(SpecialLEDButton button, float brightness, bool store_led_state) {
     // Step 1: Get array index for this button
     int index = getSpecialButtonIndex(button);
-    if (index < 0 || index > 4) {
+    if (index < 0) {
         std::cerr << "Error: Invalid special button in setSpecialButtonLED()" << std::endl;
         return false;
     }
@@ -594,46 +702,17 @@ bool setSpecialButtonLED(SpecialLEDButton button, float brightness, bool store_l
     // This happens BEFORE any conversion, preserving exact original value
     // Save only if requested
     if (store_led_state) {
-        special_states[index] = {brightness};
+        led_context->special_states[index] = {brightness};
     }
 
     // Step 4: Convert brightness to 7-bit value (F1 hardware requirement)
     unsigned char led_value = convertTo7Bit(255, brightness);  // Use max 7-bit value with brightness
     
-    // Step 5: Determine which byte to set based on the button
-    int byte_position;
+    // Step 5: Write the LED byte of this button (generated from the controller descriptor)
+    writeButtonLEDs(CONTROL_LAYOUT[TOGGLE_BIT_SPECIAL_START + index], led_value);
     
-    switch (button) {
-        case SpecialLEDButton::BROWSE:
-            byte_position = LED_BYTE_SPECIAL_START + LED_OFFSET_BROWSE;
-            break;
-        case SpecialLEDButton::SIZE:
-            byte_position = LED_BYTE_SPECIAL_START + LED_OFFSET_SIZE;
-            break;
-        case SpecialLEDButton::TYPE:
-            byte_position = LED_BYTE_SPECIAL_START + LED_OFFSET_TYPE;
-            break;
-        case SpecialLEDButton::REVERSE:
-            byte_position = LED_BYTE_SPECIAL_START + LED_OFFSET_REVERSE;
-            break;
-        case SpecialLEDButton::SHIFT:
-            byte_position = LED_BYTE_SPECIAL_START + LED_OFFSET_SHIFT;
-            break;
-        default:
-            std::cerr << "Error: Unknown special button requested" << std::endl;
-            return false;
-    }
-    
-    // Step 6: Set the LED value in the buffer
-    led_buffer[byte_position] = led_value;
-    
-    // Step 7: Send the updated buffer to the F1
-    if (current_device != nullptr) {
-        return sendLEDReport(current_device);
-    } else {
-        std::cerr << "Warning: No device connected, LED set in buffer only" << std::endl;
-        return false;
-    }
+    // Step 6: Send the updated buffer to the F1 (or defer until the LED frame ends)
+    return commitLEDBuffer();
 }
 
 // =============================================================================
@@ -653,7 +732,7 @@ bool setSpecialButtonLED(SpecialLEDButton button, float brightness, bool store_l
 bool setControlButtonLED(ControlLEDButton button, float brightness, bool store_led_state) {
     // Step 1: Get array index for this button
     int index = getControlButtonIndex(button);
-    if (index < 0 || index > 2) {
+    if (index < 0) {
         std::cerr << "Error: Invalid control button in setControlButtonLED()" << std::endl;
         return false;
     }
@@ -666,40 +745,17 @@ bool setControlButtonLED(ControlLEDButton button, float brightness, bool store_l
     // This happens BEFORE any conversion, preserving exact original value
     // Save only if requested
     if (store_led_state) {
-        control_states[index] = {brightness};
+        led_context->control_states[index] = {brightness};
     }
 
     // Step 4: Convert brightness to 7-bit value
     unsigned char led_value = convertTo7Bit(255, brightness);
 
-    // Step 5: Determine byte position for this control button
-    int byte_position;
-    
-    switch (button) {
-        case ControlLEDButton::CAPTURE:
-            byte_position = LED_BYTE_CONTROL_START + LED_OFFSET_CAPTURE;
-            break;
-        case ControlLEDButton::QUANT:
-            byte_position = LED_BYTE_CONTROL_START + LED_OFFSET_QUANT;
-            break;
-        case ControlLEDButton::SYNC:
-            byte_position = LED_BYTE_CONTROL_START + LED_OFFSET_SYNC;
-            break;
-        default:
-            std::cerr << "Error: Unknown control button requested" << std::endl;
-            return false;
-    }
+    // Step 5: Write the LED byte of this button (generated from the controller descriptor)
+    writeButtonLEDs(CONTROL_LAYOUT[TOGGLE_BIT_CONTROL_START + index], led_value);
     
-    // Step 6: Set the LED value in the buffer
-    led_buffer[byte_position] = led_value;
-    
-    // Step 7: Send the updated buffer to the F1
-    if (current_device != nullptr) {
-        return sendLEDReport(current_device);
-    } else {
-        std::cerr << "Warning: No device connected, LED set in buffer only" << std::endl;
-        return false;
-    }
+    // Step 6: Send the updated buffer to the F1 (or defer until the LED frame ends)
+    return commitLEDBuffer();
 }
 
 // =============================================================================
@@ -719,7 +775,7 @@ bool setControlButtonLED(ControlLEDButton button, float brightness, bool store_l
 bool setStopButtonLED(StopLEDButton button, float brightness, bool store_led_state) {    
     // Step 1: Get array index for this button
     int index = getStopButtonIndex(button);
-    if (index < 0 || index > 3) {
+    if (index < 0) {
         std::cerr << "Error: Invalid stop button in setStopButtonLED()" << std::endl;
         return false;
     }
@@ -732,45 +788,17 @@ bool setStopButtonLED(StopLEDButton button, float brightness, bool store_led_sta
     // This happens BEFORE any conversion, preserving exact original value
     // Save only if requested
     if (store_led_state) {
-        stop_states[index] = {brightness};
+        led_context->stop_states[index] = {brightness};
     }
 
     // Step 4: Convert brightness to 7-bit value
     unsigned char led_value = convertTo7Bit(255, brightness);
 
-    // Step 5: Determine byte positions for both LEDs of this stop button
-    int left_byte, right_byte;
-    
-    switch (button) {
-        case StopLEDButton::STOP1:
-            right_byte = LED_BYTE_STOP_START + LED_OFFSET_STOP1_RIGHT;
-            left_byte = LED_BYTE_STOP_START + LED_OFFSET_STOP1_LEFT;
-            break;
-        case StopLEDButton::STOP2:
-            right_byte = LED_BYTE_STOP_START + LED_OFFSET_STOP2_RIGHT;
-            left_byte = LED_BYTE_STOP_START + LED_OFFSET_STOP2_LEFT;
-            break;
-        case StopLEDButton::STOP3:
-            right_byte = LED_BYTE_STOP_START + LED_OFFSET_STOP3_RIGHT;
-            left_byte = LED_BYTE_STOP_START + LED_OFFSET_STOP3_LEFT;
-            break;
-        case StopLEDButton::STOP4:
-            right_byte = LED_BYTE_STOP_START + LED_OFFSET_STOP4_RIGHT;
-            left_byte = LED_BYTE_STOP_START + LED_OFFSET_STOP4_LEFT;
-            break;
-    }
-    
-    // Step 6: Set both LED values in the buffer
-    led_buffer[right_byte] = led_value;
-    led_buffer[left_byte] = led_value;
+    // Step 5: Write both LED bytes (right, left) of this button (generated from the controller descriptor)
+    writeButtonLEDs(CONTROL_LAYOUT[TOGGLE_BIT_STOP_START + index], led_value);
     
-    // Step 7: Send the updated buffer to the F1
-    if (current_device != nullptr) {
-        return sendLEDReport(current_device);
-    } else {
-        std::cerr << "Warning: No device connected, LED set in buffer only" << std::endl;
-        return false;
-    }
+    // Step 6: Send the updated buffer to the F1 (or defer until the LED frame ends)
+    return commitLEDBuffer();
 }
 
 // =============================================================================
@@ -789,7 +817,7 @@ void printLEDStates() {
     for (int row = 1; row <= 4; row++) {
         std::cout << "  Row " << row << ": ";
         for (int col = 1; col <= 4; col++) {
-            LEDStateMatrix state = matrix_states[row][col];
+            LEDStateMatrix state = getMatrixButtonState(MatrixPad::fromIndex((row - 1) * MATRIX_COLS + (col - 1)));
             std::cout << "(" << (int)state.color << "," << std::fixed 
                       << std::setprecision(2) << state.brightness << ") ";
         }
@@ -802,7 +830,7 @@ void printLEDStates() {
                                   "SHIFT"};
     for (int i = 0; i < 5; i++) {
         std::cout << "  " << button_names[i] << ": " << std::fixed 
-                  << std::setprecision(2) << special_states[i].brightness << std::endl;
+                  << std::setprecision(2) << led_context->special_states[i].brightness << std::endl;
     }
 
     // Print control button states
@@ -810,14 +838,14 @@ void printLEDStates() {
     const char* control_button_names[] = {"CAPTURE", "QUANT", "SYNC"};
     for (int i = 0; i < 3; i++) {
         std::cout << "  " << control_button_names[i] << ": " << std::fixed
-                  << std::setprecision(2) << control_states[i].brightness << std::endl;
+                  << std::setprecision(2) << led_context->control_states[i].brightness << std::endl;
     }
 
     // Print stop button states
     std::cout << "Stop button states (original brightness):" << std::endl;
     for (int i = 0; i < 4; i++) {
         std::cout << "  STOP" << (i + 1) << ": " << std::fixed 
-                  << std::setprecision(2) << stop_states[i].brightness << std::endl;
+                  << std::setprecision(2) << led_context->stop_states[i].brightness << std::endl;
     }
 
     std::cout << "=========================" << std::endl;
@@ -832,40 +860,40 @@ void printLEDReport() {
     
     // Print report ID
     std::cout << "Report ID: 0x" << std::hex << std::setfill('0') << std::setw(2) 
-              << (int)led_buffer[0] << std::endl;
+              << (int)led_context->led_buffer[0] << std::endl;
     
     // Print in groups for easier reading
     std::cout << "7-Seg Right (1-8):   ";
     for (int i = 1; i <= 8; i++) {
         std::cout << std::hex << std::setfill('0') << std::setw(2) 
-                  << (int)led_buffer[i] << " ";
+                  << (int)led_context->led_buffer[i] << " ";
     }
     std::cout << std::endl;
     
     std::cout << "7-Seg Left (9-16):   ";
     for (int i = 9; i <= 16; i++) {
         std::cout << std::hex << std::setfill('0') << std::setw(2) 
-                  << (int)led_buffer[i] << " ";
+                  << (int)led_context->led_buffer[i] << " ";
     }
     std::cout << std::endl;
     
     std::cout << "Special (17-21):     ";
     for (int i = 17; i <= 21; i++) {
         std::cout << std::hex << std::setfill('0') << std::setw(2) 
-                  << (int)led_buffer[i] << " ";
+                  << (int)led_context->led_buffer[i] << " ";
     }
     std::cout << std::endl;
 
     std::cout << "Control (22-24):     ";
     for (int i = 22; i <= 24; i++) {
         std::cout << std::hex << std::setfill('0') << std::setw(2) 
-                  << (int)led_buffer[i] << " ";
+                  << (int)led_context->led_buffer[i] << " ";
     }
 
     std::cout << "Matrix (25-72):      ";
     for (int i = 25; i <= 72; i++) {
         std::cout << std::hex << std::setfill('0') << std::setw(2) 
-                  << (int)led_buffer[i] << " ";
+                  << (int)led_context->led_buffer[i] << " ";
         if ((i - 24) % 12 == 0) std::cout << std::endl << "                     ";
     }
     std::cout << std::endl;
@@ -873,7 +901,7 @@ void printLEDReport() {
     std::cout << "Stop (73-80):        ";
     for (int i = 73; i <= 80; i++) {
         std::cout << std::hex << std::setfill('0') << std::setw(2) 
-                  << (int)led_buffer[i] << " ";
+                  << (int)led_context->led_buffer[i] << " ";
     }
     std::cout << std::dec << std::endl;  // Return to decimal mode
 }
@@ -892,11 +920,9 @@ void testAllLEDs() {
     LEDColor test_colors[] = {LEDColor::red, LEDColor::green, LEDColor::blue, LEDColor::white};
     
     for (int i = 0; i < 4; i++) {
-        for (int row = 1; row <= 4; row++) {
-            for (int col = 1; col <= 4; col++) {
-                setMatrixButtonLED(row, col, test_colors[i], 0.5f, false);
-                usleep(100000);  // Sleep for 100ms
-            }
+        for (int pad = 0; pad < MATRIX_PAD_COUNT; pad++) {
+            setMatrixButtonLED(MatrixPad::fromIndex(pad), test_colors[i], 0.5f, false);
+            usleep(100000);  // Sleep for 100ms
         }
         std::cout << "Matrix LEDs set to color " << i + 1 << "/4" << std::endl;
         // In a real application, you'd add a delay here
@@ -1,32 +1,101 @@
 #include "headers/led_controller_display.h"
 #include "headers/led_controller.h"
+#include "headers/control_layout.h"     // For F1_DESCRIPTOR (digit LED bytes)
 
-#include <iostream>
+#include <array>                    // For std::array (glyph table)
 #include <hidapi/hidapi.h>
 
 // =============================================================================
-// CONSTANTS - 7-SEGMENT DIGIT PATTERNS
+// CONSTANTS - 7-SEGMENT GLYPH TABLE
 // =============================================================================
 
 /*
-* 7-segment display patterns for digits 0-9 and blank
-* Each pattern is an array of 7 values corresponding to the segments:
-* [middle, lower_right, upper_right, top, upper_left, lower_left, bottom]
-* Value 127 = full brightness, 0 = off
+* Builds the ASCII glyph table at compile time
+* Each glyph is a bit mask of SEG_... values
+* Lower case letters without an own shape use the upper case glyph
+* Seven segments cannot tell every letter apart: M and N share the same glyph,
+* and so do U, V and W (text that needs them reads from context)
 */
-const uint8_t DIGIT_PATTERNS[11][7] = {
-    {0, 127, 127, 127, 127, 127, 127},    // 0
-    {0, 127, 127, 0, 0, 0, 0},            // 1
-    {127, 0, 127, 127, 0, 127, 127},      // 2
-    {127, 127, 127, 127, 0, 0, 127},      // 3
-    {127, 127, 127, 0, 127, 0, 0},        // 4
-    {127, 127, 0, 127, 127, 0, 127},      // 5
-    {127, 127, 0, 127, 127, 127, 127},    // 6
-    {0, 127, 127, 127, 0, 0, 0},          // 7
-    {127, 127, 127, 127, 127, 127, 127},  // 8
-    {127, 127, 127, 127, 127, 0, 127},    // 9
-    {0, 0, 0, 0, 0, 0, 0}                 // 10 = blank
-};
+static constexpr uint8_t glyphFor(char c) {
+    constexpr uint8_t M = SEG_MIDDLE, LR = SEG_LOWER_RIGHT, UR = SEG_UPPER_RIGHT, T = SEG_TOP,
+                      UL = SEG_UPPER_LEFT, LL = SEG_LOWER_LEFT, B = SEG_BOTTOM;
+    switch (c) {
+        // Digits
+        case '0': return LR | UR | T | UL | LL | B;
+        case '1': return LR | UR;
+        case '2': return M | UR | T | LL | B;
+        case '3': return M | LR | UR | T | B;
+        case '4': return M | LR | UR | UL;
+        case '5': return M | LR | T | UL | B;
+        case '6': return M | LR | T | UL | LL | B;
+        case '7': return LR | UR | T;
+        case '8': return M | LR | UR | T | UL | LL | B;
+        case '9': return M | LR | UR | T | UL | B;
+
+        // Letters
+        case 'A': return M | LR | UR | T | UL | LL;
+        case 'B': case 'b': return M | LR | UL | LL | B;
+        case 'C': return T | UL | LL | B;
+        case 'c': return M | LL | B;
+        case 'D': case 'd': return M | LR | UR | LL | B;
+        case 'E': return M | T | UL | LL | B;
+        case 'F': return M | T | UL | LL;
+        case 'G': return LR | T | UL | LL | B;
+        case 'H': return M | LR | UR | UL | LL;
+        case 'h': return M | LR | UL | LL;
+        case 'I': return UL | LL;
+        case 'i': return LL;
+        case 'J': return LR | UR | LL | B;
+        case 'K': return M | LR | T | UL | LL;
+        case 'L': return UL | LL | B;
+        case 'M': return LR | UR | T | UL | LL;         // Same as N
+        case 'N': return LR | UR | T | UL | LL;
+        case 'n': return M | LR | LL;
+        case 'O': return LR | UR | T | UL | LL | B;
+        case 'o': return M | LR | LL | B;
+        case 'P': return M | UR | T | UL | LL;
+        case 'Q': case 'q': return M | LR | UR | T | UL;
+        case 'R': case 'r': return M | LL;
+        case 'S': return M | LR | T | UL | B;
+        case 'T': case 't': return M | UL | LL | B;
+        case 'U': return LR | UR | UL | LL | B;
+        case 'u': return LR | LL | B;
+        case 'V': case 'v': return LR | UR | UL | LL | B;  // Same as U and W
+        case 'W': case 'w': return LR | UR | UL | LL | B;
+        case 'X': case 'x': return M | LR | UR | UL | LL;
+        case 'Y': case 'y': return M | LR | UR | UL | B;
+        case 'Z': case 'z': return M | UR | T | LL | B;
+
+        // Symbols
+        case '-': return M;
+        case '_': return B;
+        case '=': return M | B;
+        case '\'': return UR;
+        case '"': return UR | UL;
+        case '[': return T | UL | LL | B;
+        case ']': return LR | UR | T | B;
+        case '?': return M | UR | T | LL;
+        case '*': return M | UR | T | UL;     // Degree sign
+
+        default:
+            // Remaining lower case letters use the upper case glyph
+            if (c >= 'a' && c <= 'z') {
+                return glyphFor((char)(c - 'a' + 'A'));
+            }
+            return 0;   // Blank
+    }
+}
+
+static constexpr std::array<uint8_t, 128> buildGlyphTable() {
+    std::array<uint8_t, 128> table = {};
+    for (int c = 0; c < 128; c++) {
+        table[c] = glyphFor((char)c);
+    }
+    return table;
+}
+
+// Precomputed ASCII -> glyph table (built by the compiler, no runtime cost)
+constexpr std::array<uint8_t, 128> SEGMENT_GLYPHS = buildGlyphTable();
 
 // =============================================================================
 // MAIN LED CONTROLLER DISPLAY CLASS IMPLEMENTATION
@@ -34,6 +103,7 @@ const uint8_t DIGIT_PATTERNS[11][7] = {
 
 /*
 * Set the display number (1-99)
+* Becomes the base content, shown whenever no marquee is running
 *
 * @param number: Number to display (1-99)
 */
@@ -46,9 +116,42 @@ void DisplayController::setDisplayNumber(int number) {
     int left_digit = (number >= 10) ? (number / 10) : 10; // 10 = blank index
     int right_digit = number % 10;
     
-    // Step 3: Set each display
-    setDisplaySegment(1, left_digit);  // Left display
-    setDisplaySegment(2, right_digit); // Right display
+    // Step 3: Store as base content
+    base_glyphs[0] = (left_digit == 10) ? 0 : SEGMENT_GLYPHS['0' + left_digit];
+    base_glyphs[1] = SEGMENT_GLYPHS['0' + right_digit];
+
+    // Step 4: Show both digits in one report (unless covered by marquee/overlay)
+    render();
+}
+
+/*
+* Set the display to (up to) two characters of text, e.g. "Er", "bP"
+* Becomes the base content, shown whenever no marquee is running
+*
+* @param text: Text to display, missing characters are blank
+*/
+void DisplayController::setDisplayText(const char* text) {
+    // Step 1: Look up glyphs (stop at end of string)
+    base_glyphs[0] = 0;
+    base_glyphs[1] = 0;
+    if (text != nullptr && text[0] != '\0') {
+        base_glyphs[0] = getGlyph(text[0]);
+        base_glyphs[1] = getGlyph(text[1]);
+    }
+
+    // Step 2: Show both characters in one report (unless covered by marquee/overlay)
+    render();
+}
+
+/*
+* Get the 7-segment glyph for a character
+*
+* @param character: ASCII character
+* @return: Glyph bit mask (0 = blank)
+*/
+uint8_t DisplayController::getGlyph(char character) {
+    unsigned char index = (unsigned char)character;
+    return (index < 128) ? SEGMENT_GLYPHS[index] : 0;
 }
 
 /*
@@ -59,67 +162,233 @@ void DisplayController::setDisplayNumber(int number) {
 */
 
 void DisplayController::setDisplayDot(int display, bool on) {
-    // Step 1: Access the external led_buffer and device from led_controller
-    extern unsigned char led_buffer[81];
-    extern hid_device* current_device;
-    
-    // Step 2: Set brightness based on on/off state
+    // Step 1: Set brightness based on on/off state
     uint8_t brightness = on ? 127 : 0;
     
-    // Step 3: Set the appropriate dot byte
-    if (display == 1) {
-        // Left display dot (byte 9)
-        led_buffer[9] = brightness;
-    } else if (display == 2) {
-        // Right display dot (byte 1) 
-        led_buffer[1] = brightness;
+    // Step 2: Set the dot byte of the digit (left = byte 9, right = byte 1)
+    if (display == 1 || display == 2) {
+        getLEDBuffer()[F1_DESCRIPTOR.digits[display - 1].dot_byte] = brightness;
+    }
+
+    // Step 3: Send updated buffer to device (or defer until the LED frame ends)
+    commitLEDBuffer();
+}
+
+// =============================================================================
+// MARQUEE - Scroll text across both digits
+// =============================================================================
+
+/*
+* Start scrolling a text across the two digits
+* The text enters from the right and leaves on the left. Scrolling is advanced
+* by tick(), so nothing blocks. When a non-looping marquee ends, the base
+* content (page number or text) is shown again.
+*
+* @param text: Text to scroll (longer texts are cut to MAX_MARQUEE_LENGTH)
+* @param now_ms: Current time in milliseconds
+* @param step_ms: Time per scroll step
+* @param loop: true to repeat until stopMarquee() is called
+*/
+void DisplayController::startMarquee(const char* text, uint64_t now_ms, int step_ms, bool loop) {
+    // Step 1: Validate input
+    if (text == nullptr || text[0] == '\0') {
+        stopMarquee();
+        return;
+    }
+
+    // Step 2: Copy text (fixed buffer, no allocation)
+    marquee_length = 0;
+    while (text[marquee_length] != '\0' && marquee_length < MAX_MARQUEE_LENGTH) {
+        marquee_text[marquee_length] = text[marquee_length];
+        marquee_length++;
+    }
+    marquee_text[marquee_length] = '\0';
+
+    // Step 3: Reset scroll state and show first step
+    marquee_step_ms = (step_ms > 0) ? step_ms : DEFAULT_MARQUEE_STEP_MS;
+    marquee_loop = loop;
+    marquee_position = 0;
+    marquee_active = true;
+    renderMarqueeStep();
+    render();
+    marquee_next_step_ms = now_ms + marquee_step_ms;
+}
+
+/*
+* Stop the marquee and show the base content again
+*/
+void DisplayController::stopMarquee() {
+    marquee_active = false;
+    render();
+}
+
+bool DisplayController::isMarqueeActive() const {
+    return marquee_active;
+}
+
+/*
+* Advance display animations and expire overlays
+* Call this once per main loop tick, also when no input report arrived
+*
+* @param now_ms: Current time in milliseconds
+*/
+void DisplayController::tick(uint64_t now_ms) {
+    // Step 1: Remove expired overlays (keep stack order)
+    int kept = 0;
+    for (int i = 0; i < overlay_count; i++) {
+        if (now_ms < overlays[i].expiry_ms) {
+            overlays[kept++] = overlays[i];
+        }
+    }
+    if (kept != overlay_count) {
+        overlay_count = kept;
+        render();
     }
 
-    // Step 4: Send updated buffer to device
-    if (current_device != nullptr) {
-        hid_write(current_device, led_buffer, 81);
+    // Step 2: Nothing more to do without a marquee or before the next step
+    if (!marquee_active || now_ms < marquee_next_step_ms) {
+        return;
     }
+
+    // Step 3: Advance one step
+    // Scroll steps: text enters on the right (step 0) until the last character left the left digit
+    int total_steps = marquee_length + 2;
+    marquee_position++;
+    if (marquee_position >= total_steps) {
+        if (!marquee_loop) {
+            stopMarquee();
+            return;
+        }
+        marquee_position = 0;
+    }
+
+    // Step 4: Show new window and schedule next step
+    renderMarqueeStep();
+    render();
+    marquee_next_step_ms = now_ms + marquee_step_ms;
 }
 
+/*
+* Computes the two characters visible at the current scroll position
+* Position p shows text[p-1] on the left and text[p] on the right
+*/
+void DisplayController::renderMarqueeStep() {
+    int left_index = marquee_position - 1;
+    int right_index = marquee_position;
+
+    marquee_glyphs[0] = (left_index >= 0 && left_index < marquee_length) ? getGlyph(marquee_text[left_index]) : 0;
+    marquee_glyphs[1] = (right_index < marquee_length) ? getGlyph(marquee_text[right_index]) : 0;
+}
+
+// =============================================================================
+// VALUE OVERLAY - Show knob/fader values for a moment
+// =============================================================================
 
 /*
-* Private helper function to set display segments
+* Show a value (00-99) on top of everything else until timeout_ms passed
+* without a new value from the same source. A source that is already on the
+* stack is updated and moved to the top, so the last moved control is shown.
 *
-* @param display: 1 for left, 2 for right  
-* @param digit: Digit to display (0-9, or 10 for blank)
+* @param source_id: Which control the value belongs to (e.g. OVERLAY_SOURCE_KNOB_BASE + knob)
+* @param value: Value to show, clamped to 0-99
+* @param now_ms: Current time in milliseconds
+* @param timeout_ms: Time until the overlay disappears
 */
-void DisplayController::setDisplaySegment(int display, int digit) {
-    // Step 1: Validate inputs
-    if (digit < 0 || digit > 10) {
-        std::cout << "Error: Invalid digit in setDisplaySegment()" << std::endl;
-        return; // Invalid digit
+void DisplayController::showValueOverlay(int source_id, int value, uint64_t now_ms, int timeout_ms) {
+    // Step 1: Clamp value
+    if (value < 0) value = 0;
+    if (value > 99) value = 99;
+
+    // Step 2: Remove existing entry of this source (keep stack order)
+    int kept = 0;
+    for (int i = 0; i < overlay_count; i++) {
+        if (overlays[i].source_id != source_id) {
+            overlays[kept++] = overlays[i];
+        }
+    }
+    overlay_count = kept;
+
+    // Step 3: Drop the oldest entry if the stack is full
+    if (overlay_count == MAX_DISPLAY_OVERLAYS) {
+        for (int i = 1; i < overlay_count; i++) {
+            overlays[i - 1] = overlays[i];
+        }
+        overlay_count--;
     }
 
-    // Step 2: Access the external led_buffer and device from led_controller
-    extern unsigned char led_buffer[81];
-    extern hid_device* current_device;
-
-    // Step 3: Calculate byte positions
-    int base_byte;
-    if (display == 1) {
-        // Left display: bytes 10-16 (skip dot at byte 9)
-        base_byte = 10;
-    } else if (display == 2) {
-        // Right display: bytes 2-8 (skip dot at byte 1)
-        base_byte = 2;
+    // Step 4: Push on top and show
+    overlays[overlay_count++] = {source_id, (uint8_t)value, now_ms + (uint64_t)timeout_ms};
+    render();
+}
+
+/*
+* Remove all overlays and show marquee/base content again
+*/
+void DisplayController::clearOverlays() {
+    overlay_count = 0;
+    render();
+}
+
+bool DisplayController::hasOverlay() const {
+    return overlay_count > 0;
+}
+
+/*
+* Shows the top display layer
+* Overlay (with leading zero, e.g. "07") > marquee > base content
+* showGlyphs() skips the LED buffer if nothing changed
+*/
+void DisplayController::render() {
+    if (overlay_count > 0) {
+        uint8_t value = overlays[overlay_count - 1].value;
+        showGlyphs(SEGMENT_GLYPHS['0' + value / 10], SEGMENT_GLYPHS['0' + value % 10]);
+    } else if (marquee_active) {
+        showGlyphs(marquee_glyphs[0], marquee_glyphs[1]);
     } else {
-         std::cout << "Error: Invalid display number in setDisplaySegment()" << std::endl;
-        return; // Invalid display
+        showGlyphs(base_glyphs[0], base_glyphs[1]);
     }
-    
-    // Step 4: Set 7 segments using the digit patterns
-    // Pattern order: [middle, lower_right, upper_right, top, upper_left, lower_left, bottom]
-    for (int i = 0; i < 7; i++) {
-        led_buffer[base_byte + i] = DIGIT_PATTERNS[digit][i];
+}
+
+// =============================================================================
+// PRIVATE HELPERS - Write glyphs into the LED buffer
+// =============================================================================
+
+/*
+* Show two glyphs, only touching the LED buffer if they changed
+* Both digits are written before one commit, so this costs at most one report
+*/
+void DisplayController::showGlyphs(uint8_t left, uint8_t right) {
+    // Step 1: Skip if the display already shows these glyphs
+    if (shown_valid && shown_glyphs[0] == left && shown_glyphs[1] == right) {
+        return;
     }
 
-    // Step 5: Send updated buffer to device
-    if (current_device != nullptr) {
-        hid_write(current_device, led_buffer, 81);
+    // Step 2: Write both digits into the LED buffer
+    writeGlyph(1, left);
+    writeGlyph(2, right);
+    shown_glyphs[0] = left;
+    shown_glyphs[1] = right;
+    shown_valid = true;
+
+    // Step 3: Send updated buffer to device (or defer until the LED frame ends)
+    commitLEDBuffer();
+}
+
+/*
+* Write one glyph into the LED buffer (no report is sent)
+*
+* @param display: 1 for left, 2 for right
+* @param glyph: Glyph bit mask
+*/
+void DisplayController::writeGlyph(int display, uint8_t glyph) {
+    // Step 1: First segment byte of the digit (left = bytes 10-16, right = bytes 2-8)
+    int base_byte = F1_DESCRIPTOR.digits[(display == 1) ? 0 : 1].segment_byte;
+
+    // Step 2: Set 7 segments from the glyph bits
+    // Bit order: [middle, lower_right, upper_right, top, upper_left, lower_left, bottom]
+    unsigned char* led_buffer = getLEDBuffer();
+    for (int i = 0; i < 7; i++) {
+        led_buffer[base_byte + i] = (glyph & (1 << i)) ? 127 : 0;
     }
-}
\ No newline at end of file
+}
+
@@ -1,37 +1,36 @@
 #include "headers/led_controller_toggle.h"  // Include header file
 #include "headers/input_reader.h"           // Include input reader header
 #include "headers/led_controller.h"         // Access to LED controller functions and state structures
+#include "headers/trace_recorder.h"         // For traceInstant (button edges)
+#include "headers/control_layout.h"         // For CONTROL_LAYOUT (input byte and bit per button)
 
 #include <iostream>  // For console output
+#include <bit>       // For std::countr_zero
 
 // =============================================================================
 // Update button states based on input report
 // =============================================================================
-void ButtonToggleSystem::updateButtonStates(unsigned char* input_report) {
-    // Update special button states
-    special_was_pressed[0] = isSpecialButtonPressed(input_report, SpecialButton::BROWSE);
-    special_was_pressed[1] = isSpecialButtonPressed(input_report, SpecialButton::SIZE);
-    special_was_pressed[2] = isSpecialButtonPressed(input_report, SpecialButton::TYPE);
-    special_was_pressed[3] = isSpecialButtonPressed(input_report, SpecialButton::REVERSE);
-    special_was_pressed[4] = isSpecialButtonPressed(input_report, SpecialButton::SHIFT);
-
-    // Update control button states
-    control_was_pressed[0] = isControlButtonPressed(input_report, ControlButton::CAPTURE);
-    control_was_pressed[1] = isControlButtonPressed(input_report, ControlButton::QUANT);
-    control_was_pressed[2] = isControlButtonPressed(input_report, ControlButton::SYNC);
-
-    // Update stop button states
-    stop_was_pressed[0] = isStopButtonPressed(input_report, StopButton::STOP1);
-    stop_was_pressed[1] = isStopButtonPressed(input_report, StopButton::STOP2);
-    stop_was_pressed[2] = isStopButtonPressed(input_report, StopButton::STOP3);
-    stop_was_pressed[3] = isStopButtonPressed(input_report, StopButton::STOP4);
-
-    // Update matrix button states
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 1; col <= 4; col++) {
-            matrix_was_pressed[row][col] = isMatrixButtonPressed(input_report, row, col);
-        }
+
+/*
+* Builds a mask of all currently pressed toggleable buttons
+* Uses the same bit layout as toggled_mask, so edge detection is plain bit math
+* One pass over CONTROL_LAYOUT (matrix, special, control, stop), no branches
+*
+* @param input_report: The 22-byte input report from readInputReport()
+* @return: Mask with one bit set per pressed button
+*/
+uint32_t ButtonToggleSystem::getPressedButtonMask(const unsigned char* input_report) {
+    uint32_t pressed_mask = 0;
+    for (int bit = 0; bit < TOGGLE_BIT_COUNT; bit++) {
+        const ControlLayout& layout = CONTROL_LAYOUT[bit];
+        pressed_mask |= (uint32_t)((input_report[layout.input_byte] & layout.input_mask) != 0) << bit;
     }
+    return pressed_mask;
+}
+
+void ButtonToggleSystem::updateButtonStates(unsigned char* input_report) {
+    // Store all pressed buttons for edge detection in the next frame
+    was_pressed_mask = getPressedButtonMask(input_report);
 }
 
 // =============================================================================
@@ -48,11 +47,17 @@ void ButtonToggleSystem::updateButtonStates(unsigned char* input_report) {
 bool ButtonToggleSystem::initialize() {
     std::cout << "Initializing Button Toggle System..." << std::endl;
 
-    // Set default matrix toggle mode
-    current_matrix_mode = MatrixToggleZone::FULL_MATRIX;
-
     // Reset all led toggle states to false
-    resetAllToggleStates();    
+    toggled_mask = 0;
+    was_pressed_mask = 0;
+    one_shot_mask = 0;
+    current_time_ms = 0;
+
+    // Set default behaviors (matrix = RADIO, all others = LATCH)
+    resetButtonBehaviors();
+
+    // Set default matrix toggle mode
+    setMatrixToggleMode(MatrixToggleZone::FULL_MATRIX);
 
     // Output initialization status
     std::cout << "  - All toggle states reset to original" << std::endl;
@@ -65,50 +70,17 @@ bool ButtonToggleSystem::initialize() {
 * This means all buttons return to their scene colors/brightness
 */
 void ButtonToggleSystem::resetAllToggleStates() {
-    // ________________________________________
     // Reset button press tracking states
-        // SPECIAL BUTTONS
-        for (int i = 0; i < 5; i++) {
-            special_was_pressed[i] = false;
-        }
-        // CONTROL BUTTONS
-        for (int i = 0; i < 3; i++) {
-            control_was_pressed[i] = false;
-        }
-        // STOP BUTTONS
-        for (int i = 0; i < 4; i++) {
-            stop_was_pressed[i] = false;
-        }
-        // MATRIX BUTTONS
-        for (int row = 1; row <= 4; row++) {
-            for (int col = 1; col <= 4; col++) {
-                matrix_was_pressed[row][col] = false;
-            }
-        }
+    was_pressed_mask = 0;
 
-    // ________________________________________
     // Reset all toggle states to false (original state)
-        
-        // SPECIAL BUTTONS
-        for (int i = 0; i < 5; i++) {
-            special_toggled[i] = false;
-        }
+    toggled_mask = 0;
 
-        // CONTROL BUTTONS
-        for (int i = 0; i < 3; i++) {
-            control_toggled[i] = false;
-        }
-
-        // STOP BUTTONS
-        for (int i = 0; i < 4; i++) {
-            stop_toggled[i] = false;
-        }
-        // MATRIX BUTTONS
-        for (int row = 1; row <= 4; row++) {
-            for (int col = 1; col <= 4; col++) {
-                matrix_toggled[row][col] = false;
-            }
-        }
+    // Reset behavior states
+    one_shot_mask = 0;
+    for (int bit = 0; bit < TOGGLE_BIT_COUNT; bit++) {
+        cycle_step[bit] = 0;
+    }
 }
 
 // =============================================================================
@@ -129,24 +101,24 @@ bool ButtonToggleSystem::toggleSpecialButton(SpecialLEDButton button) {
         std::cerr << "Error: Invalid special button in toggleSpecialButton()" << std::endl;
         return false;
     }
+    uint32_t bit = 1u << (TOGGLE_BIT_SPECIAL_START + index);
 
     // Step 2: Check current toggle state and act accordingly
 
     // Currently original → toggle to full brightness
-    if (special_toggled[index] == false) {
+    if ((toggled_mask & bit) == 0) {
         // Set to full brightness, DONT overwrite original state!
         setSpecialButtonLED(button, TOGGLED_BRIGHTNESS, false);
-        // Update toggle state
-        special_toggled[index] = true;
-    } else if (special_toggled[index] == true) { // Currently toggled → return to original brightness
+    } else { // Currently toggled → return to original brightness
         // Get original state
         LEDState original = getSpecialButtonState(button);
         // Set to original brightness, DONT overwrite original state!
         setSpecialButtonLED(button, original.brightness, false);
-        // Update toggle state
-        special_toggled[index] = false;
     }
 
+    // Step 3: Flip toggle state
+    toggled_mask ^= bit;
+
     return true;
 }
 
@@ -164,24 +136,24 @@ bool ButtonToggleSystem::toggleControlButton(ControlLEDButton button) {
         std::cerr << "Error: Invalid control button in toggleControlButton()" << std::endl;
         return false;
     }
+    uint32_t bit = 1u << (TOGGLE_BIT_CONTROL_START + index);
 
     // Step 2: Check current toggle state and act accordingly
 
     // Currently original → toggle to full brightness
-    if (control_toggled[index] == false) {
+    if ((toggled_mask & bit) == 0) {
         // Set to full brightness, DONT overwrite original state!
         setControlButtonLED(button, TOGGLED_BRIGHTNESS, false);
-        // Update toggle state
-        control_toggled[index] = true;
-    } else if (control_toggled[index] == true) { // Currently toggled → return to original brightness
+    } else { // Currently toggled → return to original brightness
         // Get original state
         LEDState original = getControlButtonState(button);
         // Set to original brightness, DONT overwrite original state!
         setControlButtonLED(button, original.brightness, false);
-        // Update toggle state
-        control_toggled[index] = false;
     }
 
+    // Step 3: Flip toggle state
+    toggled_mask ^= bit;
+
     return true;
 }
 
@@ -199,24 +171,24 @@ bool ButtonToggleSystem::toggleStopButton(StopLEDButton button) {
         std::cerr << "Error: Invalid stop button in toggleStopButton()" << std::endl;
         return false;
     }
+    uint32_t bit = 1u << (TOGGLE_BIT_STOP_START + index);
 
     // Step 2: Check current toggle state and act accordingly
 
     // Currently original → toggle to full brightness
-    if (stop_toggled[index] == false) {
+    if ((toggled_mask & bit) == 0) {
         // Set to full brightness, DONT overwrite original state!
         setStopButtonLED(button, TOGGLED_BRIGHTNESS, false);
-        // Update toggle state
-        stop_toggled[index] = true;
-    } else if (stop_toggled[index] == true) { // Currently toggled → return to original brightness
+    } else { // Currently toggled → return to original brightness
         // Get original state
         LEDState original = getStopButtonState(button);
         // Set to original brightness, DONT overwrite original state!
         setStopButtonLED(button, original.brightness, false);
-        // Update toggle state
-        stop_toggled[index] = false;
     }
 
+    // Step 3: Flip toggle state
+    toggled_mask ^= bit;
+
     return true;
 }
 
@@ -225,37 +197,28 @@ bool ButtonToggleSystem::toggleStopButton(StopLEDButton button) {
 * Preserves the original brightness value using the LED controller's state storage
 * NOTE: This function only handles the actual toggle - zone management is done in shouldToggleMatrixButton()
 *
-* @param row: The row of the matrix button (1-4)
-* @param col: The column of the matrix button (1-4)
-* @return: true if successful, false if error
+* @param pad: The matrix button (always valid, see MatrixPad)
+* @return: true
 */
-bool ButtonToggleSystem::toggleMatrixButton(int row, int col) {
-    // Step 1: Validate row and column ranges
-    if (row < 1 || row > 4 || col < 1 || col > 4) {
-        std::cerr << "Error: Invalid matrix position (" << row << "," << col 
-                  << "). Must be 1-4 for both row and column." << std::endl;
-        return false;
-    }
+bool ButtonToggleSystem::toggleMatrixButton(MatrixPad pad) {
+    // Step 1: Bit of the button
+    uint32_t bit = 1u << getMatrixButtonBit(pad);
 
     // Step 2: Check current toggle state and act accordingly
+    LEDStateMatrix original = getMatrixButtonState(pad);
 
     // Currently original → toggle to full brightness
-    if (matrix_toggled[row][col] == false) {
-        // Get original state
-        LEDStateMatrix original = getMatrixButtonState(row, col);
+    if ((toggled_mask & bit) == 0) {
         // Set to full brightness, DONT overwrite original state!
-        setMatrixButtonLED(row, col, original.color, TOGGLED_BRIGHTNESS, false);
-        // Update toggle state
-        matrix_toggled[row][col] = true;
-    } else if (matrix_toggled[row][col] == true) { // Currently toggled → return to original brightness
-        // Get original state
-        LEDStateMatrix original = getMatrixButtonState(row, col);
+        setMatrixButtonLED(pad, original.color, TOGGLED_BRIGHTNESS, false);
+    } else { // Currently toggled → return to original brightness
         // Set to original brightness, DONT overwrite original state!
-        setMatrixButtonLED(row, col, original.color, original.brightness, false);
-        // Update toggle state
-        matrix_toggled[row][col] = false;
+        setMatrixButtonLED(pad, original.color, original.brightness, false);
     }
 
+    // Step 3: Flip toggle state
+    toggled_mask ^= bit;
+
     return true;
 }
 
@@ -278,13 +241,15 @@ bool ButtonToggleSystem::shouldToggleSpecialButton(unsigned char* input_data, Sp
     }
 
     // Step 2: Check current and previous button states
+    int bit = TOGGLE_BIT_SPECIAL_START + index;
     bool currently_pressed = isSpecialButtonPressed(input_data, button);
-    bool was_pressed = special_was_pressed[index];
+    bool was_pressed = (was_pressed_mask >> bit) & 1u;
     
-    // Step 3: Only trigger on press transition (false -> true)
-    // Call toggle function if pressed and was not pressed
-    if (currently_pressed && !was_pressed) {
-        return toggleSpecialButton(led_button);
+    // Step 3: Only trigger on press or release transition
+    // Press/release is handled by the button's behavior (LATCH by default)
+    if (currently_pressed != was_pressed) {
+        dispatchButtonEdge(bit, currently_pressed);
+        return currently_pressed;
     }
     
     return false;
@@ -299,13 +264,15 @@ bool ButtonToggleSystem::shouldToggleControlButton(unsigned char* input_data, Co
     }
 
     // Step 2: Check current and previous button states
+    int bit = TOGGLE_BIT_CONTROL_START + index;
     bool currently_pressed = isControlButtonPressed(input_data, button);
-    bool was_pressed = control_was_pressed[index];
+    bool was_pressed = (was_pressed_mask >> bit) & 1u;
     
-    // Step 3: Only trigger on press transition (false -> true)
-    // Call toggle function if pressed and was not pressed
-    if (currently_pressed && !was_pressed) {
-        return toggleControlButton(led_button);
+    // Step 3: Only trigger on press or release transition
+    // Press/release is handled by the button's behavior (LATCH by default)
+    if (currently_pressed != was_pressed) {
+        dispatchButtonEdge(bit, currently_pressed);
+        return currently_pressed;
     }
     
     return false;
@@ -320,13 +287,15 @@ bool ButtonToggleSystem::shouldToggleStopButton(unsigned char* input_data, StopB
     }
 
     // Step 2: Check current and previous button states
+    int bit = TOGGLE_BIT_STOP_START + index;
     bool currently_pressed = isStopButtonPressed(input_data, button);
-    bool was_pressed = stop_was_pressed[index];
+    bool was_pressed = (was_pressed_mask >> bit) & 1u;
     
-    // Step 3: Only trigger on press transition (false -> true)
-    // Call toggle function if pressed and was not pressed
-    if (currently_pressed && !was_pressed) {
-        return toggleStopButton(led_button);
+    // Step 3: Only trigger on press or release transition
+    // Press/release is handled by the button's behavior (LATCH by default)
+    if (currently_pressed != was_pressed) {
+        dispatchButtonEdge(bit, currently_pressed);
+        return currently_pressed;
     }
     
     return false;
@@ -338,62 +307,200 @@ bool ButtonToggleSystem::shouldToggleStopButton(unsigned char* input_data, StopB
 
 /*
 * Enhanced matrix button toggle with automatic zone-based untoggling
-* This is the main function that implements the "untoggle" behavior
+* The press is handled by the button's behavior, RADIO implements the "untoggle" behavior
 *
 * @param input_data: Current input report
-* @param row: Matrix button row (1-4)  
-* @param col: Matrix button column (1-4)
+* @param pad: Matrix button (always valid, see MatrixPad)
 * @return: true if toggle action was performed, false otherwise
 */
-bool ButtonToggleSystem::shouldToggleMatrixButton(unsigned char* input_data, int row, int col) {
-    // Step 1: Validate matrix position
-    if (row < 1 || row > 4 || col < 1 || col > 4) {
-        std::cerr << "Error: Invalid matrix position (" << row << "," << col << ") in shouldToggleMatrixButton()" << std::endl;
-        return false;
-    }
+bool ButtonToggleSystem::shouldToggleMatrixButton(unsigned char* input_data, MatrixPad pad) {
+    // Step 1: Bit of the button
+    uint32_t bit = 1u << getMatrixButtonBit(pad);
 
     // Step 2: Check current and previous button states
-    bool currently_pressed = isMatrixButtonPressed(input_data, row, col);
-    bool was_pressed = matrix_was_pressed[row][col];
-
-    // Step 3: Only trigger on press transition (false -> true)
-    if (currently_pressed && !was_pressed) {
-
-        // Step 4: Check if this button is already toggled
-        if (matrix_toggled[row][col] == true) {
-            // Button is already toggled - just untoggle it directly
-            return toggleMatrixButton(row, col);
-        } else {
-            // Button is not toggled - untoggle others in zone, then toggle this one
-            
-            // Step 5: Determine which zone this button belongs to
-            int target_zone = getButtonZone(row, col);
-            
-            // Step 6: Auto-untoggle all other buttons in the same zone
-            untoggleMatrixZone(target_zone);
-            
-            // Step 7: Toggle the pressed button
-            return toggleMatrixButton(row, col);
-        }
+    bool currently_pressed = isMatrixButtonPressed(input_data, pad);
+    bool was_pressed = (was_pressed_mask & bit) != 0;
+
+    // Step 3: Only trigger on press or release transition
+    // Zone-based untoggling is done by the RADIO behavior (default for matrix buttons)
+    if (currently_pressed != was_pressed) {
+        dispatchButtonEdge(getMatrixButtonBit(pad), currently_pressed);
+        return currently_pressed;
     }
 
     return false;
 }
 
+// =============================================================================
+// MATRIX ZONE MAPS - Compile layout grids into lookup table + zone masks
+// =============================================================================
+
+/*
+* Predefined zone layouts, indexed [row-1][col-1]
+* Same id = same zone, MATRIX_ZONE_FREE = button toggles on its own
+*/
+static const int LAYOUT_FULL_MATRIX[4][4] = {
+    {0, 0, 0, 0},
+    {0, 0, 0, 0},
+    {0, 0, 0, 0},
+    {0, 0, 0, 0}
+};
+
+static const int LAYOUT_LEFT_RIGHT_SPLIT[4][4] = {
+    {0, 0, 1, 1},
+    {0, 0, 1, 1},
+    {0, 0, 1, 1},
+    {0, 0, 1, 1}
+};
+
+static const int LAYOUT_ROWS[4][4] = {
+    {0, 0, 0, 0},
+    {1, 1, 1, 1},
+    {2, 2, 2, 2},
+    {3, 3, 3, 3}
+};
+
+static const int LAYOUT_COLUMNS[4][4] = {
+    {0, 1, 2, 3},
+    {0, 1, 2, 3},
+    {0, 1, 2, 3},
+    {0, 1, 2, 3}
+};
+
+static const int LAYOUT_QUADRANTS[4][4] = {
+    {0, 0, 1, 1},
+    {0, 0, 1, 1},
+    {2, 2, 3, 3},
+    {2, 2, 3, 3}
+};
+
+static const int LAYOUT_FREE[4][4] = {
+    {MATRIX_ZONE_FREE, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE},
+    {MATRIX_ZONE_FREE, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE},
+    {MATRIX_ZONE_FREE, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE},
+    {MATRIX_ZONE_FREE, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE}
+};
+
+/*
+* Compiles a 4x4 zone layout into a zone map
+* Zone ids in the layout may be any value 0-15 and do not need to be contiguous,
+* they are renumbered in order of first appearance. Every MATRIX_ZONE_FREE button
+* gets a zone of its own, so pressing it never untoggles anything else.
+*
+* @param layout: 4x4 grid of zone ids, indexed [row-1][col-1]
+* @param zone_map: Output zone map
+* @return: true if successful, false if a zone id is invalid
+*/
+bool compileMatrixZoneMap(const int layout[4][4], MatrixZoneMap& zone_map) {
+    // Step 1: Track which compiled zone each layout id was assigned to
+    int zone_for_id[MAX_MATRIX_ZONES];
+    for (int i = 0; i < MAX_MATRIX_ZONES; i++) {
+        zone_for_id[i] = -1;
+    }
+
+    MatrixZoneMap result = {};
+
+    // Step 2: Assign every button to a zone
+    for (int row = 1; row <= 4; row++) {
+        for (int col = 1; col <= 4; col++) {
+            int index = (row - 1) * 4 + (col - 1);
+            int id = layout[row - 1][col - 1];
+            int zone;
+
+            if (id == MATRIX_ZONE_FREE) {
+                // Free pad: always a new zone
+                zone = result.zone_count++;
+            } else if (id >= 0 && id < MAX_MATRIX_ZONES) {
+                // Shared zone: reuse or create
+                if (zone_for_id[id] < 0) {
+                    zone_for_id[id] = result.zone_count++;
+                }
+                zone = zone_for_id[id];
+            } else {
+                std::cerr << "Error: Invalid zone id " << id << " at matrix position ("
+                          << row << "," << col << ") in compileMatrixZoneMap()" << std::endl;
+                return false;
+            }
+
+            // Step 3: Store lookup entry and add button to zone mask
+            result.button_zone[index] = (uint8_t)zone;
+            result.zone_masks[zone] |= 1u << (TOGGLE_BIT_MATRIX_START + index);
+        }
+    }
+
+    zone_map = result;
+    return true;
+}
+
+/*
+* Gets the compiled zone map for a predefined toggle mode
+*
+* @param mode: Predefined mode (CUSTOM falls back to FULL_MATRIX)
+* @return: Compiled zone map
+*/
+MatrixZoneMap getPresetMatrixZoneMap(MatrixToggleZone mode) {
+    const int (*layout)[4] = LAYOUT_FULL_MATRIX;
+
+    switch (mode) {
+        case MatrixToggleZone::FULL_MATRIX:      layout = LAYOUT_FULL_MATRIX; break;
+        case MatrixToggleZone::LEFT_RIGHT_SPLIT: layout = LAYOUT_LEFT_RIGHT_SPLIT; break;
+        case MatrixToggleZone::ROWS:             layout = LAYOUT_ROWS; break;
+        case MatrixToggleZone::COLUMNS:          layout = LAYOUT_COLUMNS; break;
+        case MatrixToggleZone::QUADRANTS:        layout = LAYOUT_QUADRANTS; break;
+        case MatrixToggleZone::FREE:             layout = LAYOUT_FREE; break;
+        case MatrixToggleZone::CUSTOM:           layout = LAYOUT_FULL_MATRIX; break;
+    }
+
+    MatrixZoneMap zone_map;
+    compileMatrixZoneMap(layout, zone_map);
+    return zone_map;
+}
+
 // =============================================================================
 // NEW ZONE MANAGEMENT FUNCTIONS
 // =============================================================================
 
 /*
-* Sets the matrix toggle mode (FULL_MATRIX or LEFT_RIGHT_SPLIT)
+* Sets the matrix toggle mode to one of the predefined layouts
+* CUSTOM has no preset layout - use setMatrixZoneLayout() or setMatrixZoneMap()
 * 
 * @param mode: The desired toggle zone mode
 */
 void ButtonToggleSystem::setMatrixToggleMode(MatrixToggleZone mode) {
-    current_matrix_mode = mode;
-    
+    if (mode == MatrixToggleZone::CUSTOM) {
+        std::cerr << "Error: CUSTOM needs a layout, use setMatrixZoneLayout() (zone mode unchanged)" << std::endl;
+        return;
+    }
+    setMatrixZoneMap(getPresetMatrixZoneMap(mode), mode);
+}
+
+/*
+* Sets a user-defined matrix zone layout
+*
+* @param layout: 4x4 grid of zone ids, indexed [row-1][col-1]
+* @return: true if the layout was valid and applied, false otherwise
+*/
+bool ButtonToggleSystem::setMatrixZoneLayout(const int layout[4][4]) {
+    MatrixZoneMap map;
+    if (!compileMatrixZoneMap(layout, map)) {
+        return false;
+    }
+    setMatrixZoneMap(map, MatrixToggleZone::CUSTOM);
+    return true;
+}
+
+/*
+* Sets an already compiled zone map
+*
+* @param map: Compiled zone map
+* @param mode: Mode reported by getMatrixToggleMode() (default CUSTOM)
+*/
+void ButtonToggleSystem::setMatrixZoneMap(const MatrixZoneMap& map, MatrixToggleZone mode) {
     // Clear all matrix toggles when changing modes to avoid confusion
     untoggleAllMatrixButtons();
+
+    zone_map = map;
+    current_matrix_mode = mode;
 }
 
 /*
@@ -408,59 +515,33 @@ MatrixToggleZone ButtonToggleSystem::getMatrixToggleMode() const {
 /*
 * Determines which zone a matrix button belongs to based on current mode
 * 
-* @param row: Matrix button row (1-4)
-* @param col: Matrix button column (1-4)  
-* @return: Zone ID (0 for full matrix, 0/1 for left/right split)
+* @param pad: Matrix button (always valid, see MatrixPad)
+* @return: Zone ID (0 to zone_count-1)
 */
-int ButtonToggleSystem::getButtonZone(int row, int col) const {
-    // Validate input
-    if (row < 1 || row > 4 || col < 1 || col > 4) {
-        std::cerr << "Error: Invalid matrix position in getButtonZone()" << std::endl;
-        return -1; // Invalid zone
-    }
-    
-    switch (current_matrix_mode) {
-        case MatrixToggleZone::FULL_MATRIX:
-            return 0; // All buttons in same zone
-            
-        case MatrixToggleZone::LEFT_RIGHT_SPLIT:
-            if (col <= 2) {
-                return 0; // Left zone (columns 1-2)
-            } else {
-                return 1; // Right zone (columns 3-4)  
-            }
-            
-        default:
-            std::cerr << "Error: Unknown matrix toggle mode" << std::endl;
-            return -1;
-    }
+int ButtonToggleSystem::getButtonZone(MatrixPad pad) const {
+    // Direct lookup in the compiled zone map
+    return zone_map.button_zone[pad.index()];
 }
 
 /*
 * Untoggle all buttons in a specific zone
+* The toggle state is cleared with a single AND-NOT on the zone mask,
+* only the buttons that were actually toggled get their LED restored
 * 
-* @param zone_id: Zone to clear (0 for left/full, 1 for right)
+* @param zone_id: Zone to clear (from getButtonZone())
 */
 void ButtonToggleSystem::untoggleMatrixZone(int zone_id) {
-    // Iterate through all matrix buttons
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 1; col <= 4; col++) {
-            
-            // Check if this button belongs to the target zone
-            if (getButtonZone(row, col) == zone_id) {
-                
-                // If button is currently toggled, untoggle it
-                if (matrix_toggled[row][col] == true) {
-                    // Get original state and restore it
-                    LEDStateMatrix original = getMatrixButtonState(row, col);
-                    setMatrixButtonLED(row, col, original.color, original.brightness, false);
-                    
-                    // Update toggle state
-                    matrix_toggled[row][col] = false;
-                }
-            }
-        }
+    // Validate zone
+    if (zone_id < 0 || zone_id >= zone_map.zone_count) {
+        return;
     }
+
+    // Find toggled buttons in this zone, then clear them
+    uint32_t toggled_in_zone = toggled_mask & zone_map.zone_masks[zone_id];
+    toggled_mask &= ~zone_map.zone_masks[zone_id];
+
+    // Restore original LED states
+    restoreButtons(toggled_in_zone);
 }
 
 /*
@@ -468,19 +549,400 @@ void ButtonToggleSystem::untoggleMatrixZone(int zone_id) {
 * Useful when switching modes or resetting
 */
 void ButtonToggleSystem::untoggleAllMatrixButtons() {
-    // Iterate through all matrix buttons
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 1; col <= 4; col++) {
-            
-            // If button is currently toggled, untoggle it
-            if (matrix_toggled[row][col] == true) {
-                // Get original state and restore it
-                LEDStateMatrix original = getMatrixButtonState(row, col);
-                setMatrixButtonLED(row, col, original.color, original.brightness, false);
-                
-                // Update toggle state
-                matrix_toggled[row][col] = false;
-            }
+    // Find toggled matrix buttons, then clear them
+    uint32_t toggled_matrix = toggled_mask & TOGGLE_MASK_MATRIX;
+    toggled_mask &= ~TOGGLE_MASK_MATRIX;
+
+    // Restore original LED states
+    restoreButtons(toggled_matrix);
+}
+
+/*
+* Restores the original LED state of every button set in the mask
+* Walks only the set bits, so an empty mask costs nothing
+* Also resets CYCLE steps and stops ONE_SHOT flashes of those buttons
+*
+* @param button_bits: Button bits to restore (see TOGGLE BIT LAYOUT)
+*/
+void ButtonToggleSystem::restoreButtons(uint32_t button_bits) {
+    one_shot_mask &= ~button_bits;
+
+    while (button_bits != 0) {
+        // Take lowest set bit
+        int bit = std::countr_zero(button_bits);
+        button_bits &= button_bits - 1;
+
+        // Reset behavior state and restore LED
+        cycle_step[bit] = 0;
+        restoreButtonLED(bit);
+    }
+}
+
+// =============================================================================
+// BUTTON BEHAVIORS - Per-button behavior modes with a dispatch table
+// =============================================================================
+
+/*
+* LED button enums in toggle bit order (index = bit - TOGGLE_BIT_X_START)
+*/
+static const SpecialLEDButton SPECIAL_LED_BUTTONS[5] = {
+    SpecialLEDButton::BROWSE, SpecialLEDButton::SIZE, SpecialLEDButton::TYPE,
+    SpecialLEDButton::REVERSE, SpecialLEDButton::SHIFT
+};
+static const ControlLEDButton CONTROL_LED_BUTTONS[3] = {
+    ControlLEDButton::CAPTURE, ControlLEDButton::QUANT, ControlLEDButton::SYNC
+};
+static const StopLEDButton STOP_LED_BUTTONS[4] = {
+    StopLEDButton::STOP1, StopLEDButton::STOP2, StopLEDButton::STOP3, StopLEDButton::STOP4
+};
+
+/*
+* Behavior dispatch table, indexed by ButtonBehavior
+* Adding a behavior = add enum value + handler + entry here
+*/
+const ButtonToggleSystem::BehaviorHandler ButtonToggleSystem::behavior_handlers[BUTTON_BEHAVIOR_COUNT] = {
+    &ButtonToggleSystem::handleLatch,       // ButtonBehavior::LATCH
+    &ButtonToggleSystem::handleRadio,       // ButtonBehavior::RADIO
+    &ButtonToggleSystem::handleMomentary,   // ButtonBehavior::MOMENTARY
+    &ButtonToggleSystem::handleCycle,       // ButtonBehavior::CYCLE
+    &ButtonToggleSystem::handleOneShot      // ButtonBehavior::ONE_SHOT
+};
+
+// =======================================
+// Behavior config helpers
+// =======================================
+
+/*
+* Creates a behavior config without extra parameters (LATCH, RADIO, MOMENTARY)
+*
+* @param behavior: The behavior
+* @return: Behavior config
+*/
+ButtonBehaviorConfig makeButtonBehavior(ButtonBehavior behavior) {
+    ButtonBehaviorConfig config = {};
+    config.behavior = behavior;
+    config.one_shot_ms = DEFAULT_ONE_SHOT_MS;
+    return config;
+}
+
+/*
+* Creates a ONE_SHOT behavior config
+*
+* @param flash_ms: How long the button flashes at full brightness
+* @return: Behavior config
+*/
+ButtonBehaviorConfig makeOneShotBehavior(uint16_t flash_ms) {
+    ButtonBehaviorConfig config = makeButtonBehavior(ButtonBehavior::ONE_SHOT);
+    config.one_shot_ms = flash_ms;
+    return config;
+}
+
+/*
+* Creates a CYCLE behavior config
+* Each press steps through the given colors/brightness, after the last step
+* the button returns to its original state
+*
+* @param colors: Colors per step (matrix buttons only, may be nullptr for single-color buttons)
+* @param brightness: Brightness per step
+* @param steps: Number of steps excluding the original state (1 to MAX_CYCLE_STEPS-1)
+* @return: Behavior config
+*/
+ButtonBehaviorConfig makeCycleBehavior(const LEDColor* colors, const float* brightness, int steps) {
+    ButtonBehaviorConfig config = makeButtonBehavior(ButtonBehavior::CYCLE);
+
+    // Clamp number of steps
+    if (steps < 1) steps = 1;
+    if (steps > MAX_CYCLE_STEPS - 1) steps = MAX_CYCLE_STEPS - 1;
+
+    // Step 0 = original state, steps 1..n = given values
+    config.cycle_steps = (uint8_t)(steps + 1);
+    for (int i = 0; i < steps; i++) {
+        config.cycle_colors[i + 1] = (colors != nullptr) ? colors[i] : LEDColor::white;
+        config.cycle_brightness[i + 1] = brightness[i];
+    }
+    return config;
+}
+
+// =======================================
+// Button to bit mapping
+// =======================================
+
+int ButtonToggleSystem::getSpecialButtonBit(SpecialLEDButton button) {
+    int index = getSpecialButtonIndex(button);
+    return (index < 0) ? -1 : TOGGLE_BIT_SPECIAL_START + index;
+}
+
+int ButtonToggleSystem::getControlButtonBit(ControlLEDButton button) {
+    int index = getControlButtonIndex(button);
+    return (index < 0) ? -1 : TOGGLE_BIT_CONTROL_START + index;
+}
+
+int ButtonToggleSystem::getStopButtonBit(StopLEDButton button) {
+    int index = getStopButtonIndex(button);
+    return (index < 0) ? -1 : TOGGLE_BIT_STOP_START + index;
+}
+
+// =======================================
+// Behavior configuration
+// =======================================
+
+/*
+* Sets the behavior of one button
+* The button is restored to its original state first
+*
+* @param bit: Button bit (use getMatrixButtonBit() & co.)
+* @param config: Behavior config
+*/
+void ButtonToggleSystem::setButtonBehavior(int bit, const ButtonBehaviorConfig& config) {
+    // Step 1: Validate bit and behavior
+    if (bit < 0 || bit >= TOGGLE_BIT_COUNT || (int)config.behavior >= BUTTON_BEHAVIOR_COUNT) {
+        std::cerr << "Error: Invalid button bit or behavior in setButtonBehavior()" << std::endl;
+        return;
+    }
+
+    // Step 2: Restore button if it is currently lit by its old behavior
+    uint32_t mask = 1u << bit;
+    if (toggled_mask & mask) {
+        toggled_mask &= ~mask;
+        restoreButtons(mask);
+    }
+    cycle_step[bit] = 0;
+
+    // Step 3: Store new behavior
+    behaviors[bit] = config;
+}
+
+/*
+* Resets all buttons to default behaviors
+* Matrix buttons = RADIO (zone exclusive), all other buttons = LATCH
+*/
+void ButtonToggleSystem::resetButtonBehaviors() {
+    for (int bit = 0; bit < TOGGLE_BIT_COUNT; bit++) {
+        bool is_matrix = (TOGGLE_MASK_MATRIX >> bit) & 1u;
+        behaviors[bit] = makeButtonBehavior(is_matrix ? ButtonBehavior::RADIO : ButtonBehavior::LATCH);
+        cycle_step[bit] = 0;
+    }
+    one_shot_mask = 0;
+}
+
+ButtonBehavior ButtonToggleSystem::getButtonBehavior(int bit) const {
+    if (bit < 0 || bit >= TOGGLE_BIT_COUNT) {
+        return ButtonBehavior::LATCH;
+    }
+    return behaviors[bit].behavior;
+}
+
+// =======================================
+// Per-report processing
+// =======================================
+
+/*
+* Handles all button presses and releases of one input report
+* Edges are found with bit math on the pressed masks, each edge is dispatched
+* to the behavior handler of its button. Also updates the was-pressed state,
+* so updateButtonStates() is not needed when using this function.
+*
+* @param input_report: The 22-byte input report from readInputReport()
+* @param now_ms: Current time in milliseconds
+*/
+void ButtonToggleSystem::processInputReport(const unsigned char* input_report, uint64_t now_ms) {
+    current_time_ms = now_ms;
+
+    // Step 1: Find press and release transitions
+    uint32_t pressed_mask = getPressedButtonMask(input_report);
+    uint32_t press_edges = pressed_mask & ~was_pressed_mask;
+    uint32_t release_edges = was_pressed_mask & ~pressed_mask;
+
+    // Step 2: Dispatch releases, then presses
+    while (release_edges != 0) {
+        int bit = std::countr_zero(release_edges);
+        release_edges &= release_edges - 1;
+        dispatchButtonEdge(bit, false);
+    }
+    while (press_edges != 0) {
+        int bit = std::countr_zero(press_edges);
+        press_edges &= press_edges - 1;
+        dispatchButtonEdge(bit, true);
+    }
+
+    // Step 3: Remember pressed buttons for next frame
+    was_pressed_mask = pressed_mask;
+}
+
+/*
+* Dispatches a release for every button held in the last frame and clears the
+* edge state, so the next report starts from "nothing pressed"
+* (a button held while the device was gone must not stay momentary-on)
+*
+* @param now_ms: Current time in milliseconds
+*/
+void ButtonToggleSystem::releaseAllButtons(uint64_t now_ms) {
+    current_time_ms = now_ms;
+
+    uint32_t release_edges = was_pressed_mask;
+    while (release_edges != 0) {
+        int bit = std::countr_zero(release_edges);
+        release_edges &= release_edges - 1;
+        dispatchButtonEdge(bit, false);
+    }
+    was_pressed_mask = 0;
+}
+
+/*
+* Ends ONE_SHOT flashes whose time is up
+* Call this once per main loop tick, also when no input report arrived
+*
+* @param now_ms: Current time in milliseconds
+*/
+void ButtonToggleSystem::updateTimedBehaviors(uint64_t now_ms) {
+    current_time_ms = now_ms;
+
+    // Walk only the running flashes
+    uint32_t running = one_shot_mask;
+    while (running != 0) {
+        int bit = std::countr_zero(running);
+        running &= running - 1;
+
+        if (now_ms >= one_shot_expiry_ms[bit]) {
+            uint32_t mask = 1u << bit;
+            toggled_mask &= ~mask;
+            restoreButtons(mask);
         }
     }
-}
\ No newline at end of file
+}
+
+void ButtonToggleSystem::dispatchButtonEdge(int bit, bool pressed) {
+    traceInstant(pressed ? TraceName::BUTTON_PRESS : TraceName::BUTTON_RELEASE, bit);
+
+    // Behavior index checked before the indirect call (setButtonBehavior only stores valid ones)
+    int behavior_index = (int)behaviors[bit].behavior;
+    if (behavior_index < 0 || behavior_index >= BUTTON_BEHAVIOR_COUNT) {
+        return;
+    }
+    BehaviorHandler handler = behavior_handlers[behavior_index];
+    (this->*handler)(bit, pressed);
+}
+
+// =======================================
+// Behavior handlers
+// =======================================
+
+// LATCH: press flips between original and full brightness
+void ButtonToggleSystem::handleLatch(int bit, bool pressed) {
+    if (!pressed) return;
+
+    uint32_t mask = 1u << bit;
+    if (toggled_mask & mask) {
+        restoreButtonLED(bit);
+    } else {
+        setButtonFullBrightness(bit);
+    }
+    toggled_mask ^= mask;
+}
+
+// RADIO: like LATCH, but first untoggles the rest of the button's matrix zone
+void ButtonToggleSystem::handleRadio(int bit, bool pressed) {
+    if (!pressed) return;
+
+    uint32_t mask = 1u << bit;
+    bool is_matrix = (TOGGLE_MASK_MATRIX & mask) != 0;
+
+    // Button is not toggled - untoggle others in zone, then toggle this one
+    if (is_matrix && (toggled_mask & mask) == 0) {
+        untoggleMatrixZone(zone_map.button_zone[bit - TOGGLE_BIT_MATRIX_START]);
+    }
+    handleLatch(bit, pressed);
+}
+
+// MOMENTARY: lit while held
+void ButtonToggleSystem::handleMomentary(int bit, bool pressed) {
+    uint32_t mask = 1u << bit;
+    if (pressed) {
+        setButtonFullBrightness(bit);
+        toggled_mask |= mask;
+    } else {
+        restoreButtonLED(bit);
+        toggled_mask &= ~mask;
+    }
+}
+
+// CYCLE: each press advances one step, wraps back to the original state
+void ButtonToggleSystem::handleCycle(int bit, bool pressed) {
+    if (!pressed) return;
+
+    const ButtonBehaviorConfig& config = behaviors[bit];
+    uint32_t mask = 1u << bit;
+    int steps = (config.cycle_steps < 2) ? 2 : config.cycle_steps;
+
+    // Advance step
+    int step = (cycle_step[bit] + 1) % steps;
+    cycle_step[bit] = (uint8_t)step;
+
+    // Step 0 = original state, others = configured color/brightness
+    if (step == 0) {
+        restoreButtonLED(bit);
+        toggled_mask &= ~mask;
+    } else {
+        setButtonLED(bit, config.cycle_colors[step], config.cycle_brightness[step]);
+        toggled_mask |= mask;
+    }
+}
+
+// ONE_SHOT: flash on press, updateTimedBehaviors() restores it
+void ButtonToggleSystem::handleOneShot(int bit, bool pressed) {
+    if (!pressed) return;
+
+    uint32_t mask = 1u << bit;
+    setButtonFullBrightness(bit);
+    toggled_mask |= mask;
+    one_shot_mask |= mask;
+    one_shot_expiry_ms[bit] = current_time_ms + behaviors[bit].one_shot_ms;
+}
+
+// =======================================
+// Generic per-bit LED helpers
+// =======================================
+
+/*
+* Sets the LED of any button by its bit, without overwriting the original state
+* Color is ignored for single-color buttons
+*/
+void ButtonToggleSystem::setButtonLED(int bit, LEDColor color, float brightness) {
+    if (bit < TOGGLE_BIT_SPECIAL_START) {
+        setMatrixButtonLED(MatrixPad::fromIndex(bit - TOGGLE_BIT_MATRIX_START), color, brightness, false);
+    } else if (bit < TOGGLE_BIT_CONTROL_START) {
+        setSpecialButtonLED(SPECIAL_LED_BUTTONS[bit - TOGGLE_BIT_SPECIAL_START], brightness, false);
+    } else if (bit < TOGGLE_BIT_STOP_START) {
+        setControlButtonLED(CONTROL_LED_BUTTONS[bit - TOGGLE_BIT_CONTROL_START], brightness, false);
+    } else {
+        setStopButtonLED(STOP_LED_BUTTONS[bit - TOGGLE_BIT_STOP_START], brightness, false);
+    }
+}
+
+/*
+* Sets a button to full brightness, matrix buttons keep their original color
+*/
+void ButtonToggleSystem::setButtonFullBrightness(int bit) {
+    if (bit < TOGGLE_BIT_SPECIAL_START) {
+        LEDStateMatrix original = getMatrixButtonState(MatrixPad::fromIndex(bit - TOGGLE_BIT_MATRIX_START));
+        setButtonLED(bit, original.color, TOGGLED_BRIGHTNESS);
+    } else {
+        setButtonLED(bit, LEDColor::white, TOGGLED_BRIGHTNESS);
+    }
+}
+
+/*
+* Restores a button to its original color/brightness from the LED state storage
+*/
+void ButtonToggleSystem::restoreButtonLED(int bit) {
+    if (bit < TOGGLE_BIT_SPECIAL_START) {
+        LEDStateMatrix original = getMatrixButtonState(MatrixPad::fromIndex(bit - TOGGLE_BIT_MATRIX_START));
+        setButtonLED(bit, original.color, original.brightness);
+    } else if (bit < TOGGLE_BIT_CONTROL_START) {
+        setButtonLED(bit, LEDColor::white, getSpecialButtonState(SPECIAL_LED_BUTTONS[bit - TOGGLE_BIT_SPECIAL_START]).brightness);
+    } else if (bit < TOGGLE_BIT_STOP_START) {
+        setButtonLED(bit, LEDColor::white, getControlButtonState(CONTROL_LED_BUTTONS[bit - TOGGLE_BIT_CONTROL_START]).brightness);
+    } else {
+        setButtonLED(bit, LEDColor::white, getStopButtonState(STOP_LED_BUTTONS[bit - TOGGLE_BIT_STOP_START]).brightness);
+    }
+}
@@ -0,0 +1,300 @@
+#include "headers/led_frame_receiver.h"     // Include header file
+
+#include <iostream>                         // For std::cout and std::cerr
+#include <cstring>                          // For memcpy, strlen
+#include <fcntl.h>                          // For O_* flags
+#include <unistd.h>                         // For ftruncate, ::close
+#include <sys/mman.h>                       // For shm_open, mmap
+
+// =============================================================================
+// CONSTANTS - Button order in ExternalLEDFrame
+// =============================================================================
+
+static const SpecialLEDButton FRAME_SPECIAL_BUTTONS[5] = {
+    SpecialLEDButton::BROWSE, SpecialLEDButton::SIZE, SpecialLEDButton::TYPE,
+    SpecialLEDButton::REVERSE, SpecialLEDButton::SHIFT
+};
+static const ControlLEDButton FRAME_CONTROL_BUTTONS[3] = {
+    ControlLEDButton::CAPTURE, ControlLEDButton::QUANT, ControlLEDButton::SYNC
+};
+static const StopLEDButton FRAME_STOP_BUTTONS[4] = {
+    StopLEDButton::STOP1, StopLEDButton::STOP2, StopLEDButton::STOP3, StopLEDButton::STOP4
+};
+
+// =============================================================================
+// RENDERER SIDE
+// =============================================================================
+
+/*
+* Maps the LED frame segment created by the controller
+*
+* @param name: Shared memory name used by the controller
+* @return: Segment pointer, nullptr if missing or incompatible
+*/
+LEDFrameSegment* openLEDFrameSegment(const char* name) {
+    // Step 1: Open existing segment
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        std::cerr << "openLEDFrameSegment Error: Shared memory " << name << " not found" << std::endl;
+        return nullptr;
+    }
+
+    // Step 2: Map read/write
+    void* memory = mmap(nullptr, sizeof(LEDFrameSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "openLEDFrameSegment Error: Cannot map shared memory " << name << std::endl;
+        return nullptr;
+    }
+
+    // Step 3: Check header
+    LEDFrameSegment* segment = (LEDFrameSegment*)memory;
+    if (segment->magic != LED_FRAME_SHM_MAGIC || segment->version != LED_FRAME_SHM_VERSION) {
+        std::cerr << "openLEDFrameSegment Error: Shared memory " << name << " has an unknown layout" << std::endl;
+        munmap(memory, sizeof(LEDFrameSegment));
+        return nullptr;
+    }
+    return segment;
+}
+
+void closeLEDFrameSegment(LEDFrameSegment* segment) {
+    if (segment != nullptr) {
+        munmap(segment, sizeof(LEDFrameSegment));
+    }
+}
+
+/*
+* Writes a frame into the unpublished buffer and publishes it
+*
+* @param segment: Segment from openLEDFrameSegment() or LEDFrameReceiver::getSegment()
+* @param frame: Frame to publish
+*/
+void writeLEDFrame(LEDFrameSegment* segment, const ExternalLEDFrame& frame) {
+    if (segment == nullptr) {
+        return;
+    }
+
+    // Step 1: Pick the buffer that is not published
+    uint64_t published = segment->published.load(std::memory_order_relaxed);
+    uint64_t frame_number = (published >> 1) + 1;
+    int index = (published == 0) ? 0 : (int)((published & 1u) ^ 1u);
+
+    // Step 2: Write it under its seqlock
+    uint32_t sequence = segment->buffer_sequence[index].load(std::memory_order_relaxed);
+    segment->buffer_sequence[index].store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&segment->buffers[index], &frame, sizeof(ExternalLEDFrame));
+    segment->buffer_sequence[index].store(sequence + 2, std::memory_order_release);
+
+    // Step 3: Publish
+    segment->published.store((frame_number << 1) | (uint64_t)index, std::memory_order_release);
+}
+
+// =============================================================================
+// LED FRAME RECEIVER - Setup
+// =============================================================================
+
+/*
+* Creates the named LED frame segment (renderers open it with openLEDFrameSegment())
+*
+* @param name: Shared memory name, must start with '/'
+* @return: true if the segment is mapped
+*/
+bool LEDFrameReceiver::open(const char* name) {
+    close();
+
+    // Step 1: Check name
+    if (name == nullptr || name[0] != '/' || strlen(name) >= sizeof(shm_name)) {
+        std::cerr << "LEDFrameReceiver Error: Invalid shared memory name" << std::endl;
+        return false;
+    }
+
+    // Step 2: Create segment and set its size
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0666);
+    if (fd < 0) {
+        std::cerr << "LEDFrameReceiver Error: Cannot open shared memory " << name << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, sizeof(LEDFrameSegment)) != 0) {
+        std::cerr << "LEDFrameReceiver Error: Cannot resize shared memory " << name << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    // Step 3: Map it
+    void* memory = mmap(nullptr, sizeof(LEDFrameSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "LEDFrameReceiver Error: Cannot map shared memory " << name << std::endl;
+        return false;
+    }
+
+    // Step 4: Initialize header (old frames from a previous run are ignored)
+    segment = (LEDFrameSegment*)memory;
+    if (segment->magic != LED_FRAME_SHM_MAGIC || segment->version != LED_FRAME_SHM_VERSION) {
+        segment->magic = 0;
+        segment->published.store(0, std::memory_order_relaxed);
+        segment->buffer_sequence[0].store(0, std::memory_order_relaxed);
+        segment->buffer_sequence[1].store(0, std::memory_order_relaxed);
+        segment->version = LED_FRAME_SHM_VERSION;
+        std::atomic_thread_fence(std::memory_order_release);
+        segment->magic = LED_FRAME_SHM_MAGIC;
+    }
+    last_frame_number = segment->published.load(std::memory_order_acquire) >> 1;
+    consumed_count = 0;
+    dropped_count = 0;
+
+    memcpy(shm_name, name, strlen(name) + 1);
+    owns_shm_name = true;
+    std::cout << "- LED frames accepted from shared memory " << name << std::endl;
+    return true;
+}
+
+/*
+* Uses an anonymous private mapping instead of a named segment
+*
+* @return: true if the segment is mapped
+*/
+bool LEDFrameReceiver::openInProcess() {
+    close();
+
+    void* memory = mmap(nullptr, sizeof(LEDFrameSegment), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "LEDFrameReceiver Error: Cannot map in-process frame segment" << std::endl;
+        return false;
+    }
+
+    segment = (LEDFrameSegment*)memory;  // Anonymous memory is zeroed
+    segment->version = LED_FRAME_SHM_VERSION;
+    segment->magic = LED_FRAME_SHM_MAGIC;
+    last_frame_number = 0;
+    consumed_count = 0;
+    dropped_count = 0;
+    return true;
+}
+
+void LEDFrameReceiver::close() {
+    if (segment != nullptr) {
+        munmap(segment, sizeof(LEDFrameSegment));
+        segment = nullptr;
+    }
+    if (owns_shm_name) {
+        shm_unlink(shm_name);
+        owns_shm_name = false;
+    }
+}
+
+bool LEDFrameReceiver::isOpen() const {
+    return segment != nullptr;
+}
+
+LEDFrameSegment* LEDFrameReceiver::getSegment() {
+    return segment;
+}
+
+uint32_t LEDFrameReceiver::getConsumedCount() const {
+    return consumed_count;
+}
+
+uint32_t LEDFrameReceiver::getDroppedCount() const {
+    return dropped_count;
+}
+
+// =============================================================================
+// LED FRAME RECEIVER - Receiving
+// =============================================================================
+
+/*
+* Copies the latest published frame under its buffer seqlock
+* Retries with the newest frame if the renderer overwrote the buffer meanwhile
+*/
+bool LEDFrameReceiver::copyLatestFrame(ExternalLEDFrame& frame, uint64_t& frame_number) {
+    for (int attempt = 0; attempt < LED_FRAME_READ_MAX_RETRIES; attempt++) {
+        // Step 1: Find latest frame
+        uint64_t published = segment->published.load(std::memory_order_acquire);
+        int index = (int)(published & 1u);
+        frame_number = published >> 1;
+
+        // Step 2: Copy it if its buffer is stable
+        uint32_t before = segment->buffer_sequence[index].load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+        memcpy(&frame, (const void*)&segment->buffers[index], sizeof(ExternalLEDFrame));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t after = segment->buffer_sequence[index].load(std::memory_order_relaxed);
+        if (before == after) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+* Applies the newest frame if the renderer published one since the last tick
+* Frames published in between are skipped and counted as dropped
+* Call inside beginLEDFrame()/endLEDFrame(), so a frame is sent as one report
+*
+* @param display: Display controller for the display text
+* @return: true if a frame was applied
+*/
+bool LEDFrameReceiver::poll(DisplayController& display) {
+    if (segment == nullptr) {
+        return false;
+    }
+
+    // Step 1: Anything new?
+    uint64_t latest_frame_number = segment->published.load(std::memory_order_acquire) >> 1;
+    if (latest_frame_number == last_frame_number) {
+        return false;
+    }
+
+    // Step 2: Copy it
+    ExternalLEDFrame frame;
+    uint64_t frame_number;
+    if (!copyLatestFrame(frame, frame_number)) {
+        dropped_count += (uint32_t)(latest_frame_number - last_frame_number);
+        last_frame_number = latest_frame_number;
+        return false;
+    }
+
+    // Step 3: Count skipped frames and apply
+    dropped_count += (uint32_t)(frame_number - last_frame_number - 1);
+    last_frame_number = frame_number;
+    consumed_count++;
+
+    applyFrame(frame, display);
+    return true;
+}
+
+/*
+* Writes one frame into the LED buffer (and display)
+* Uses the same 8-bit to 7-bit conversion as the color palette; state storage
+* is not changed, so toggles still restore the page scene
+*/
+void LEDFrameReceiver::applyFrame(const ExternalLEDFrame& frame, DisplayController& display) {
+    if (frame.flags & LED_FRAME_HAS_MATRIX) {
+        for (int i = 0; i < MATRIX_PAD_COUNT; i++) {
+            MatrixPad pad = MatrixPad::fromIndex(i);
+            const uint8_t* rgb = frame.matrix_rgb[pad.row() - 1][pad.col() - 1];
+            setMatrixButtonRGB(pad, rgb[0], rgb[1], rgb[2]);
+        }
+    }
+
+    if (frame.flags & LED_FRAME_HAS_BUTTONS) {
+        for (int i = 0; i < 5; i++) {
+            setSpecialButtonLED(FRAME_SPECIAL_BUTTONS[i], frame.special_brightness[i] / 255.0f, false);
+        }
+        for (int i = 0; i < 3; i++) {
+            setControlButtonLED(FRAME_CONTROL_BUTTONS[i], frame.control_brightness[i] / 255.0f, false);
+        }
+        for (int i = 0; i < 4; i++) {
+            setStopButtonLED(FRAME_STOP_BUTTONS[i], frame.stop_brightness[i] / 255.0f, false);
+        }
+    }
+
+    if (frame.flags & LED_FRAME_HAS_DISPLAY) {
+        char text[3] = {frame.display_text[0], frame.display_text[1], '\0'};
+        display.setDisplayText(text);
+    }
+}
@@ -58,6 +58,101 @@ void SceneController::setEffectsPageScene(int effects_page) {
     }
 }
 
+/*
+* Matrix toggle zones per effects page
+* Use a predefined MatrixToggleZone mode, or a custom 4x4 layout of zone ids
+* (see led_controller_toggle.h) for anything else, e.g.:
+*
+*   static const int layout[4][4] = {
+*       {0, 0, 0, 0},                   // Row 1: radio group
+*       {1, 1, 1, 1},                   // Row 2: radio group
+*       {2, 2, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE},
+*       {2, 2, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE}
+*   };
+*   toggle_system.setMatrixZoneLayout(layout);
+*
+* @param toggle_system: Button toggle system to configure
+* @param effects_page: Effects page number (1-99)
+*/
+
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+// Add effects page zones here !
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+
+void SceneController::setEffectsPageZones(ButtonToggleSystem& toggle_system, int effects_page) {
+    switch (effects_page) {
+        case 1:
+            toggle_system.setMatrixToggleMode(MatrixToggleZone::LEFT_RIGHT_SPLIT);
+            break;
+        case 2:
+            toggle_system.setMatrixToggleMode(MatrixToggleZone::LEFT_RIGHT_SPLIT);
+            break;
+        default:
+            toggle_system.setMatrixToggleMode(MatrixToggleZone::LEFT_RIGHT_SPLIT);
+            break;
+    }
+}
+
+/*
+* Button behaviors per effects page
+* Every page starts from the defaults (matrix = RADIO, others = LATCH), then
+* overrides single buttons, e.g.:
+*
+*   // Stop buttons only light while held
+*   toggle_system.setButtonBehavior(ButtonToggleSystem::getStopButtonBit(StopLEDButton::STOP1),
+*                                   makeButtonBehavior(ButtonBehavior::MOMENTARY));
+*
+*   // Pad (4,4) cycles red -> yellow -> green -> original
+*   static const LEDColor colors[3] = {LEDColor::red, LEDColor::yellow, LEDColor::green};
+*   static const float brightness[3] = {1.0f, 1.0f, 1.0f};
+*   toggle_system.setButtonBehavior(ButtonToggleSystem::getMatrixButtonBit({4, 4}),
+*                                   makeCycleBehavior(colors, brightness, 3));
+*
+*   // SYNC flashes for 200ms
+*   toggle_system.setButtonBehavior(ButtonToggleSystem::getControlButtonBit(ControlLEDButton::SYNC),
+*                                   makeOneShotBehavior(200));
+*
+* @param toggle_system: Button toggle system to configure
+* @param effects_page: Effects page number (1-99)
+*/
+
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+// Add effects page button behaviors here !
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+
+void SceneController::setEffectsPageBehaviors(ButtonToggleSystem& toggle_system, int effects_page) {
+    // Start from default behaviors
+    toggle_system.resetButtonBehaviors();
+
+    switch (effects_page) {
+        default:
+            break;
+    }
+}
+
+/*
+* Effects page names, scrolled across the 7-segment display when a page is loaded
+* Use characters from SEGMENT_GLYPHS (led_controller_display.h), max 32 characters
+*
+* @param effects_page: Effects page number (1-99)
+* @return: Page name, or nullptr to just show the page number
+*/
+
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+// Add effects page names here !
+// xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+
+const char* SceneController::getEffectsPageName(int effects_page) {
+    switch (effects_page) {
+        case 1:
+            return "rEd-WhitE";
+        case 2:
+            return "bluE-OrAngE";
+        default:
+            return nullptr;
+    }
+}
+
 // =============================================================
 // Effects Page Scenes
 // =============================================================
@@ -73,38 +168,36 @@ void SceneController::setEffectsPageScene(int effects_page) {
 // === Default page ===
 // Default scene for undefined pages - Rainbow colors, low brightness
 void SceneController::applyDefaultScene() {
-    setMatrixButtonLED(1, 1, LEDColor::red, 0.2f, true);
-    setMatrixButtonLED(1, 2, LEDColor::orange, 0.2f, true);
-    setMatrixButtonLED(1, 3, LEDColor::lightorange, 0.2f, true);
-    setMatrixButtonLED(1, 4, LEDColor::warmyellow, 0.2f, true);
-    setMatrixButtonLED(2, 1, LEDColor::yellow, 0.2f, true);
-    setMatrixButtonLED(2, 2, LEDColor::lime, 0.2f, true);
-    setMatrixButtonLED(2, 3, LEDColor::green, 0.2f, true);
-    setMatrixButtonLED(2, 4, LEDColor::mint, 0.2f, true);
-    setMatrixButtonLED(3, 1, LEDColor::cyan, 0.2f, true);
-    setMatrixButtonLED(3, 2, LEDColor::turquise, 0.2f, true);
-    setMatrixButtonLED(3, 3, LEDColor::blue, 0.2f, true);
-    setMatrixButtonLED(3, 4, LEDColor::plum, 0.2f, true);
-    setMatrixButtonLED(4, 1, LEDColor::violet, 0.2f, true);
-    setMatrixButtonLED(4, 2, LEDColor::purple, 0.2f, true);
-    setMatrixButtonLED(4, 3, LEDColor::magenta, 0.2f, true);
-    setMatrixButtonLED(4, 4, LEDColor::fuchsia, 0.2f, true);
+    setMatrixButtonLED({1, 1}, LEDColor::red, 0.2f, true);
+    setMatrixButtonLED({1, 2}, LEDColor::orange, 0.2f, true);
+    setMatrixButtonLED({1, 3}, LEDColor::lightorange, 0.2f, true);
+    setMatrixButtonLED({1, 4}, LEDColor::warmyellow, 0.2f, true);
+    setMatrixButtonLED({2, 1}, LEDColor::yellow, 0.2f, true);
+    setMatrixButtonLED({2, 2}, LEDColor::lime, 0.2f, true);
+    setMatrixButtonLED({2, 3}, LEDColor::green, 0.2f, true);
+    setMatrixButtonLED({2, 4}, LEDColor::mint, 0.2f, true);
+    setMatrixButtonLED({3, 1}, LEDColor::cyan, 0.2f, true);
+    setMatrixButtonLED({3, 2}, LEDColor::turquise, 0.2f, true);
+    setMatrixButtonLED({3, 3}, LEDColor::blue, 0.2f, true);
+    setMatrixButtonLED({3, 4}, LEDColor::plum, 0.2f, true);
+    setMatrixButtonLED({4, 1}, LEDColor::violet, 0.2f, true);
+    setMatrixButtonLED({4, 2}, LEDColor::purple, 0.2f, true);
+    setMatrixButtonLED({4, 3}, LEDColor::magenta, 0.2f, true);
+    setMatrixButtonLED({4, 4}, LEDColor::fuchsia, 0.2f, true);
 }
 
 // === Effects Page 1 ===
 // Scene for effects page 1 - Left half red, right half white
 void SceneController::applyScene1() {
     // Left half red
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 1; col <= 2; col++) {
-            setMatrixButtonLED(row, col, LEDColor::red, 0.2f, true);
-        }
+    for (int i = 0; i < MATRIX_PAD_COUNT; i++) {
+        MatrixPad pad = MatrixPad::fromIndex(i);
+        if (pad.col() <= 2) setMatrixButtonLED(pad, LEDColor::red, 0.2f, true);
     }
     // Right half white
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 3; col <= 4; col++) {
-            setMatrixButtonLED(row, col, LEDColor::white, 0.2f, true);
-        }
+    for (int i = 0; i < MATRIX_PAD_COUNT; i++) {
+        MatrixPad pad = MatrixPad::fromIndex(i);
+        if (pad.col() >= 3) setMatrixButtonLED(pad, LEDColor::white, 0.2f, true);
     }
 }
 
@@ -112,16 +205,14 @@ void SceneController::applyScene1() {
 // Scene for effects page 2 - Left half blue, right half orange
 void SceneController::applyScene2() {
     // Left half blue
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 1; col <= 2; col++) {
-            setMatrixButtonLED(row, col, LEDColor::blue, 0.2f, true);
-        }
+    for (int i = 0; i < MATRIX_PAD_COUNT; i++) {
+        MatrixPad pad = MatrixPad::fromIndex(i);
+        if (pad.col() <= 2) setMatrixButtonLED(pad, LEDColor::blue, 0.2f, true);
     }
     // Right half orange
-    for (int row = 1; row <= 4; row++) {
-        for (int col = 3; col <= 4; col++) {
-            setMatrixButtonLED(row, col, LEDColor::lightorange, 0.2f, true);
-        }
+    for (int i = 0; i < MATRIX_PAD_COUNT; i++) {
+        MatrixPad pad = MatrixPad::fromIndex(i);
+        if (pad.col() >= 3) setMatrixButtonLED(pad, LEDColor::lightorange, 0.2f, true);
     }
 }
 
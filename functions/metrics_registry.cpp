@@ -0,0 +1,179 @@
+#include "headers/metrics_registry.h"  // Include header file
+
+#include <cstdio>                       // For vsnprintf
+#include <cstdarg>                      // For va_list
+
+// =============================================================================
+// STATE
+// =============================================================================
+
+// Slot 0 collects counts of threads that never bound a device (benchmarks, tools)
+static DeviceMetrics device_metrics_slots[METRICS_MAX_DEVICES + 1];
+
+thread_local DeviceMetrics* device_metrics = &device_metrics_slots[0];
+
+struct MetricInfo {
+    const char* name;
+    const char* help;
+};
+
+static const MetricInfo COUNTER_INFO[(int)MetricCounter::COUNT] = {
+    { "f1_input_reports_total", "Input reports read from the F1" },
+    { "f1_read_errors_total", "Failed reads (unplugged, USB errors)" },
+    { "f1_invalid_reports_total", "Invalid (short or wrong-ID) input reports" },
+    { "f1_led_reports_total", "LED reports written to the F1" },
+    { "f1_led_frames_suppressed_total", "LED frames not sent because the F1 already shows them" },
+    { "f1_led_partial_writes_total", "LED report writes that wrote fewer bytes than the report" },
+    { "f1_led_write_errors_total", "Failed LED report writes" },
+    { "f1_led_write_nanoseconds_total", "Time spent writing LED reports" },
+    { "f1_reconnects_total", "Reconnects after the F1 was unplugged" }
+};
+
+static const MetricInfo GAUGE_INFO[(int)MetricGauge::COUNT] = {
+    { "f1_connected", "1 while the F1 is open" },
+    { "f1_input_reports_per_second", "Input reports read during the last second" },
+    { "f1_led_reports_per_second", "LED reports written during the last second" }
+};
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+/*
+* Binds the calling thread to an F1's metrics slot and exports it
+*
+* @param device_number: 1-based F1 number (out of range = slot 0, not exported)
+*/
+void bindDeviceMetrics(int device_number) {
+    if (device_number < 1 || device_number > METRICS_MAX_DEVICES) {
+        device_metrics = &device_metrics_slots[0];
+        return;
+    }
+    device_metrics = &device_metrics_slots[device_number];
+    device_metrics->registered.store(true, std::memory_order_relaxed);
+}
+
+/*
+* Counts one LED report write
+*
+* @param duration_ns: Time hid_write took
+* @param bytes_written: hid_write result
+* @param report_size: Size of the LED report
+*/
+void recordLEDWrite(uint64_t duration_ns, int bytes_written, int report_size) {
+    if (bytes_written < 0) {
+        countMetric(MetricCounter::LED_WRITE_ERRORS);
+    } else if (bytes_written != report_size) {
+        countMetric(MetricCounter::LED_PARTIAL_WRITES);
+    } else {
+        countMetric(MetricCounter::LED_REPORTS);
+    }
+    countMetric(MetricCounter::LED_WRITE_NS, duration_ns);
+    device_metrics->led_write_time.record(duration_ns);
+}
+
+/*
+* Per-second gauges from the counter differences since the last call
+*
+* @param elapsed_ns: Time since the last call
+*/
+void updateMetricRates(uint64_t elapsed_ns) {
+    if (elapsed_ns == 0) {
+        return;
+    }
+    for (int d = 1; d <= METRICS_MAX_DEVICES; d++) {
+        DeviceMetrics& metrics = device_metrics_slots[d];
+        if (!metrics.registered.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        uint64_t input_reports = metrics.counters[(int)MetricCounter::INPUT_REPORTS].load(std::memory_order_relaxed);
+        uint64_t led_reports = metrics.counters[(int)MetricCounter::LED_REPORTS].load(std::memory_order_relaxed);
+        metrics.gauges[(int)MetricGauge::INPUT_REPORTS_PER_SECOND].store(
+            (input_reports - metrics.rate_input_reports) * 1000000000ull / elapsed_ns, std::memory_order_relaxed);
+        metrics.gauges[(int)MetricGauge::LED_REPORTS_PER_SECOND].store(
+            (led_reports - metrics.rate_led_reports) * 1000000000ull / elapsed_ns, std::memory_order_relaxed);
+        metrics.rate_input_reports = input_reports;
+        metrics.rate_led_reports = led_reports;
+    }
+}
+
+// =============================================================================
+// PROMETHEUS TEXT FORMAT
+// =============================================================================
+
+/*
+* Appends formatted text, keeps track of the used length (never beyond the buffer)
+*/
+static void appendText(char* buffer, int buffer_size, int& length, const char* format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void appendText(char* buffer, int buffer_size, int& length, const char* format, ...) {
+    if (length >= buffer_size - 1) {
+        return;
+    }
+    va_list arguments;
+    va_start(arguments, format);
+    int written = vsnprintf(buffer + length, buffer_size - length, format, arguments);
+    va_end(arguments);
+    if (written > 0) {
+        length = length + written < buffer_size - 1 ? length + written : buffer_size - 1;
+    }
+}
+
+/*
+* Writes every metric of every bound F1, labeled device="n"
+*
+* @param buffer: Output text
+* @param buffer_size: Size of buffer
+* @return: Length of the text
+*/
+int formatPrometheusMetrics(char* buffer, int buffer_size) {
+    int length = 0;
+    buffer[0] = '\0';
+
+    // Step 1: Counters
+    for (int c = 0; c < (int)MetricCounter::COUNT; c++) {
+        appendText(buffer, buffer_size, length, "# HELP %s %s\n# TYPE %s counter\n",
+                   COUNTER_INFO[c].name, COUNTER_INFO[c].help, COUNTER_INFO[c].name);
+        for (int d = 1; d <= METRICS_MAX_DEVICES; d++) {
+            const DeviceMetrics& metrics = device_metrics_slots[d];
+            if (metrics.registered.load(std::memory_order_relaxed)) {
+                appendText(buffer, buffer_size, length, "%s{device=\"%d\"} %llu\n", COUNTER_INFO[c].name, d,
+                           (unsigned long long)metrics.counters[c].load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    // Step 2: Gauges
+    for (int g = 0; g < (int)MetricGauge::COUNT; g++) {
+        appendText(buffer, buffer_size, length, "# HELP %s %s\n# TYPE %s gauge\n",
+                   GAUGE_INFO[g].name, GAUGE_INFO[g].help, GAUGE_INFO[g].name);
+        for (int d = 1; d <= METRICS_MAX_DEVICES; d++) {
+            const DeviceMetrics& metrics = device_metrics_slots[d];
+            if (metrics.registered.load(std::memory_order_relaxed)) {
+                appendText(buffer, buffer_size, length, "%s{device=\"%d\"} %llu\n", GAUGE_INFO[g].name, d,
+                           (unsigned long long)metrics.gauges[g].load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    // Step 3: LED write time as a summary (quantiles from the histogram)
+    static const double quantiles[] = { 0.5, 0.99, 0.999 };
+    appendText(buffer, buffer_size, length,
+               "# HELP f1_led_write_seconds Time hid_write took for one LED report\n# TYPE f1_led_write_seconds summary\n");
+    for (int d = 1; d <= METRICS_MAX_DEVICES; d++) {
+        const DeviceMetrics& metrics = device_metrics_slots[d];
+        if (!metrics.registered.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        for (double quantile : quantiles) {
+            appendText(buffer, buffer_size, length, "f1_led_write_seconds{device=\"%d\",quantile=\"%g\"} %.9f\n", d, quantile,
+                       metrics.led_write_time.getPercentile(quantile * 100.0) / 1e9);
+        }
+        appendText(buffer, buffer_size, length, "f1_led_write_seconds_sum{device=\"%d\"} %.9f\n", d,
+                   metrics.counters[(int)MetricCounter::LED_WRITE_NS].load(std::memory_order_relaxed) / 1e9);
+        appendText(buffer, buffer_size, length, "f1_led_write_seconds_count{device=\"%d\"} %llu\n", d,
+                   (unsigned long long)metrics.led_write_time.getCount());
+    }
+    return length;
+}
@@ -0,0 +1,150 @@
+#include "headers/metrics_server.h"    // Include header file
+
+#include <iostream>                     // For std::cout and std::cerr
+#include <cstdio>                       // For snprintf
+#include <cstring>                      // For strncmp, strlen
+#include <chrono>                       // For std::chrono::steady_clock (rate interval)
+#include <unistd.h>                     // For ::close, read
+#include <poll.h>                       // For poll
+#include <sys/socket.h>                 // For socket, bind, listen, accept, send
+#include <netinet/in.h>                 // For sockaddr_in
+#include <arpa/inet.h>                  // For htons, htonl
+#include "headers/metrics_registry.h"  // For formatPrometheusMetrics, updateMetricRates
+
+// =============================================================================
+// METRICS SERVER - Setup
+// =============================================================================
+
+/*
+* Binds 127.0.0.1:port and starts the server thread
+*
+* @param port_in: TCP port
+* @return: true if the server is running
+*/
+bool MetricsServer::start(int port_in) {
+    stop();
+
+    // Step 1: Bind and listen (local only, metrics are not meant for the network)
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::cerr << "MetricsServer Error: Cannot open TCP socket" << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port_in);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (const sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 4) != 0) {
+        std::cerr << "MetricsServer Error: Cannot listen on 127.0.0.1:" << port_in << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    // Step 2: Start thread
+    listen_fd = fd;
+    port = port_in;
+    stop_requested.store(false);
+    server_thread = std::thread(&MetricsServer::run, this);
+
+    std::cout << "- Metrics on http://127.0.0.1:" << port << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (server_thread.joinable()) {
+        stop_requested.store(true);
+        server_thread.join();
+    }
+    if (listen_fd >= 0) {
+        ::close(listen_fd);
+        listen_fd = -1;
+    }
+}
+
+bool MetricsServer::isRunning() const {
+    return listen_fd >= 0;
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+// =============================================================================
+// METRICS SERVER - Server thread
+// =============================================================================
+
+/*
+* Server thread: answers scrapes, updates the per-second gauges about once per second
+*/
+void MetricsServer::run() {
+    auto last_rate_update = std::chrono::steady_clock::now();
+    while (!stop_requested.load()) {
+        // Step 1: Wait for a client (or the next rate update)
+        pollfd listen_poll = {listen_fd, POLLIN, 0};
+        if (poll(&listen_poll, 1, METRICS_POLL_TIMEOUT_MS) > 0) {
+            int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                serveClient(fd);
+                ::close(fd);
+            }
+        }
+
+        // Step 2: Per-second gauges
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_rate_update).count();
+        if (elapsed >= 1000000000LL) {
+            updateMetricRates((uint64_t)elapsed);
+            last_rate_update = now;
+        }
+    }
+}
+
+/*
+* Reads the request line and sends the metrics (or 404)
+*
+* @param fd: Client connection
+*/
+void MetricsServer::serveClient(int fd) {
+    // Step 1: Read until the request line is complete (slow clients are dropped)
+    char request[METRICS_REQUEST_SIZE];
+    int length = 0;
+    while (length < (int)sizeof(request) - 1 && memchr(request, '\n', length) == nullptr) {
+        pollfd client_poll = {fd, POLLIN, 0};
+        if (poll(&client_poll, 1, METRICS_CLIENT_TIMEOUT_MS) <= 0) {
+            return;
+        }
+        ssize_t received = read(fd, request + length, sizeof(request) - 1 - length);
+        if (received <= 0) {
+            return;
+        }
+        length += (int)received;
+    }
+    request[length] = '\0';
+
+    // Step 2: Only GET /metrics
+    bool is_metrics = strncmp(request, "GET /metrics ", 13) == 0 || strncmp(request, "GET /metrics?", 13) == 0;
+    if (!is_metrics) {
+        const char not_found[] = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        (void)!send(fd, not_found, sizeof(not_found) - 1, MSG_NOSIGNAL);
+        return;
+    }
+
+    // Step 3: Header and body
+    static char body[METRICS_RESPONSE_SIZE];
+    int body_length = formatPrometheusMetrics(body, sizeof(body));
+    char header[160];
+    int header_length = snprintf(header, sizeof(header),
+                                 "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                                 "Content-Length: %d\r\nConnection: close\r\n\r\n", body_length);
+    (void)!send(fd, header, header_length, MSG_NOSIGNAL);
+    for (int sent = 0; sent < body_length;) {
+        ssize_t written = send(fd, body + sent, body_length - sent, MSG_NOSIGNAL);    // No SIGPIPE if the client left
+        if (written <= 0) {
+            return;
+        }
+        sent += (int)written;
+    }
+}
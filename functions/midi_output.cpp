@@ -0,0 +1,392 @@
+#include "headers/midi_output.h"    // Include header file
+
+#include <iostream>                 // For std::cout and std::cerr
+#include <bit>                      // For std::countr_zero
+#include "headers/tick_clock.h"     // For getTickTimeMs (token bucket start)
+
+// =============================================================================
+// CONSTANTS - MIDI status bytes and controller numbers
+// =============================================================================
+
+static const uint8_t MIDI_NOTE_OFF = 0x80;
+static const uint8_t MIDI_NOTE_ON = 0x90;
+static const uint8_t MIDI_CONTROL_CHANGE = 0xB0;
+
+static const uint8_t CC_DATA_ENTRY_MSB = 6;
+static const uint8_t CC_DATA_ENTRY_LSB = 38;
+static const uint8_t CC_NRPN_LSB = 98;
+static const uint8_t CC_NRPN_MSB = 99;
+static const uint8_t CC_LSB_OFFSET = 32;          // 14-bit CC pairs: LSB controller = MSB controller + 32
+
+// =============================================================================
+// MAPPING
+// =============================================================================
+
+MidiMappingConfig getDefaultMidiMapping() {
+    MidiMappingConfig config = {};
+    config.button_channel = 0;
+    config.knob_channel = 0;
+    config.fader_channel = 0;
+    config.matrix_first_note = 36;          // C1, common drum pad start
+    config.button_first_cc = 102;           // CC 102-119 are undefined in the MIDI spec
+    config.analog_first_cc = 16;            // CC 16-19 general purpose, 20-23 undefined
+    config.nrpn_first_param = 0;
+    config.analog_mode = MidiAnalogMode::CC14;
+    config.messages_per_second = MIDI_DEFAULT_MESSAGES_PER_SECOND;
+    return config;
+}
+
+void MidiOutput::setMapping(const MidiMappingConfig& config) {
+    mapping = config;
+    mapping.button_channel &= 0x0F;
+    mapping.knob_channel &= 0x0F;
+    mapping.fader_channel &= 0x0F;
+    if (mapping.messages_per_second < 1) {
+        mapping.messages_per_second = 1;
+    }
+    resetState();
+}
+
+const MidiMappingConfig& MidiOutput::getMapping() const {
+    return mapping;
+}
+
+// =============================================================================
+// OPEN/CLOSE BACKENDS
+// =============================================================================
+
+/*
+* Opens a virtual ALSA sequencer port other programs can subscribe to
+* (e.g. aconnect or the MIDI input list of the visual software)
+*
+* @param port_name: Client and port name shown to other programs
+* @return: true if the port was created, false otherwise (or if built without ALSA)
+*/
+bool MidiOutput::openAlsaPort(const char* port_name) {
+    close();
+
+#ifdef HAVE_ALSA
+    // Step 1: Open sequencer for output
+    if (snd_seq_open(&seq, "default", SND_SEQ_OPEN_OUTPUT, 0) < 0) {
+        std::cerr << "MidiOutput Error: Cannot open ALSA sequencer" << std::endl;
+        seq = nullptr;
+        return false;
+    }
+    snd_seq_set_client_name(seq, port_name);
+
+    // Step 2: Create readable port (others subscribe to it)
+    seq_port = snd_seq_create_simple_port(seq, port_name,
+                                          SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ,
+                                          SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+    if (seq_port < 0) {
+        std::cerr << "MidiOutput Error: Cannot create ALSA sequencer port" << std::endl;
+        snd_seq_close(seq);
+        seq = nullptr;
+        return false;
+    }
+
+    backend = MidiBackend::ALSA;
+    resetState();
+    std::cout << "- MIDI output on ALSA port '" << port_name << "' (client " << snd_seq_client_id(seq) << ")" << std::endl;
+    return true;
+#else
+    (void)port_name;
+    std::cerr << "MidiOutput Error: Built without ALSA, use a text sink instead" << std::endl;
+    return false;
+#endif
+}
+
+/*
+* Opens a text sink: every MIDI message becomes one line "<time_ms> <hex bytes> <description>"
+* Works with regular files and named pipes (mkfifo), so mappings and message
+* rates can be checked without any MIDI hardware
+*
+* @param path: File or pipe path ("-" for stdout)
+* @return: true if the sink was opened
+*/
+bool MidiOutput::openTextSink(const char* path) {
+    close();
+
+    if (path == nullptr) {
+        std::cerr << "MidiOutput Error: Text sink path is null" << std::endl;
+        return false;
+    }
+
+    text_file = (path[0] == '-' && path[1] == '\0') ? stdout : fopen(path, "w");
+    if (text_file == nullptr) {
+        std::cerr << "MidiOutput Error: Cannot open text sink " << path << std::endl;
+        return false;
+    }
+    if (text_file != stdout) {
+        // Our own buffer: stdio would allocate one on the first message, in the device loop
+        setvbuf(text_file, text_buffer, _IOFBF, sizeof(text_buffer));
+    }
+
+    backend = MidiBackend::TEXT_FILE;
+    resetState();
+    std::cout << "- MIDI output to text sink " << path << std::endl;
+    return true;
+}
+
+void MidiOutput::close() {
+    if (text_file != nullptr && text_file != stdout) {
+        fclose(text_file);
+    }
+    text_file = nullptr;
+
+#ifdef HAVE_ALSA
+    if (seq != nullptr) {
+        snd_seq_close(seq);
+        seq = nullptr;
+        seq_port = -1;
+    }
+#endif
+
+    backend = MidiBackend::NONE;
+}
+
+bool MidiOutput::isOpen() const {
+    return backend != MidiBackend::NONE;
+}
+
+/*
+* Forget last sent state (next report sends everything) and fill all token buckets
+*/
+void MidiOutput::resetState() {
+    has_last_state = false;
+    pending_mask = 0;
+    for (int i = 0; i < 16; i++) {
+        channel_tokens[i] = getRateBurst();
+    }
+    last_refill_ms = getTickTimeMs();  // Buckets are full now, refill from here
+    sent_count = 0;
+    coalesced_count = 0;
+}
+
+// =============================================================================
+// RATE LIMITING - Token bucket per MIDI channel
+// =============================================================================
+
+int MidiOutput::getRateBurst() const {
+    int burst = mapping.messages_per_second * MIDI_RATE_BURST_MS / 1000;
+    return burst < 4 ? 4 : burst;  // Always room for one NRPN update
+}
+
+/*
+* Adds tokens for the time passed since the last refill (capped at the burst size)
+* A time before the last refill (other clock, e.g. replay) restarts the refill there
+*/
+void MidiOutput::refillTokens(uint64_t now_ms) {
+    current_time_ms = now_ms;
+
+    if (now_ms < last_refill_ms) {
+        last_refill_ms = now_ms;
+        return;
+    }
+    // Longer than it takes to fill a bucket adds nothing, clamp before the multiply
+    uint64_t elapsed_ms = now_ms - last_refill_ms;
+    uint64_t fill_ms = (uint64_t)getRateBurst() * 1000 / (uint64_t)mapping.messages_per_second + 1;
+    if (elapsed_ms > fill_ms) {
+        elapsed_ms = fill_ms;
+    }
+    int new_tokens = (int)(elapsed_ms * (uint64_t)mapping.messages_per_second / 1000);
+    if (new_tokens <= 0) {
+        return;  // Keep last_refill_ms, so slow rates still add up
+    }
+    last_refill_ms = now_ms;
+
+    int burst = getRateBurst();
+    for (int i = 0; i < 16; i++) {
+        channel_tokens[i] = (channel_tokens[i] + new_tokens > burst) ? burst : channel_tokens[i] + new_tokens;
+    }
+}
+
+uint8_t MidiOutput::getAnalogChannel(int index) const {
+    return (index < KNOB_COUNT) ? mapping.knob_channel : mapping.fader_channel;
+}
+
+/*
+* Sends queued analog updates whose channel has enough tokens
+* Updates that do not fit stay queued; a newer value replaces them
+* Starts after the last sent control, so one moving fader cannot starve the others
+*/
+void MidiOutput::flushPendingAnalog() {
+    int cost = (mapping.analog_mode == MidiAnalogMode::NRPN) ? 4 : 2;
+
+    for (int i = 0; i < MIDI_ANALOG_COUNT && pending_mask != 0; i++) {
+        int index = (flush_start_index + i) % MIDI_ANALOG_COUNT;
+        if (!((pending_mask >> index) & 1u)) {
+            continue;
+        }
+
+        uint8_t channel = getAnalogChannel(index);
+        if (channel_tokens[channel] < cost) {
+            continue;
+        }
+        channel_tokens[channel] -= cost;
+        sendAnalog(index, pending_values[index]);
+        pending_mask &= ~(1u << index);
+        flush_start_index = (index + 1) % MIDI_ANALOG_COUNT;
+    }
+}
+
+// =============================================================================
+// MESSAGE OUTPUT
+// =============================================================================
+
+/*
+* Sends one 14-bit analog value as CC pair or NRPN
+*/
+void MidiOutput::sendAnalog(int index, uint16_t value14) {
+    uint8_t status = MIDI_CONTROL_CHANGE | getAnalogChannel(index);
+    uint8_t msb = (value14 >> 7) & 0x7F;
+    uint8_t lsb = value14 & 0x7F;
+
+    if (mapping.analog_mode == MidiAnalogMode::NRPN) {
+        uint16_t param = (mapping.nrpn_first_param + index) & 0x3FFF;
+        sendMessage(status, CC_NRPN_MSB, (param >> 7) & 0x7F);
+        sendMessage(status, CC_NRPN_LSB, param & 0x7F);
+        sendMessage(status, CC_DATA_ENTRY_MSB, msb);
+        sendMessage(status, CC_DATA_ENTRY_LSB, lsb);
+    } else {
+        uint8_t cc = (mapping.analog_first_cc + index) & 0x1F;   // MSB controllers are 0-31
+        sendMessage(status, cc, msb);
+        sendMessage(status, cc + CC_LSB_OFFSET, lsb);
+    }
+
+    last_sent_values[index] = value14;
+}
+
+/*
+* Sends one 3-byte channel message to the open backend
+*/
+void MidiOutput::sendMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+    sent_count++;
+
+    if (backend == MidiBackend::TEXT_FILE) {
+        uint8_t type = status & 0xF0;
+        const char* name = (type == MIDI_NOTE_ON) ? "note_on" : (type == MIDI_NOTE_OFF) ? "note_off" : "cc";
+        fprintf(text_file, "%llu %02x %02x %02x %s ch=%d %d %d\n",
+                (unsigned long long)current_time_ms, status, data1, data2,
+                name, (status & 0x0F) + 1, data1, data2);
+        return;
+    }
+
+#ifdef HAVE_ALSA
+    if (backend == MidiBackend::ALSA) {
+        snd_seq_event_t event;
+        snd_seq_ev_clear(&event);
+        snd_seq_ev_set_source(&event, seq_port);
+        snd_seq_ev_set_subs(&event);
+        snd_seq_ev_set_direct(&event);
+
+        uint8_t channel = status & 0x0F;
+        switch (status & 0xF0) {
+            case MIDI_NOTE_ON:  snd_seq_ev_set_noteon(&event, channel, data1, data2); break;
+            case MIDI_NOTE_OFF: snd_seq_ev_set_noteoff(&event, channel, data1, data2); break;
+            default:            snd_seq_ev_set_controller(&event, channel, data1, data2); break;
+        }
+        snd_seq_event_output(seq, &event);   // Buffered, sent by flushOutput()
+    }
+#endif
+}
+
+/*
+* Pushes all buffered messages out (once per report/tick)
+*/
+void MidiOutput::flushOutput() {
+    if (backend == MidiBackend::TEXT_FILE) {
+        fflush(text_file);
+    }
+#ifdef HAVE_ALSA
+    if (backend == MidiBackend::ALSA) {
+        snd_seq_drain_output(seq);
+    }
+#endif
+}
+
+// =============================================================================
+// MAIN FUNCTIONS
+// =============================================================================
+
+/*
+* Sends all button changes of one report right away and queues analog changes
+* Buttons are never dropped, they take tokens from their channel like analog
+* updates (the bucket may go negative, delaying analog updates instead)
+*
+* @param input_report: The 22-byte input report from readInputReport()
+* @param now_ms: Current time in milliseconds
+*/
+void MidiOutput::processInputReport(const unsigned char* input_report, uint64_t now_ms) {
+    // Step 1: Check backend and buffer
+    if (backend == MidiBackend::NONE || input_report == nullptr) {
+        return;
+    }
+    refillTokens(now_ms);
+
+    // Step 2: Buttons (only changed bits, or all pressed buttons for the first report)
+    uint32_t button_mask = ButtonToggleSystem::getPressedButtonMask(input_report);
+    uint32_t changed_mask = has_last_state ? (button_mask ^ last_button_mask) : button_mask;
+    uint8_t button_channel = mapping.button_channel;
+
+    while (changed_mask != 0) {
+        int bit = std::countr_zero(changed_mask);
+        changed_mask &= changed_mask - 1;
+        bool pressed = (button_mask >> bit) & 1u;
+
+        if (bit < TOGGLE_BIT_SPECIAL_START) {
+            uint8_t note = (mapping.matrix_first_note + bit) & 0x7F;
+            sendMessage((pressed ? MIDI_NOTE_ON : MIDI_NOTE_OFF) | button_channel, note, pressed ? 127 : 0);
+        } else {
+            uint8_t cc = (mapping.button_first_cc + bit - TOGGLE_BIT_SPECIAL_START) & 0x7F;
+            sendMessage(MIDI_CONTROL_CHANGE | button_channel, cc, pressed ? 127 : 0);
+        }
+        channel_tokens[button_channel]--;
+    }
+    last_button_mask = button_mask;
+
+    // Step 3: Queue analog changes (12-bit raw scaled to full 14-bit range)
+    for (int i = 0; i < MIDI_ANALOG_COUNT; i++) {
+        uint16_t raw_value = (i < KNOB_COUNT)
+            ? knob_reader.getRawKnobValue(input_report, i + 1)
+            : fader_reader.getRawFaderValue(input_report, i - KNOB_COUNT + 1);
+        uint16_t value14 = (uint16_t)((raw_value << 2) | (raw_value >> 10));
+
+        bool is_pending = (pending_mask >> i) & 1u;
+        if (has_last_state && !is_pending && value14 == last_sent_values[i]) {
+            continue;
+        }
+        if (is_pending && value14 != pending_values[i]) {
+            coalesced_count++;
+        }
+        pending_values[i] = value14;
+        pending_mask |= 1u << i;
+    }
+    has_last_state = true;
+
+    // Step 4: Send what the rate limit allows
+    flushPendingAnalog();
+    flushOutput();
+}
+
+/*
+* Sends queued analog updates once tokens are available again
+*
+* @param now_ms: Current time in milliseconds
+*/
+void MidiOutput::tick(uint64_t now_ms) {
+    if (backend == MidiBackend::NONE || pending_mask == 0) {
+        return;
+    }
+    refillTokens(now_ms);
+    flushPendingAnalog();
+    flushOutput();
+}
+
+uint32_t MidiOutput::getSentCount() const {
+    return sent_count;
+}
+
+uint32_t MidiOutput::getCoalescedCount() const {
+    return coalesced_count;
+}
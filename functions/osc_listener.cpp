@@ -0,0 +1,360 @@
+#include "headers/osc_listener.h"   // Include header file
+
+#include <iostream>                 // For std::cout and std::cerr
+#include <cstring>                  // For memcpy, strcmp, strncmp, strlen, memchr
+#include <cstdlib>                  // For strtol
+#include <cerrno>                   // For errno
+#include <cmath>                    // For std::isfinite
+#include <unistd.h>                 // For ::close
+#include <netinet/in.h>             // For sockaddr_in
+#include <sys/socket.h>             // For socket, bind, recv, getsockname
+#include <arpa/inet.h>              // For ntohl, ntohs
+
+// =============================================================================
+// CONSTANTS - Names used in addresses
+// =============================================================================
+
+// Special/control button names (same names as the OSC output addresses)
+static const char* const SPECIAL_BUTTON_NAMES[5] = {"browse", "size", "type", "reverse", "shift"};
+static const SpecialLEDButton SPECIAL_BUTTONS[5] = {
+    SpecialLEDButton::BROWSE, SpecialLEDButton::SIZE, SpecialLEDButton::TYPE,
+    SpecialLEDButton::REVERSE, SpecialLEDButton::SHIFT
+};
+static const char* const CONTROL_BUTTON_NAMES[3] = {"capture", "quant", "sync"};
+static const ControlLEDButton CONTROL_BUTTONS[3] = {
+    ControlLEDButton::CAPTURE, ControlLEDButton::QUANT, ControlLEDButton::SYNC
+};
+static const StopLEDButton STOP_BUTTONS[4] = {
+    StopLEDButton::STOP1, StopLEDButton::STOP2, StopLEDButton::STOP3, StopLEDButton::STOP4
+};
+
+// =============================================================================
+// OSC PARSING HELPERS
+// =============================================================================
+
+/*
+* Reads a null-terminated, 4-byte padded OSC string
+*
+* @return: Padded length, or -1 if the string is not terminated inside the data
+*/
+static int readOscString(const unsigned char* data, int length, const char*& text) {
+    const void* end = memchr(data, 0, length);
+    if (end == nullptr) {
+        return -1;
+    }
+    int padded_length = (int)((const unsigned char*)end - data + 4) & ~3;
+    if (padded_length > length) {
+        return -1;
+    }
+    text = (const char*)data;
+    return padded_length;
+}
+
+static uint32_t readBigEndian32(const unsigned char* data) {
+    uint32_t value;
+    memcpy(&value, data, 4);
+    return ntohl(value);
+}
+
+// Number argument as float (int arguments are converted)
+static bool getNumberArgument(const OscArguments& args, int index, float& value) {
+    if (index >= args.count) return false;
+    if (args.types[index] == 'f') { value = args.floats[index]; return true; }
+    if (args.types[index] == 'i') { value = (float)args.ints[index]; return true; }
+    return false;
+}
+
+// Number argument as int (float arguments are rounded, NaN/inf or huge floats are rejected)
+static bool getIntArgument(const OscArguments& args, int index, int& value) {
+    float number;
+    if (!getNumberArgument(args, index, number)) return false;
+    if (!std::isfinite(number) || number < -OSC_MAX_INT_ARGUMENT || number > OSC_MAX_INT_ARGUMENT) return false;
+    value = (int)(number + (number < 0 ? -0.5f : 0.5f));
+    return true;
+}
+
+// Brightness argument 0.0-1.0 (NaN and out of range are rejected, same as the control socket)
+static bool getBrightnessArgument(const OscArguments& args, int index, float& value) {
+    if (!getNumberArgument(args, index, value)) return false;
+    return std::isfinite(value) && value >= 0.0f && value <= 1.0f;
+}
+
+// Parse "<number>" or "<number>/<number>" after an address prefix
+static int parseAddressNumbers(const char* text, int& first, int& second) {
+    char* end = nullptr;
+    first = (int)strtol(text, &end, 10);
+    if (end == text) return 0;
+    if (*end == '\0') return 1;
+    if (*end != '/') return 0;
+    const char* next = end + 1;
+    second = (int)strtol(next, &end, 10);
+    if (end == next || *end != '\0') return 0;
+    return 2;
+}
+
+// =============================================================================
+// OSC LISTENER - Setup
+// =============================================================================
+
+/*
+* Binds a non-blocking UDP socket on all interfaces
+*
+* @param port: UDP port to listen on
+* @return: true if the socket was bound successfully
+*/
+bool OscListener::initialize(int port) {
+    close();
+
+    // Step 1: Open non-blocking UDP socket
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        std::cerr << "OscListener Error: Cannot open UDP socket" << std::endl;
+        return false;
+    }
+
+    // Step 2: Bind to port
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t)port);
+    if (bind(fd, (const sockaddr*)&address, sizeof(address)) != 0) {
+        std::cerr << "OscListener Error: Cannot bind UDP port " << port << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    socket_fd = fd;
+    std::cout << "- OSC feedback input on UDP port " << port << std::endl;
+    return true;
+}
+
+void OscListener::close() {
+    if (socket_fd >= 0) {
+        ::close(socket_fd);
+        socket_fd = -1;
+    }
+}
+
+bool OscListener::isOpen() const {
+    return socket_fd >= 0;
+}
+
+int OscListener::getPort() const {
+    sockaddr_in address = {};
+    socklen_t length = sizeof(address);
+    if (socket_fd < 0 || getsockname(socket_fd, (sockaddr*)&address, &length) != 0) {
+        return -1;
+    }
+    return ntohs(address.sin_port);
+}
+
+uint32_t OscListener::getAppliedCount() const {
+    return applied_count;
+}
+
+uint32_t OscListener::getIgnoredCount() const {
+    return ignored_count;
+}
+
+// =============================================================================
+// OSC LISTENER - Receiving
+// =============================================================================
+
+/*
+* Reads all waiting packets (up to OSC_MAX_PACKETS_PER_POLL) and applies them
+* Call this inside beginLEDFrame()/endLEDFrame(), so a burst of feedback
+* messages results in at most one LED report per tick
+*
+* @param display: Display controller for /f1/display messages
+* @return: Number of applied messages
+*/
+int OscListener::poll(DisplayController& display) {
+    if (socket_fd < 0) {
+        return 0;
+    }
+
+    uint32_t applied_before = applied_count;
+
+    for (int i = 0; i < OSC_MAX_PACKETS_PER_POLL; i++) {
+        ssize_t length = recv(socket_fd, packet_buffer, sizeof(packet_buffer), MSG_TRUNC);
+        if (length < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "OscListener Error: recv failed (errno " << errno << ")" << std::endl;
+            }
+            break;
+        }
+        if (length > (ssize_t)sizeof(packet_buffer)) {
+            ignored_count++;  // Truncated
+            continue;
+        }
+        handlePacket(packet_buffer, (int)length, display, 0);
+    }
+
+    return (int)(applied_count - applied_before);
+}
+
+/*
+* Handles one packet: either a bundle (elements handled recursively) or a message
+* Time tags are ignored, everything is applied immediately
+*/
+void OscListener::handlePacket(const unsigned char* data, int length, DisplayController& display, int depth) {
+    // Step 1: Plain message
+    if (length < 8 || memcmp(data, "#bundle", 8) != 0) {
+        handleMessage(data, length, display);
+        return;
+    }
+
+    // Step 2: Bundle, skip header and time tag
+    if (depth >= OSC_MAX_BUNDLE_DEPTH || length < 16) {
+        ignored_count++;
+        return;
+    }
+    int position = 16;
+    while (position + 4 <= length) {
+        int element_size = (int)readBigEndian32(data + position);
+        position += 4;
+        if (element_size <= 0 || element_size > length - position || (element_size & 3) != 0) {
+            ignored_count++;
+            return;
+        }
+        handlePacket(data + position, element_size, display, depth + 1);
+        position += element_size;
+    }
+}
+
+/*
+* Parses address, type tags and arguments of one message
+*/
+void OscListener::handleMessage(const unsigned char* data, int length, DisplayController& display) {
+    // Step 1: Address
+    const char* address = nullptr;
+    int position = readOscString(data, length, address);
+    if (position < 0 || address[0] != '/') {
+        ignored_count++;
+        return;
+    }
+
+    // Step 2: Type tags (missing type tags = no arguments)
+    OscArguments args = {};
+    const char* type_tags = ",";
+    if (position < length) {
+        int tag_length = readOscString(data + position, length - position, type_tags);
+        if (tag_length < 0 || type_tags[0] != ',') {
+            ignored_count++;
+            return;
+        }
+        position += tag_length;
+    }
+
+    // Step 3: Arguments
+    for (const char* tag = type_tags + 1; *tag != '\0' && args.count < OSC_MAX_ARGUMENTS; tag++) {
+        int index = args.count;
+        if (*tag == 'i' || *tag == 'f') {
+            if (position + 4 > length) { ignored_count++; return; }
+            uint32_t bits = readBigEndian32(data + position);
+            position += 4;
+            if (*tag == 'i') {
+                args.ints[index] = (int32_t)bits;
+            } else {
+                memcpy(&args.floats[index], &bits, 4);
+            }
+        } else if (*tag == 's') {
+            int string_length = readOscString(data + position, length - position, args.strings[index]);
+            if (string_length < 0) { ignored_count++; return; }
+            position += string_length;
+        } else {
+            break;  // Unsupported type, ignore remaining arguments
+        }
+        args.types[index] = *tag;
+        args.count++;
+    }
+
+    // Step 4: Apply
+    if (applyMessage(address, args, display)) {
+        applied_count++;
+    } else {
+        ignored_count++;
+    }
+}
+
+// =============================================================================
+// OSC LISTENER - Applying messages
+// =============================================================================
+
+/*
+* Applies one message to the LED buffer or display
+* LED functions defer the report while an LED frame is open
+*
+* @return: false if the address is unknown or the arguments do not fit
+*/
+bool OscListener::applyMessage(const char* address, const OscArguments& args, DisplayController& display) {
+    int first = 0;
+    int second = 0;
+
+    // Matrix: /f1/led/matrix/<row>/<col> color [brightness]
+    if (strncmp(address, "/f1/led/matrix/", 15) == 0) {
+        MatrixPad pad;
+        // Out-of-range pads are only counted like every other bad message (no log per packet)
+        if (parseAddressNumbers(address + 15, first, second) != 2 || args.count < 1 ||
+            !MatrixPad::fromRowCol(first, second, pad)) {
+            return false;
+        }
+        LEDColor color;
+        if (args.types[0] == 's') {
+            if (!getLEDColorByName(args.strings[0], color)) return false;
+        } else {
+            int color_index;
+            if (!getIntArgument(args, 0, color_index) || color_index < 0 || color_index >= LED_COLOR_COUNT) return false;
+            color = (LEDColor)color_index;
+        }
+        float brightness = 1.0f;
+        if (args.count > 1 && !getBrightnessArgument(args, 1, brightness)) {
+            return false;
+        }
+        return setMatrixButtonLED(pad, color, brightness);
+    }
+
+    // Special/control buttons: /f1/led/button/<name> brightness
+    if (strncmp(address, "/f1/led/button/", 15) == 0) {
+        float brightness;
+        if (!getBrightnessArgument(args, 0, brightness)) return false;
+        const char* name = address + 15;
+        for (int i = 0; i < 5; i++) {
+            if (strcmp(name, SPECIAL_BUTTON_NAMES[i]) == 0) return setSpecialButtonLED(SPECIAL_BUTTONS[i], brightness);
+        }
+        for (int i = 0; i < 3; i++) {
+            if (strcmp(name, CONTROL_BUTTON_NAMES[i]) == 0) return setControlButtonLED(CONTROL_BUTTONS[i], brightness);
+        }
+        return false;
+    }
+
+    // Stop buttons: /f1/led/stop/<1-4> brightness
+    if (strncmp(address, "/f1/led/stop/", 13) == 0) {
+        float brightness;
+        if (parseAddressNumbers(address + 13, first, second) != 1 || first < 1 || first > 4) return false;
+        if (!getBrightnessArgument(args, 0, brightness)) return false;
+        return setStopButtonLED(STOP_BUTTONS[first - 1], brightness);
+    }
+
+    // Display
+    if (strcmp(address, "/f1/display/number") == 0) {
+        int number;
+        if (!getIntArgument(args, 0, number) || number < 1 || number > 99) return false;
+        display.setDisplayNumber(number);
+        return true;
+    }
+    if (strcmp(address, "/f1/display/text") == 0) {
+        if (args.count < 1 || args.types[0] != 's') return false;
+        display.setDisplayText(args.strings[0]);
+        return true;
+    }
+    if (strncmp(address, "/f1/display/dot/", 16) == 0) {
+        int on;
+        if (parseAddressNumbers(address + 16, first, second) != 1 || first < 1 || first > 2) return false;
+        if (!getIntArgument(args, 0, on)) return false;
+        display.setDisplayDot(first, on != 0);
+        return true;
+    }
+
+    return false;
+}
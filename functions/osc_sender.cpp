@@ -0,0 +1,319 @@
+#include "headers/osc_sender.h"     // Include header file
+
+#include <iostream>                 // For std::cerr
+#include <cstdio>                   // For snprintf
+#include <cstring>                  // For memcpy, strlen, strchr
+#include <cstdlib>                  // For strtol, abs
+#include <cerrno>                   // For errno
+#include <unistd.h>                 // For ::close
+#include <netdb.h>                  // For getaddrinfo
+#include <sys/socket.h>             // For socket, connect, send
+#include <arpa/inet.h>              // For htonl
+#include <bit>                      // For std::countr_zero
+
+// =============================================================================
+// CONSTANTS - Address names
+// =============================================================================
+
+// Names of special/control buttons, same order as their toggle bits (16-23)
+static const char* const SPECIAL_BUTTON_NAMES[5] = {"browse", "size", "type", "reverse", "shift"};
+static const char* const CONTROL_BUTTON_NAMES[3] = {"capture", "quant", "sync"};
+
+// =============================================================================
+// TARGET PARSING
+// =============================================================================
+
+/*
+* Parse an OSC target given as "host:port" or just "host"
+*
+* @param text: Target text, e.g. "127.0.0.1:9000"
+* @param host: Output buffer for the host name
+* @param host_size: Size of the host buffer
+* @param port: Output port (left unchanged if text has no port)
+* @return: true if the target is valid
+*/
+bool parseOscTarget(const char* text, char* host, int host_size, int& port) {
+    // Step 1: Check input
+    if (text == nullptr || host == nullptr || host_size <= 0) {
+        std::cerr << "parseOscTarget Error: Invalid arguments" << std::endl;
+        return false;
+    }
+
+    // Step 2: Split host and port
+    const char* colon = strchr(text, ':');
+    int host_length = colon ? (int)(colon - text) : (int)strlen(text);
+    if (host_length == 0 || host_length >= host_size) {
+        std::cerr << "parseOscTarget Error: Invalid host in '" << text << "'" << std::endl;
+        return false;
+    }
+
+    // Step 3: Parse port (1-65535)
+    if (colon) {
+        char* end = nullptr;
+        long value = strtol(colon + 1, &end, 10);
+        if (end == colon + 1 || *end != '\0' || value < 1 || value > 65535) {
+            std::cerr << "parseOscTarget Error: Invalid port in '" << text << "'" << std::endl;
+            return false;
+        }
+        port = (int)value;
+    }
+
+    memcpy(host, text, host_length);
+    host[host_length] = '\0';
+    return true;
+}
+
+// =============================================================================
+// OSC SENDER - Setup
+// =============================================================================
+
+/*
+* Opens a UDP socket connected to host:port and builds the address table
+* Sending never blocks: if the socket buffer is full the bundle is dropped
+*
+* @param host: Host name or IP address of the OSC receiver
+* @param port: UDP port of the OSC receiver
+* @param device_number: Address prefix /f<n> (1 for the first F1, 2 for the second, ...)
+* @return: true if the socket was opened successfully
+*/
+bool OscSender::initialize(const char* host, int port, int device_number) {
+    // Step 1: Close previous socket and reset state
+    close();
+    buildAddressTable(device_number);
+    has_last_state = false;
+
+    // Step 2: Resolve host (IPv4 or IPv6, UDP)
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    char port_text[8];
+    snprintf(port_text, sizeof(port_text), "%d", port);
+
+    addrinfo* result = nullptr;
+    int error = getaddrinfo(host, port_text, &hints, &result);
+    if (error != 0) {
+        std::cerr << "OscSender Error: Cannot resolve " << host << ": " << gai_strerror(error) << std::endl;
+        return false;
+    }
+
+    // Step 3: Open and connect socket (connect only fixes the target for send())
+    for (addrinfo* entry = result; entry != nullptr; entry = entry->ai_next) {
+        int fd = socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (connect(fd, entry->ai_addr, entry->ai_addrlen) == 0) {
+            socket_fd = fd;
+            break;
+        }
+        ::close(fd);
+    }
+    freeaddrinfo(result);
+
+    if (socket_fd < 0) {
+        std::cerr << "OscSender Error: Cannot open UDP socket to " << host << ":" << port << std::endl;
+        return false;
+    }
+
+    std::cout << "- OSC output to " << host << ":" << port << " (/f" << device_number << "/...)" << std::endl;
+    return true;
+}
+
+void OscSender::close() {
+    if (socket_fd >= 0) {
+        ::close(socket_fd);
+        socket_fd = -1;
+    }
+}
+
+bool OscSender::isOpen() const {
+    return socket_fd >= 0;
+}
+
+void OscSender::resendAll() {
+    has_last_state = false;
+}
+
+/*
+* Builds the preformatted address of every control
+* Order matches last_analog_values (knobs, faders) and the toggle bit layout (buttons)
+*
+* @param device_number: Number in the address prefix (/f1, /f2, ...)
+*/
+void OscSender::buildAddressTable(int device_number) {
+    char text[OSC_ADDRESS_SIZE];
+
+    // Knobs and faders
+    for (int i = 0; i < KNOB_COUNT; i++) {
+        snprintf(text, sizeof(text), "/f%d/knob/%d", device_number, i + 1);
+        setAddress(analog_addresses[i], text);
+    }
+    for (int i = 0; i < FADER_COUNT; i++) {
+        snprintf(text, sizeof(text), "/f%d/fader/%d", device_number, i + 1);
+        setAddress(analog_addresses[KNOB_COUNT + i], text);
+    }
+
+    // Matrix buttons (bits 0-15)
+    for (int i = 0; i < MATRIX_PAD_COUNT; i++) {
+        MatrixPad pad = MatrixPad::fromIndex(i);
+        snprintf(text, sizeof(text), "/f%d/matrix/%d/%d", device_number, pad.row(), pad.col());
+        setAddress(button_addresses[ButtonToggleSystem::getMatrixButtonBit(pad)], text);
+    }
+
+    // Special and control buttons (bits 16-23)
+    for (int i = 0; i < 5; i++) {
+        snprintf(text, sizeof(text), "/f%d/button/%s", device_number, SPECIAL_BUTTON_NAMES[i]);
+        setAddress(button_addresses[TOGGLE_BIT_SPECIAL_START + i], text);
+    }
+    for (int i = 0; i < 3; i++) {
+        snprintf(text, sizeof(text), "/f%d/button/%s", device_number, CONTROL_BUTTON_NAMES[i]);
+        setAddress(button_addresses[TOGGLE_BIT_CONTROL_START + i], text);
+    }
+
+    // Stop buttons (bits 24-27)
+    for (int i = 0; i < 4; i++) {
+        snprintf(text, sizeof(text), "/f%d/stop/%d", device_number, i + 1);
+        setAddress(button_addresses[TOGGLE_BIT_STOP_START + i], text);
+    }
+}
+
+/*
+* Stores an address zero-padded to the next multiple of 4 (OSC string rule:
+* at least one null byte, total length divisible by 4)
+*/
+void OscSender::setAddress(OscAddress& address, const char* text) {
+    memset(address.text, 0, sizeof(address.text));
+    int length = (int)strlen(text);
+    if (length > OSC_ADDRESS_SIZE - 1) {
+        length = OSC_ADDRESS_SIZE - 1;
+    }
+    memcpy(address.text, text, length);
+    address.padded_length = (length + 4) & ~3;
+}
+
+// =============================================================================
+// OSC SENDER - Bundles
+// =============================================================================
+
+/*
+* Starts a new bundle: "#bundle\0" followed by the time tag 1 (= immediately)
+*/
+void OscSender::beginBundle() {
+    static const unsigned char BUNDLE_HEADER[OSC_BUNDLE_HEADER_SIZE] = {
+        '#', 'b', 'u', 'n', 'd', 'l', 'e', 0,
+        0, 0, 0, 0, 0, 0, 0, 1
+    };
+    memcpy(bundle_buffer, BUNDLE_HEADER, OSC_BUNDLE_HEADER_SIZE);
+    bundle_length = OSC_BUNDLE_HEADER_SIZE;
+    bundle_message_count = 0;
+}
+
+/*
+* Appends one message with a single 32-bit argument to the bundle
+* Layout: int32 size, address, type tag string ",f\0\0" / ",i\0\0", big-endian argument
+*/
+void OscSender::appendMessage(const OscAddress& address, char type_tag, uint32_t argument_bits) {
+    int message_size = address.padded_length + 4 + 4;
+    if (bundle_length + 4 + message_size > OSC_BUNDLE_MAX_SIZE) {
+        return;  // Cannot happen with the table sizes above
+    }
+
+    unsigned char* out = bundle_buffer + bundle_length;
+
+    uint32_t size_be = htonl((uint32_t)message_size);
+    memcpy(out, &size_be, 4);
+    out += 4;
+
+    memcpy(out, address.text, address.padded_length);
+    out += address.padded_length;
+
+    out[0] = ',';
+    out[1] = (unsigned char)type_tag;
+    out[2] = 0;
+    out[3] = 0;
+    out += 4;
+
+    uint32_t argument_be = htonl(argument_bits);
+    memcpy(out, &argument_be, 4);
+
+    bundle_length += 4 + message_size;
+    bundle_message_count++;
+}
+
+void OscSender::appendFloat(const OscAddress& address, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    appendMessage(address, 'f', bits);
+}
+
+void OscSender::appendInt(const OscAddress& address, int32_t value) {
+    appendMessage(address, 'i', (uint32_t)value);
+}
+
+/*
+* Sends the bundle without blocking
+* A missing receiver (connection refused) or a full socket buffer drops the
+* bundle silently, so the controller keeps working without visuals running
+*
+* @return: false on any other send error
+*/
+bool OscSender::sendBundle() {
+    ssize_t sent = send(socket_fd, bundle_buffer, bundle_length, MSG_DONTWAIT);
+    if (sent < 0) {
+        if (errno == ECONNREFUSED || errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        }
+        std::cerr << "OscSender Error: send failed (errno " << errno << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Compares the report against the last sent state and sends all changes as one bundle
+* Nothing is sent if nothing changed
+*
+* @param input_report: The 22-byte input report from readInputReport()
+* @return: false only if sending failed
+*/
+bool OscSender::sendInputChanges(const unsigned char* input_report) {
+    // Step 1: Check socket and buffer
+    if (socket_fd < 0 || input_report == nullptr) {
+        return true;
+    }
+
+    beginBundle();
+
+    // Step 2: Knobs and faders (raw 12-bit compare with a small deadband, sent as 0.0-1.0)
+    // The ends of the range are always sent, so 0.0 and 1.0 stay reachable
+    for (int i = 0; i < OSC_ANALOG_COUNT; i++) {
+        uint16_t raw_value = (i < KNOB_COUNT)
+            ? knob_reader.getRawKnobValue(input_report, i + 1)
+            : fader_reader.getRawFaderValue(input_report, i - KNOB_COUNT + 1);
+
+        int change = abs((int)raw_value - (int)last_analog_values[i]);
+        bool at_end = raw_value == 0 || raw_value == KNOB_RAW_MAX;
+        if (!has_last_state || change >= OSC_ANALOG_RAW_THRESHOLD || (change != 0 && at_end)) {
+            appendFloat(analog_addresses[i], (float)raw_value / (float)KNOB_RAW_MAX);
+            last_analog_values[i] = raw_value;
+        }
+    }
+
+    // Step 3: Buttons (only changed bits, or all bits for the first report)
+    uint32_t button_mask = ButtonToggleSystem::getPressedButtonMask(input_report);
+    uint32_t changed_mask = has_last_state ? (button_mask ^ last_button_mask) : ((1u << OSC_BUTTON_COUNT) - 1);
+    while (changed_mask != 0) {
+        int bit = std::countr_zero(changed_mask);
+        changed_mask &= changed_mask - 1;
+        appendInt(button_addresses[bit], (button_mask >> bit) & 1u);
+    }
+    last_button_mask = button_mask;
+    has_last_state = true;
+
+    // Step 4: Send bundle if anything changed
+    if (bundle_message_count == 0) {
+        return true;
+    }
+    return sendBundle();
+}
@@ -0,0 +1,145 @@
+#include "headers/realtime.h"           // Include header file
+
+#include <iostream>                     // For std::cout
+#include <sstream>                      // For std::ostringstream (one log line per thread)
+#include <cstring>                      // For strerror, memset
+#include <cstdlib>                      // For strtol
+#include <cerrno>                       // For errno
+#include <pthread.h>                    // For pthread_setschedparam, pthread_setaffinity_np
+#include <sched.h>                      // For SCHED_FIFO, cpu_set_t
+#include <sys/mman.h>                   // For mlockall
+#ifdef __linux__
+#include <malloc.h>                     // For mallopt
+#endif
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+/*
+* Parses a comma-separated CPU list
+*
+* @param text: CPU numbers, e.g. "2,3"
+* @param config: Receives cpus and cpu_count
+* @return: false if the list is empty, has invalid numbers or more than RT_MAX_CPUS entries
+*/
+bool parseCpuList(const char* text, RealtimeConfig& config) {
+    int count = 0;
+    const char* cursor = text;
+    while (*cursor != '\0') {
+        char* end = nullptr;
+        long cpu = strtol(cursor, &end, 10);
+        if (end == cursor || cpu < 0 || cpu > 1023 || count >= RT_MAX_CPUS) {
+            return false;
+        }
+        config.cpus[count++] = (int)cpu;
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return false;
+        }
+        cursor = end;
+    }
+    if (count == 0) {
+        return false;
+    }
+    config.cpu_count = count;
+    return true;
+}
+
+// =============================================================================
+// PROCESS - Locked memory
+// =============================================================================
+
+/*
+* Locks all pages of the process in RAM, also the ones mapped later (thread stacks)
+* mlockall(MCL_CURRENT) also faults in every page mapped so far, so buffers
+* allocated before this call (device contexts, packets, shared memory) are prefaulted.
+*
+* @return: true if memory is locked
+*/
+bool lockProcessMemory() {
+    // Step 1: Keep freed heap memory in the process (no trim/mmap = no new page faults later)
+#ifdef __linux__
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+
+    // Step 2: Lock current and future pages
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        std::cout << "- Real-time: memory not locked (" << strerror(errno)
+                  << ", needs CAP_IPC_LOCK or a higher memlock limit)" << std::endl;
+        return false;
+    }
+    std::cout << "- Real-time: memory locked" << std::endl;
+    return true;
+}
+
+// =============================================================================
+// THREAD - Pinning, priority, stack
+// =============================================================================
+
+/*
+* Touches the next RT_STACK_PREFAULT_SIZE bytes of the stack, so they are mapped before the loop runs
+*/
+static unsigned char prefaultStack() {
+    volatile unsigned char stack_pages[RT_STACK_PREFAULT_SIZE];
+    for (int i = 0; i < RT_STACK_PREFAULT_SIZE; i += 4096) {
+        stack_pages[i] = 0;
+    }
+    return stack_pages[0];      // Volatile read, keeps the writes
+}
+
+/*
+* Applies the real-time settings to the calling thread and prints one line with the result
+*
+* @param config: Real-time configuration (--rt, --rt-priority, --rt-cpus)
+* @param thread_index: 0-based thread number, picks the CPU from the list
+* @param thread_name: Name in the log line and in top/htop (Linux)
+* @return: true if SCHED_FIFO was applied
+*/
+bool applyRealtimeToThread(const RealtimeConfig& config, int thread_index, const char* thread_name) {
+    pthread_t thread = pthread_self();
+    std::ostringstream line;
+    line << "- Real-time " << thread_name << ":";
+#ifdef __linux__
+    pthread_setname_np(thread, thread_name);    // Shown in top/htop (at most 15 characters)
+#endif
+
+    // Step 1: Pin to the chosen CPU
+    if (config.cpu_count > 0) {
+        int cpu = config.cpus[thread_index % config.cpu_count];
+#ifdef __linux__
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        int result = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+        if (result == 0) {
+            line << " CPU " << cpu << ",";
+        } else {
+            line << " CPU " << cpu << " not pinned (" << strerror(result) << "),";
+        }
+#else
+        line << " CPU " << cpu << " not pinned (not supported on this platform),";
+#endif
+    }
+
+    // Step 2: Raise to SCHED_FIFO
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = config.priority;
+    int result = pthread_setschedparam(thread, SCHED_FIFO, &param);
+    if (result == 0) {
+        line << " SCHED_FIFO priority " << config.priority << ",";
+    } else {
+        line << " normal priority (SCHED_FIFO: " << strerror(result)
+             << ", needs CAP_SYS_NICE or an rtprio limit),";
+    }
+
+    // Step 3: Map the stack before the loop needs it
+    prefaultStack();
+    line << " stack prefaulted" << std::endl;
+    std::cout << line.str();
+    std::cout.flush();
+    return result == 0;
+}
@@ -43,11 +43,11 @@ void startupSequence(hid_device* device) {
     // =============================================================================
     
     // Step 1: Start with single LED at (4,4) - dim green
-    setMatrixButtonLED(4, 4, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({4, 4}, LEDColor::green, 0.5f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 2:
-    setMatrixButtonLED(4, 4, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({4, 4}, LEDColor::green, 1.0f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // =============================================================================
@@ -55,13 +55,13 @@ void startupSequence(hid_device* device) {
     // =============================================================================
     
     // Step 3:
-    setMatrixButtonLED(3, 4, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(4, 3, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({3, 4}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({4, 3}, LEDColor::green, 0.5f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 4:
-    setMatrixButtonLED(3, 4, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(4, 3, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({3, 4}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({4, 3}, LEDColor::green, 1.0f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // =============================================================================
@@ -69,17 +69,17 @@ void startupSequence(hid_device* device) {
     // =============================================================================
     
     // Step 5:
-    setMatrixButtonLED(4, 4, LEDColor::green, 0.5f, false);  // Fade corner
-    setMatrixButtonLED(2, 4, LEDColor::green, 0.5f, false);  // New LEDs dim
-    setMatrixButtonLED(3, 3, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(4, 2, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({4, 4}, LEDColor::green, 0.5f, false);  // Fade corner
+    setMatrixButtonLED({2, 4}, LEDColor::green, 0.5f, false);  // New LEDs dim
+    setMatrixButtonLED({3, 3}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({4, 2}, LEDColor::green, 0.5f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 6:
-    setMatrixButtonLED(4, 4, LEDColor::black, 0.0f, false); // Turn off
-    setMatrixButtonLED(2, 4, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(3, 3, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(4, 2, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({4, 4}, LEDColor::black, 0.0f, false); // Turn off
+    setMatrixButtonLED({2, 4}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({3, 3}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({4, 2}, LEDColor::green, 1.0f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // =============================================================================
@@ -87,21 +87,21 @@ void startupSequence(hid_device* device) {
     // =============================================================================
     
     // Step 7:
-    setMatrixButtonLED(3, 4, LEDColor::green, 0.5f, false);  // Fade second diagonal
-    setMatrixButtonLED(4, 3, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(1, 4, LEDColor::green, 0.5f, false);  // New main diagonal dim
-    setMatrixButtonLED(2, 3, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(3, 2, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(4, 1, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({3, 4}, LEDColor::green, 0.5f, false);  // Fade second diagonal
+    setMatrixButtonLED({4, 3}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({1, 4}, LEDColor::green, 0.5f, false);  // New main diagonal dim
+    setMatrixButtonLED({2, 3}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({3, 2}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({4, 1}, LEDColor::green, 0.5f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 8:
-    setMatrixButtonLED(3, 4, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(4, 3, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(1, 4, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(2, 3, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(3, 2, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(4, 1, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({3, 4}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({4, 3}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({1, 4}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({2, 3}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({3, 2}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({4, 1}, LEDColor::green, 1.0f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // =============================================================================
@@ -109,21 +109,21 @@ void startupSequence(hid_device* device) {
     // =============================================================================
     
     // Step 9:
-    setMatrixButtonLED(2, 4, LEDColor::green, 0.5f, false);  // Fade third diagonal
-    setMatrixButtonLED(3, 3, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(4, 2, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(1, 3, LEDColor::green, 0.5f, false);  // New fifth diagonal dim
-    setMatrixButtonLED(2, 2, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(3, 1, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({2, 4}, LEDColor::green, 0.5f, false);  // Fade third diagonal
+    setMatrixButtonLED({3, 3}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({4, 2}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({1, 3}, LEDColor::green, 0.5f, false);  // New fifth diagonal dim
+    setMatrixButtonLED({2, 2}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({3, 1}, LEDColor::green, 0.5f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 10:
-    setMatrixButtonLED(2, 4, LEDColor::black, 0.0f, false);  // Turn off third diagonal
-    setMatrixButtonLED(3, 3, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(4, 2, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(1, 3, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(2, 2, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(3, 1, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({2, 4}, LEDColor::black, 0.0f, false);  // Turn off third diagonal
+    setMatrixButtonLED({3, 3}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({4, 2}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({1, 3}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({2, 2}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({3, 1}, LEDColor::green, 1.0f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // =============================================================================
@@ -131,21 +131,21 @@ void startupSequence(hid_device* device) {
     // =============================================================================
     
     // Step 11:
-    setMatrixButtonLED(1, 4, LEDColor::green, 0.5f, false);  // Fade main diagonal
-    setMatrixButtonLED(2, 3, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(3, 2, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(4, 1, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(1, 2, LEDColor::green, 0.5f, false);  // New sixth diagonal dim
-    setMatrixButtonLED(2, 1, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({1, 4}, LEDColor::green, 0.5f, false);  // Fade main diagonal
+    setMatrixButtonLED({2, 3}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({3, 2}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({4, 1}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({1, 2}, LEDColor::green, 0.5f, false);  // New sixth diagonal dim
+    setMatrixButtonLED({2, 1}, LEDColor::green, 0.5f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 12:
-    setMatrixButtonLED(1, 4, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(2, 3, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(3, 2, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(4, 1, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(1, 2, LEDColor::green, 1.0f, false);
-    setMatrixButtonLED(2, 1, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({1, 4}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({2, 3}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({3, 2}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({4, 1}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({1, 2}, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({2, 1}, LEDColor::green, 1.0f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // =============================================================================
@@ -153,17 +153,17 @@ void startupSequence(hid_device* device) {
     // =============================================================================
     
     // Step 13:
-    setMatrixButtonLED(1, 3, LEDColor::green, 0.5f, false);  // Fade fifth diagonal
-    setMatrixButtonLED(2, 2, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(3, 1, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(1, 1, LEDColor::green, 0.5f, false);  // Final corner dim
+    setMatrixButtonLED({1, 3}, LEDColor::green, 0.5f, false);  // Fade fifth diagonal
+    setMatrixButtonLED({2, 2}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({3, 1}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({1, 1}, LEDColor::green, 0.5f, false);  // Final corner dim
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 14:
-    setMatrixButtonLED(1, 3, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(2, 2, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(3, 1, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(1, 1, LEDColor::green, 1.0f, false);
+    setMatrixButtonLED({1, 3}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({2, 2}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({3, 1}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({1, 1}, LEDColor::green, 1.0f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // =============================================================================
@@ -171,21 +171,21 @@ void startupSequence(hid_device* device) {
     // =============================================================================
     
     // Step 15:
-    setMatrixButtonLED(1, 2, LEDColor::green, 0.5f, false);
-    setMatrixButtonLED(2, 1, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({1, 2}, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({2, 1}, LEDColor::green, 0.5f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 16:
-    setMatrixButtonLED(1, 2, LEDColor::black, 0.0f, false);
-    setMatrixButtonLED(2, 1, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({1, 2}, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({2, 1}, LEDColor::black, 0.0f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
     
     // Step 17: Final fade - corner dims
-    setMatrixButtonLED(1, 1, LEDColor::green, 0.5f, false);
+    setMatrixButtonLED({1, 1}, LEDColor::green, 0.5f, false);
     std::this_thread::sleep_for(std::chrono::milliseconds(step_delay_ms));
 
     // Step 18: Final fade - all dims
-    setMatrixButtonLED(1, 1, LEDColor::black, 0.0f, false);
+    setMatrixButtonLED({1, 1}, LEDColor::black, 0.0f, false);
 
     // =============================================================================
     // FINAL STATE: Turn on all LEDs at specified brightness
@@ -0,0 +1,218 @@
+#include "headers/state_publisher.h"    // Include header file
+
+#include <iostream>                     // For std::cout and std::cerr
+#include <cstring>                      // For memcpy, strlen
+#include <fcntl.h>                      // For O_* flags
+#include <unistd.h>                     // For ftruncate, ::close
+#include <sys/mman.h>                   // For shm_open, mmap
+
+// =============================================================================
+// STATE PUBLISHER - Setup
+// =============================================================================
+
+/*
+* Creates or reuses a POSIX shared memory segment and maps it read/write
+* Readers map it with openStateSegment() using the same name
+*
+* @param name: Shared memory name, must start with '/'
+* @return: true if the segment is mapped
+*/
+bool StatePublisher::open(const char* name) {
+    close();
+
+    // Step 1: Check name
+    if (name == nullptr || name[0] != '/' || strlen(name) >= sizeof(shm_name)) {
+        std::cerr << "StatePublisher Error: Invalid shared memory name" << std::endl;
+        return false;
+    }
+
+    // Step 2: Create segment and set its size
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "StatePublisher Error: Cannot open shared memory " << name << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, sizeof(SharedStateSegment)) != 0) {
+        std::cerr << "StatePublisher Error: Cannot resize shared memory " << name << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    // Step 3: Map it (the mapping stays valid after closing the descriptor)
+    void* memory = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "StatePublisher Error: Cannot map shared memory " << name << std::endl;
+        return false;
+    }
+
+    // Step 4: Initialize header, or continue the sequence of a previous run
+    // (readers that are still attached keep working; an odd leftover from a crash is made even)
+    segment = (SharedStateSegment*)memory;
+    if (segment->magic == STATE_SHM_MAGIC && segment->version == STATE_SHM_VERSION) {
+        uint32_t sequence = segment->sequence.load(std::memory_order_relaxed);
+        segment->sequence.store((sequence + 1) & ~1u, std::memory_order_release);
+    } else {
+        segment->magic = 0;
+        segment->sequence.store(0, std::memory_order_relaxed);
+        segment->state = {};
+        segment->version = STATE_SHM_VERSION;
+        segment->reserved = 0;
+        std::atomic_thread_fence(std::memory_order_release);
+        segment->magic = STATE_SHM_MAGIC;
+    }
+
+    memcpy(shm_name, name, strlen(name) + 1);
+    owns_shm_name = true;
+    std::cout << "- Controller state published in shared memory " << name << std::endl;
+    return true;
+}
+
+/*
+* Uses an anonymous private mapping instead of a named segment
+* Same seqlock behavior, only visible inside this process
+*
+* @return: true if the segment is mapped
+*/
+bool StatePublisher::openInProcess() {
+    close();
+
+    void* memory = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "StatePublisher Error: Cannot map in-process state segment" << std::endl;
+        return false;
+    }
+
+    segment = (SharedStateSegment*)memory;  // Anonymous memory is zeroed
+    segment->version = STATE_SHM_VERSION;
+    segment->magic = STATE_SHM_MAGIC;
+    return true;
+}
+
+/*
+* Unmaps the segment and removes its name (open readers keep their mapping)
+*/
+void StatePublisher::close() {
+    if (segment != nullptr) {
+        munmap(segment, sizeof(SharedStateSegment));
+        segment = nullptr;
+    }
+    if (owns_shm_name) {
+        shm_unlink(shm_name);
+        owns_shm_name = false;
+    }
+}
+
+bool StatePublisher::isOpen() const {
+    return segment != nullptr;
+}
+
+const SharedStateSegment* StatePublisher::getSegment() const {
+    return segment;
+}
+
+// =============================================================================
+// STATE PUBLISHER - Writing
+// =============================================================================
+
+/*
+* Publishes one snapshot under the seqlock
+* Single writer only (the main loop); never waits for readers
+*
+* @param state: Snapshot to publish
+*/
+void StatePublisher::publish(const ControllerState& state) {
+    if (segment == nullptr) {
+        return;
+    }
+
+    // Step 1: Mark write in progress (odd sequence)
+    uint32_t sequence = segment->sequence.load(std::memory_order_relaxed);
+    segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Step 2: Write snapshot
+    memcpy(&segment->state, &state, sizeof(ControllerState));
+
+    // Step 3: Mark stable again (next even sequence)
+    segment->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// =============================================================================
+// STATE READER
+// =============================================================================
+
+/*
+* Maps an existing state segment read-only
+*
+* @param name: Shared memory name used by the publisher
+* @return: Segment pointer, nullptr if missing or incompatible
+*/
+const SharedStateSegment* openStateSegment(const char* name) {
+    // Step 1: Open existing segment
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        std::cerr << "openStateSegment Error: Shared memory " << name << " not found" << std::endl;
+        return nullptr;
+    }
+
+    // Step 2: Map read-only
+    void* memory = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "openStateSegment Error: Cannot map shared memory " << name << std::endl;
+        return nullptr;
+    }
+
+    // Step 3: Check header
+    const SharedStateSegment* segment = (const SharedStateSegment*)memory;
+    if (segment->magic != STATE_SHM_MAGIC || segment->version != STATE_SHM_VERSION) {
+        std::cerr << "openStateSegment Error: Shared memory " << name << " has an unknown layout" << std::endl;
+        munmap(memory, sizeof(SharedStateSegment));
+        return nullptr;
+    }
+    return segment;
+}
+
+void closeStateSegment(const SharedStateSegment* segment) {
+    if (segment != nullptr) {
+        munmap((void*)segment, sizeof(SharedStateSegment));
+    }
+}
+
+/*
+* Copies a consistent snapshot (seqlock read side)
+* Does not write to the segment, so any number of readers can run in parallel
+*
+* @param segment: Segment from openStateSegment() or StatePublisher::getSegment()
+* @param out: Receives the snapshot
+* @param sequence_out: Optional, receives the sequence of the copied snapshot (changes with every publish)
+* @return: true if a consistent snapshot was copied
+*/
+bool readState(const SharedStateSegment* segment, ControllerState& out, uint32_t* sequence_out) {
+    if (segment == nullptr) {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < STATE_READ_MAX_RETRIES; attempt++) {
+        // Step 1: Wait for a stable sequence
+        uint32_t before = segment->sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;  // Write in progress
+        }
+
+        // Step 2: Copy snapshot
+        memcpy(&out, (const void*)&segment->state, sizeof(ControllerState));
+
+        // Step 3: Check that no write happened during the copy
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t after = segment->sequence.load(std::memory_order_relaxed);
+        if (before == after) {
+            if (sequence_out != nullptr) {
+                *sequence_out = after;
+            }
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,18 @@
+#include "headers/tick_clock.h"     // Include header file
+
+#include <chrono>                   // For std::chrono::steady_clock
+
+// =============================================================================
+// TICK CLOCK
+// =============================================================================
+
+/*
+* Returns monotonic time in milliseconds
+* Uses steady_clock, so it never jumps when the system time changes
+*
+* @return: Milliseconds since an unspecified starting point
+*/
+uint64_t getTickTimeMs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
@@ -0,0 +1,233 @@
+#include "headers/trace_recorder.h"    // Include header file
+
+#include <iostream>                     // For std::cout and std::cerr
+#include <cstdio>                       // For fopen, fprintf, rename
+#include <cstring>                      // For strncpy
+#include <csignal>                      // For SIGUSR2
+#include <mutex>                        // For std::mutex (one file write at a time)
+#include <thread>                       // For the writer thread
+#include <unistd.h>                     // For getpid
+
+// =============================================================================
+// STATE
+// =============================================================================
+
+constinit thread_local TraceRing* trace_ring = nullptr;
+
+static TraceRing* trace_rings[TRACE_MAX_THREADS];
+static std::atomic<int> trace_ring_count{0};
+static std::atomic<bool> trace_enabled{false};
+static uint32_t trace_capacity = 0;
+static uint64_t trace_start_ns = 0;
+static char trace_path[512];
+
+// Requests from the signal handler, served by the writer thread
+static std::atomic<bool> trace_snapshot_requested{false};
+static std::atomic<bool> trace_writer_running{false};
+static std::thread trace_writer_thread;
+static std::mutex trace_file_mutex;
+
+static const char* const TRACE_NAMES[(int)TraceName::COUNT] = {
+    "hid_read",
+    "decode",
+    "toggle_handling",
+    "scene_load",
+    "led_write",
+    "button_press",
+    "button_release",
+    "page_change"
+};
+
+// =============================================================================
+// SIGNALS AND WRITER THREAD
+// =============================================================================
+
+static void handleTraceSignal(int) {
+    trace_snapshot_requested.store(true, std::memory_order_relaxed);
+}
+
+/*
+* Writes the file when asked to, so device threads never wait for file I/O
+* Ctrl+C / SIGTERM end the device loops in main, whose cleanup calls stopTraceRecorder()
+*/
+static void runTraceWriter() {
+    while (trace_writer_running.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(TRACE_WRITER_POLL_MS));
+        if (trace_snapshot_requested.exchange(false, std::memory_order_relaxed)) {
+            writeTraceFile();
+        }
+    }
+}
+
+// =============================================================================
+// SETUP
+// =============================================================================
+
+/*
+* Enables tracing
+*
+* @param path: Output file (Chrome trace-event JSON)
+* @param events_per_thread: Ring size per thread (rounded up to a power of two)
+* @return: false if already started or the path is invalid
+*/
+bool startTraceRecorder(const char* path, int events_per_thread) {
+    // Step 1: Check arguments
+    if (trace_enabled.load() || path == nullptr || path[0] == '\0' || strlen(path) >= sizeof(trace_path)) {
+        std::cerr << "TraceRecorder Error: Invalid trace file path" << std::endl;
+        return false;
+    }
+    strncpy(trace_path, path, sizeof(trace_path) - 1);
+
+    // Step 2: Ring size (power of two, so the slot is index & (capacity - 1))
+    trace_capacity = 1;
+    while (trace_capacity < (uint32_t)events_per_thread && trace_capacity < (1u << 24)) {
+        trace_capacity <<= 1;
+    }
+    trace_start_ns = getTraceClockNs();
+
+    // Step 3: Writer thread and signals
+    trace_writer_running.store(true);
+    trace_writer_thread = std::thread(runTraceWriter);
+    signal(SIGUSR2, handleTraceSignal);
+    trace_enabled.store(true);
+
+    std::cout << "- Tracing to " << trace_path << " (" << trace_capacity << " events per thread), kill -USR2 "
+              << getpid() << " writes a snapshot, Ctrl+C writes it and exits" << std::endl;
+    return true;
+}
+
+/*
+* Gives the calling thread its ring (allocated here, never on the hot path)
+*
+* @param thread_name: Shown as the track name in the trace viewer
+*/
+void registerTraceThread(const char* thread_name) {
+    if (!trace_enabled.load() || trace_ring != nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(trace_file_mutex);
+    int index = trace_ring_count.load(std::memory_order_relaxed);
+    if (index >= TRACE_MAX_THREADS) {
+        std::cerr << "TraceRecorder Error: Too many threads, " << thread_name << " is not traced" << std::endl;
+        return;
+    }
+
+    TraceRing* ring = new TraceRing();
+    ring->thread_index = index + 1;
+    strncpy(ring->thread_name, thread_name, sizeof(ring->thread_name) - 1);
+    ring->capacity = trace_capacity;
+    ring->events = new TraceEvent[trace_capacity]();
+
+    // Publish the ring, then count it (the writer only reads counted slots)
+    trace_rings[index] = ring;
+    trace_ring_count.store(index + 1, std::memory_order_release);
+    trace_ring = ring;
+}
+
+// =============================================================================
+// EXPORT
+// =============================================================================
+
+/*
+* Writes one event as a Chrome trace-event object
+*/
+static void writeTraceEvent(FILE* file, const TraceEvent& event, int thread_index, int pid, bool& first) {
+    double timestamp_us = (double)(int64_t)(event.timestamp_ns - trace_start_ns) / 1000.0;
+    fprintf(file, "%s\n{\"name\":\"%s\",\"cat\":\"f1\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f",
+            first ? "" : ",", TRACE_NAMES[(int)event.name], pid, thread_index, timestamp_us);
+    if (event.phase == TracePhase::SPAN) {
+        fprintf(file, ",\"ph\":\"X\",\"dur\":%.3f", event.duration_ns / 1000.0);
+    } else {
+        fprintf(file, ",\"ph\":\"i\",\"s\":\"t\"");
+    }
+    if (event.value >= 0) {
+        fprintf(file, ",\"args\":{\"value\":%d}", event.value);
+    }
+    fprintf(file, "}");
+    first = false;
+}
+
+/*
+* Copies every ring and writes all events as Chrome trace-event JSON
+* Rings keep recording meanwhile: events that were overwritten while copying are dropped.
+* The file is written next to the target and renamed, so viewers never see half a file.
+*
+* @return: false if the file could not be written
+*/
+bool writeTraceFile() {
+    if (!trace_enabled.load()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(trace_file_mutex);
+
+    // Step 1: Open temporary file
+    char temp_path[sizeof(trace_path) + 8];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", trace_path);
+    FILE* file = fopen(temp_path, "w");
+    if (file == nullptr) {
+        std::cerr << "TraceRecorder Error: Cannot write " << temp_path << std::endl;
+        return false;
+    }
+
+    int pid = (int)getpid();
+    bool first = true;
+    uint64_t written = 0;
+    uint64_t dropped = 0;
+    TraceEvent* copy = new TraceEvent[trace_capacity];
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    // Step 2: Every ring: thread name, then its events oldest first
+    int ring_count = trace_ring_count.load(std::memory_order_acquire);
+    for (int r = 0; r < ring_count; r++) {
+        TraceRing* ring = trace_rings[r];
+        fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",", pid, ring->thread_index, ring->thread_name);
+        first = false;
+
+        // Copy the newest capacity events
+        uint64_t end = ring->write_index.load(std::memory_order_acquire);
+        uint64_t begin = end > ring->capacity ? end - ring->capacity : 0;
+        for (uint64_t i = begin; i < end; i++) {
+            copy[i - begin] = ring->events[i & (ring->capacity - 1)];
+        }
+
+        // Slots the writer reached meanwhile may hold newer events: skip them
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t end_after = ring->write_index.load(std::memory_order_relaxed);
+        uint64_t valid_begin = end_after >= ring->capacity ? end_after - ring->capacity + 1 : 0;
+        if (valid_begin < begin) {
+            valid_begin = begin;
+        }
+        dropped += valid_begin;
+        for (uint64_t i = valid_begin; i < end; i++) {
+            writeTraceEvent(file, copy[i - begin], ring->thread_index, pid, first);
+            written++;
+        }
+    }
+    delete[] copy;
+
+    // Step 3: Close and replace the previous file
+    fprintf(file, "\n]}\n");
+    bool ok = fclose(file) == 0 && rename(temp_path, trace_path) == 0;
+    if (!ok) {
+        std::cerr << "TraceRecorder Error: Cannot write " << trace_path << std::endl;
+        return false;
+    }
+    std::cout << std::endl << "- Trace written to " << trace_path << " (" << written << " events, "
+              << dropped << " older events overwritten)" << std::endl;
+    return true;
+}
+
+/*
+* Writes the file a last time and stops the writer thread
+*/
+void stopTraceRecorder() {
+    if (!trace_enabled.load()) {
+        return;
+    }
+    trace_writer_running.store(false);
+    if (trace_writer_thread.joinable()) {
+        trace_writer_thread.join();
+    }
+    writeTraceFile();
+}
@@ -0,0 +1,111 @@
+// Fuzz target: arbitrary reads through report validation, decoding and the device loop tick
+// Build: cmake -S fuzz -B build-fuzz -DCMAKE_CXX_COMPILER=clang++ && cmake --build build-fuzz
+// Run:   ./build-fuzz/traktor_input_fuzzer fuzz/corpus -max_len=1024 -close_fd_mask=1
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "mock_hid_device.h"                // Mock F1 (reads return the fuzz data)
+#include "headers/device_context.h"         // DeviceContext
+#include "headers/device_loop.h"            // runDeviceTick
+#include "headers/input_reader.h"           // readInputReportTimeout, INPUT_REPORT_SIZE
+#include "headers/led_controller.h"         // bindLEDController, initializeLEDController
+
+
+// =============================================================================
+// INPUT FORMAT
+// =============================================================================
+
+/*
+* byte 0:   Matrix zone mode (value % 6: full matrix, left/right, rows, columns, quadrants, free)
+* byte 1:   Pad behaviors (pad n gets behavior (value + n) % 5: latch, radio, momentary, cycle, one-shot)
+* then records, one hid_read each:
+*   header: bits 0-5 = bytes the read returns (0-63, longer than 22 is cut like hidapi does)
+*           bits 6-7 = clock step before the tick (1, 10, 150 or 1000 ms: timers, flashes, overlays)
+*   payload: that many bytes (fewer at the end of the input)
+*/
+
+const uint64_t FUZZ_CLOCK_STEPS_MS[4] = { 1, 10, 150, 1000 };
+const uint64_t FUZZ_CLOCK_START_MS = 1000000;
+const int FUZZ_ZONE_MODE_COUNT = 6;         // MatrixToggleZone without CUSTOM
+
+
+// =============================================================================
+// CONTEXT - Set up once, reset for every input (no startup sequence)
+// =============================================================================
+
+static DeviceContext* fuzz_context = nullptr;
+
+static void setupContext() {
+    fuzz_context = new DeviceContext();
+    fuzz_context->device = mockHidOpenDevice(0);
+    bindLEDController(&fuzz_context->led_context);
+    initializeLEDController(fuzz_context->device);
+}
+
+/*
+* Same state as after DeviceContext::initialize(), so every input starts from scratch
+*/
+static void resetContext(uint8_t zone_byte, uint8_t behavior_byte, uint64_t now_ms) {
+    DeviceContext& context = *fuzz_context;
+    context.btn_toggle_system.initialize();
+    context.wheel_input_reader.initialize();
+    context.knob_input_reader.initialize();
+    context.fader_input_reader.initialize();
+    context.display_controller = DisplayController();
+    context.loadEffectsPage(1, now_ms);
+
+    // Zone mode and pad behaviors from the input
+    context.btn_toggle_system.setMatrixToggleMode((MatrixToggleZone)(zone_byte % FUZZ_ZONE_MODE_COUNT));
+    static const LEDColor cycle_colors[] = { LEDColor::red, LEDColor::blue };
+    static const float cycle_brightness[] = { 1.0f, 0.5f };
+    for (int i = 0; i < MATRIX_PAD_COUNT; i++) {
+        int bit = ButtonToggleSystem::getMatrixButtonBit(MatrixPad::fromIndex(i));
+        ButtonBehavior behavior = (ButtonBehavior)((behavior_byte + bit) % BUTTON_BEHAVIOR_COUNT);
+        if (behavior == ButtonBehavior::CYCLE) {
+            context.btn_toggle_system.setButtonBehavior(bit, makeCycleBehavior(cycle_colors, cycle_brightness, 2));
+        } else if (behavior == ButtonBehavior::ONE_SHOT) {
+            context.btn_toggle_system.setButtonBehavior(bit, makeOneShotBehavior());
+        } else {
+            context.btn_toggle_system.setButtonBehavior(bit, makeButtonBehavior(behavior));
+        }
+    }
+}
+
+
+// =============================================================================
+// FUZZ TARGET
+// =============================================================================
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (fuzz_context == nullptr) {
+        setupContext();
+    }
+    if (size < 2) {
+        return 0;
+    }
+    uint64_t now_ms = FUZZ_CLOCK_START_MS;
+    resetContext(data[0], data[1], now_ms);
+
+    size_t position = 2;
+    while (position < size) {
+        // Step 1: Record header
+        uint8_t header = data[position++];
+        size_t length = header & 0x3f;
+        if (length > size - position) {
+            length = size - position;
+        }
+        now_ms += FUZZ_CLOCK_STEPS_MS[header >> 6];
+
+        // Step 2: The mock F1 returns the payload as one read (exactly that many bytes, like a real short read)
+        mockHidSetInputReports(0, data + position, length > 0 ? 1 : 0, (int)length, false);
+        position += length;
+
+        // Step 3: Validation, then the tick exactly as the device loop runs it
+        unsigned char report[INPUT_REPORT_SIZE];
+        int read_result = readInputReportTimeout(fuzz_context->device, report, 0);
+        runDeviceTick(*fuzz_context, read_result > 0 ? report : nullptr, now_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Driver for compilers without libFuzzer (e.g. gcc): same target, still under ASan/UBSan
+// Run: ./build-fuzz/traktor_input_fuzzer fuzz/corpus [file]...   Replay corpus files and crash inputs
+//      ./build-fuzz/traktor_input_fuzzer --random n [--seed s]    n random inputs (no coverage feedback)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>         // For opendir, readdir (corpus directories)
+#include <sys/stat.h>       // For stat
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+const int RANDOM_INPUT_MAX_SIZE = 1024;
+
+static uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*
+* Runs one file through the target
+* @return: false if the file cannot be read
+*/
+static bool runFile(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + count);
+    }
+    fclose(file);
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+    return true;
+}
+
+/*
+* Runs a file, or every file of a directory
+* @return: Number of inputs run, -1 on error
+*/
+static int runPath(const char* path) {
+    struct stat info;
+    if (stat(path, &info) != 0) {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return -1;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        return runFile(path) ? 1 : -1;
+    }
+    DIR* directory = opendir(path);
+    if (directory == nullptr) {
+        return -1;
+    }
+    int runs = 0;
+    while (dirent* entry = readdir(directory)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        char file_path[4096];
+        snprintf(file_path, sizeof(file_path), "%s/%s", path, entry->d_name);
+        if (runFile(file_path)) {
+            runs++;
+        }
+    }
+    closedir(directory);
+    return runs;
+}
+
+int main(int argc, char* argv[]) {
+    long random_runs = 0;
+    uint32_t seed = 0x5eed1234u;
+    int runs = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--random") == 0 && i + 1 < argc) {
+            random_runs = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        } else {
+            int path_runs = runPath(argv[i]);
+            if (path_runs < 0) {
+                return 1;
+            }
+            runs += path_runs;
+        }
+    }
+
+    // Random inputs, biased towards valid reports so the decoders and toggles get real work
+    uint32_t state = seed != 0 ? seed : 1;
+    uint8_t data[RANDOM_INPUT_MAX_SIZE];
+    for (long r = 0; r < random_runs; r++) {
+        size_t size = nextRandom(state) % RANDOM_INPUT_MAX_SIZE;
+        for (size_t i = 0; i < size; i++) {
+            data[i] = (uint8_t)nextRandom(state);
+        }
+        for (size_t i = 2; i + 23 < size; i += 23) {
+            if (nextRandom(state) % 4 != 0) {
+                data[i] = (uint8_t)((data[i] & 0xc0) | 22);     // Record of a whole report
+                data[i + 1] = 0x01;                              // with the right ID
+            }
+        }
+        LLVMFuzzerTestOneInput(data, size);
+        runs++;
+    }
+
+    printf("%d inputs run without errors\n", runs);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>          // For uint64_t
+
+// =============================================================================
+// ALLOCATION COUNTER - Compiled in with -DTRAKTOR_COUNT_ALLOCATIONS only
+// =============================================================================
+
+/*
+* The device loop must not touch the heap once it is running: an allocation can
+* take a lock or page in memory, which is exactly the jitter --rt tries to avoid.
+*
+* With TRAKTOR_COUNT_ALLOCATIONS the global operator new/delete (all forms) and,
+* on glibc, malloc/calloc/realloc/aligned allocations are replaced by versions
+* that count every allocation before forwarding to the system allocator.
+* Without it nothing is replaced and every count stays 0.
+* Not for sanitizer builds: AddressSanitizer replaces the same functions.
+*/
+
+// Allocations of all threads since the program started
+uint64_t getAllocationCount();
+
+// Bytes requested by those allocations
+uint64_t getAllocatedBytes();
+
+// Allocations of the calling thread
+uint64_t getThreadAllocationCount();
+
+// true if the counters are compiled in
+bool isAllocationCountingEnabled();
+
+// Print a backtrace (stderr) for every allocation of any thread, to find out
+// where an unexpected one comes from (printing does not allocate)
+void setAllocationBacktraces(bool enabled);
+
+#endif // ALLOCATION_COUNTER_H
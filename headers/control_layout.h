@@ -0,0 +1,253 @@
+#ifndef CONTROL_LAYOUT_H
+#define CONTROL_LAYOUT_H
+
+#include <array>                            // For std::array (generated tables)
+#include <cstdint>                          // For uint8_t, uint16_t
+#include <iterator>                         // For std::size
+#include "input_reader.h"                   // For input report bytes, bit masks and button enums
+#include "led_controller.h"                 // For LED report bytes, offsets and LED button enums
+#include "led_controller_toggle.h"          // For the toggle bit layout
+
+// =============================================================================
+// CONTROLLER DESCRIPTOR - Where every control lives in the input and LED reports
+// =============================================================================
+
+/*
+* One constexpr descriptor per controller model lists every control once:
+* its type, its input byte and bit, its LED bytes and the enum values the
+* rest of the program uses for it. All decoding masks, LED byte tables and
+* index maps below are generated from that descriptor at compile time, so
+* no function needs a switch over buttons, and supporting a related NI
+* controller with the same kinds of controls means writing a new descriptor.
+*
+* A descriptor that leaves out a control, lists one twice or puts it outside
+* the reports does not compile.
+*/
+
+enum class ControlType : uint8_t {
+    MATRIX,         // RGB pad, input_index = led_index = pad index
+    SPECIAL,        // input_index = SpecialButton, led_index = SpecialLEDButton
+    CONTROL,        // input_index = ControlButton, led_index = ControlLEDButton
+    STOP            // input_index = StopButton - 1, led_index = StopLEDButton
+};
+
+const uint8_t NO_LED_INDEX = 0xFF;          // Control without LED (selector wheel press)
+
+struct ControlDescriptor {
+    ControlType type;
+    uint8_t input_index;        // Value of the input enum (see ControlType)
+    uint8_t led_index;          // Value of the LED enum, NO_LED_INDEX = no LED
+    uint8_t input_byte;         // Byte of the control in the input report
+    uint8_t input_mask;         // Its bit in that byte
+    uint8_t led_byte;           // First LED byte in the LED report
+    uint8_t led_count;          // LED bytes: 3 = matrix (B, R, G), 2 = stop (right, left), 1 = others, 0 = none
+};
+
+// One 7-segment digit: dot byte, then 7 segment bytes in SEG_... bit order
+struct DisplayDigitDescriptor {
+    uint8_t dot_byte;
+    uint8_t segment_byte;       // First of 7 segment bytes
+};
+
+struct ControllerDescriptor {
+    const char* name;
+    uint16_t vendor_id;
+    uint16_t product_id;
+    uint8_t input_report_id;
+    uint8_t input_report_size;
+    uint8_t led_report_id;
+    uint8_t led_report_size;
+    const ControlDescriptor* controls;
+    int control_count;
+    DisplayDigitDescriptor digits[2];       // [left, right]
+};
+
+// =============================================================================
+// TRAKTOR KONTROL F1
+// =============================================================================
+
+// Matrix pad: 8 per input byte from bit 7 down, 3 LED bytes (B, R, G) each from byte 25 on
+consteval ControlDescriptor f1MatrixPad(int row, int col) {
+    int pad = MatrixPad(row, col).index();
+    return { ControlType::MATRIX, (uint8_t)pad, (uint8_t)pad,
+             (uint8_t)(BUTTON_BYTE_MATRIX_TOP + pad / 8), (uint8_t)(0x80 >> (pad % 8)),
+             (uint8_t)(LED_BYTE_MATRIX_START + pad * MATRIX_LEDS_PER_BUTTON), (uint8_t)MATRIX_LEDS_PER_BUTTON };
+}
+
+consteval ControlDescriptor f1Special(SpecialButton input, SpecialLEDButton led, uint8_t mask, int led_offset) {
+    return { ControlType::SPECIAL, (uint8_t)input, (uint8_t)led, BUTTON_BYTE_SPECIAL, mask,
+             (uint8_t)(LED_BYTE_SPECIAL_START + led_offset), 1 };
+}
+
+consteval ControlDescriptor f1Control(ControlButton input, ControlLEDButton led, uint8_t mask, int led_offset) {
+    return { ControlType::CONTROL, (uint8_t)input, (uint8_t)led, BUTTON_BYTE_STOP_AND_CONTROL, mask,
+             (uint8_t)(LED_BYTE_CONTROL_START + led_offset), 1 };
+}
+
+consteval ControlDescriptor f1Stop(StopButton input, StopLEDButton led, uint8_t mask, int right_led_offset) {
+    return { ControlType::STOP, (uint8_t)((int)input - 1), (uint8_t)led, BUTTON_BYTE_STOP_AND_CONTROL, mask,
+             (uint8_t)(LED_BYTE_STOP_START + right_led_offset), 2 };
+}
+
+inline constexpr ControlDescriptor F1_CONTROLS[] = {
+    f1MatrixPad(1, 1), f1MatrixPad(1, 2), f1MatrixPad(1, 3), f1MatrixPad(1, 4),
+    f1MatrixPad(2, 1), f1MatrixPad(2, 2), f1MatrixPad(2, 3), f1MatrixPad(2, 4),
+    f1MatrixPad(3, 1), f1MatrixPad(3, 2), f1MatrixPad(3, 3), f1MatrixPad(3, 4),
+    f1MatrixPad(4, 1), f1MatrixPad(4, 2), f1MatrixPad(4, 3), f1MatrixPad(4, 4),
+
+    f1Special(SpecialButton::BROWSE,  SpecialLEDButton::BROWSE,  BIT_MASK_BROWSE,  LED_OFFSET_BROWSE),
+    f1Special(SpecialButton::SIZE,    SpecialLEDButton::SIZE,    BIT_MASK_SIZE,    LED_OFFSET_SIZE),
+    f1Special(SpecialButton::TYPE,    SpecialLEDButton::TYPE,    BIT_MASK_TYPE,    LED_OFFSET_TYPE),
+    f1Special(SpecialButton::REVERSE, SpecialLEDButton::REVERSE, BIT_MASK_REVERSE, LED_OFFSET_REVERSE),
+    f1Special(SpecialButton::SHIFT,   SpecialLEDButton::SHIFT,   BIT_MASK_SHIFT,   LED_OFFSET_SHIFT),
+    { ControlType::SPECIAL, (uint8_t)SpecialButton::SELECTOR_WHEEL, NO_LED_INDEX, BUTTON_BYTE_SPECIAL, BIT_MASK_SELECTOR_WHEEL, 0, 0 },
+
+    f1Control(ControlButton::CAPTURE, ControlLEDButton::CAPTURE, BIT_MASK_CAPTURE, LED_OFFSET_CAPTURE),
+    f1Control(ControlButton::QUANT,   ControlLEDButton::QUANT,   BIT_MASK_QUANT,   LED_OFFSET_QUANT),
+    f1Control(ControlButton::SYNC,    ControlLEDButton::SYNC,    BIT_MASK_SYNC,    LED_OFFSET_SYNC),
+
+    f1Stop(StopButton::STOP1, StopLEDButton::STOP1, BIT_MASK_STOP1, LED_OFFSET_STOP1_RIGHT),
+    f1Stop(StopButton::STOP2, StopLEDButton::STOP2, BIT_MASK_STOP2, LED_OFFSET_STOP2_RIGHT),
+    f1Stop(StopButton::STOP3, StopLEDButton::STOP3, BIT_MASK_STOP3, LED_OFFSET_STOP3_RIGHT),
+    f1Stop(StopButton::STOP4, StopLEDButton::STOP4, BIT_MASK_STOP4, LED_OFFSET_STOP4_RIGHT)
+};
+
+inline constexpr ControllerDescriptor F1_DESCRIPTOR = {
+    "Traktor Kontrol F1", 0x17cc, 0x1120,
+    INPUT_REPORT_ID, INPUT_REPORT_SIZE, LED_REPORT_ID, LED_REPORT_SIZE,
+    F1_CONTROLS, (int)std::size(F1_CONTROLS),
+    { { LED_BYTE_7SEG_LEFT_START, LED_BYTE_7SEG_LEFT_START + 1 },
+      { LED_BYTE_7SEG_RIGHT_START, LED_BYTE_7SEG_RIGHT_START + 1 } }
+};
+
+// =============================================================================
+// GENERATED TABLES - Built from F1_DESCRIPTOR at compile time
+// =============================================================================
+
+// Layout of one control with an LED, indexed by its toggle bit
+struct ControlLayout {
+    uint8_t input_byte;         // Byte of the button in the input report
+    uint8_t input_mask;         // Its bit in that byte
+    uint8_t led_byte;           // First LED byte in the LED report
+    uint8_t led_count;          // LED bytes: 3 = matrix (B, R, G), 2 = stop (right, left), 1 = others
+};
+
+// Input bit of a control, indexed by its input enum
+struct ControlInput {
+    uint8_t input_byte;
+    uint8_t input_mask;
+};
+
+// First toggle bit of a control type (see TOGGLE_BIT_* in led_controller_toggle.h)
+constexpr int getToggleBitStart(ControlType type) {
+    switch (type) {
+        case ControlType::MATRIX:  return TOGGLE_BIT_MATRIX_START;
+        case ControlType::SPECIAL: return TOGGLE_BIT_SPECIAL_START;
+        case ControlType::CONTROL: return TOGGLE_BIT_CONTROL_START;
+        case ControlType::STOP:    return TOGGLE_BIT_STOP_START;
+    }
+    return TOGGLE_BIT_COUNT;
+}
+
+// Number of toggle bits of a control type
+constexpr int getToggleBitCount(ControlType type) {
+    switch (type) {
+        case ControlType::MATRIX:  return TOGGLE_BIT_SPECIAL_START - TOGGLE_BIT_MATRIX_START;
+        case ControlType::SPECIAL: return TOGGLE_BIT_CONTROL_START - TOGGLE_BIT_SPECIAL_START;
+        case ControlType::CONTROL: return TOGGLE_BIT_STOP_START - TOGGLE_BIT_CONTROL_START;
+        case ControlType::STOP:    return TOGGLE_BIT_COUNT - TOGGLE_BIT_STOP_START;
+    }
+    return 0;
+}
+
+/*
+* Controls with an LED by toggle bit (bit = type start + led_index)
+* Throws (= compile error) if a bit is missing, taken twice or out of the LED report
+*/
+constexpr std::array<ControlLayout, TOGGLE_BIT_COUNT> buildControlLayout(const ControllerDescriptor& descriptor) {
+    std::array<ControlLayout, TOGGLE_BIT_COUNT> layout = {};
+    uint32_t filled_mask = 0;
+
+    for (int i = 0; i < descriptor.control_count; i++) {
+        const ControlDescriptor& control = descriptor.controls[i];
+        if (control.led_index == NO_LED_INDEX) {
+            continue;
+        }
+        if (control.led_index >= getToggleBitCount(control.type) ||
+            control.input_byte >= descriptor.input_report_size ||
+            control.led_byte + control.led_count > descriptor.led_report_size) {
+            throw "Controller descriptor: control outside its group or the reports";
+        }
+        int bit = getToggleBitStart(control.type) + control.led_index;
+        if (filled_mask & (1u << bit)) {
+            throw "Controller descriptor: LED index used twice";
+        }
+        filled_mask |= 1u << bit;
+        layout[bit] = { control.input_byte, control.input_mask, control.led_byte, control.led_count };
+    }
+
+    if (filled_mask != (1u << TOGGLE_BIT_COUNT) - 1) {
+        throw "Controller descriptor: a toggle bit has no control";
+    }
+    return layout;
+}
+
+/*
+* Input bits of one control type by input enum value
+* Throws (= compile error) if an enum value is missing or taken twice
+*/
+template <int Count>
+constexpr std::array<ControlInput, Count> buildInputMap(const ControllerDescriptor& descriptor, ControlType type) {
+    std::array<ControlInput, Count> inputs = {};
+    uint32_t filled_mask = 0;
+
+    for (int i = 0; i < descriptor.control_count; i++) {
+        const ControlDescriptor& control = descriptor.controls[i];
+        if (control.type != type) {
+            continue;
+        }
+        if (control.input_index >= Count || (filled_mask & (1u << control.input_index)) ||
+            control.input_byte >= descriptor.input_report_size) {
+            throw "Controller descriptor: input index out of range or used twice";
+        }
+        filled_mask |= 1u << control.input_index;
+        inputs[control.input_index] = { control.input_byte, control.input_mask };
+    }
+
+    if (filled_mask != (1u << Count) - 1) {
+        throw "Controller descriptor: an input enum value has no control";
+    }
+    return inputs;
+}
+
+inline constexpr std::array<ControlLayout, TOGGLE_BIT_COUNT> CONTROL_LAYOUT = buildControlLayout(F1_DESCRIPTOR);
+
+inline constexpr std::array<ControlInput, SPECIAL_BUTTON_COUNT> SPECIAL_BUTTON_INPUTS =
+    buildInputMap<SPECIAL_BUTTON_COUNT>(F1_DESCRIPTOR, ControlType::SPECIAL);
+inline constexpr std::array<ControlInput, CONTROL_BUTTON_COUNT> CONTROL_BUTTON_INPUTS =
+    buildInputMap<CONTROL_BUTTON_COUNT>(F1_DESCRIPTOR, ControlType::CONTROL);
+inline constexpr std::array<ControlInput, STOP_BUTTON_COUNT> STOP_BUTTON_INPUTS =
+    buildInputMap<STOP_BUTTON_COUNT>(F1_DESCRIPTOR, ControlType::STOP);
+
+// Layout of a matrix pad
+constexpr const ControlLayout& getMatrixPadLayout(MatrixPad pad) {
+    return CONTROL_LAYOUT[TOGGLE_BIT_MATRIX_START + pad.index()];
+}
+
+// Checks against the documented F1 layout (input_reader.cpp, led_controller.h)
+static_assert(getToggleBitCount(ControlType::MATRIX) == MATRIX_PAD_COUNT &&
+              getToggleBitCount(ControlType::SPECIAL) == SPECIAL_LED_COUNT &&
+              getToggleBitCount(ControlType::CONTROL) == CONTROL_LED_COUNT &&
+              getToggleBitCount(ControlType::STOP) == STOP_LED_COUNT, "Toggle bit groups match the LED state arrays");
+static_assert(getMatrixPadLayout(MatrixPad(2, 1)).input_byte == BUTTON_BYTE_MATRIX_TOP &&
+              getMatrixPadLayout(MatrixPad(2, 1)).input_mask == 0x08, "Matrix (2,1) is byte 1, bit 3");
+static_assert(getMatrixPadLayout(MatrixPad(4, 4)).input_byte == BUTTON_BYTE_MATRIX_BOTTOM &&
+              getMatrixPadLayout(MatrixPad(4, 4)).input_mask == 0x01, "Matrix (4,4) is byte 2, bit 0");
+static_assert(getMatrixPadLayout(MatrixPad(4, 4)).led_byte + MATRIX_LEDS_PER_BUTTON == LED_BYTE_STOP_START,
+              "Matrix LEDs end where the stop LEDs start");
+static_assert(CONTROL_LAYOUT[TOGGLE_BIT_STOP_START + 3].led_byte == LED_BYTE_STOP_START, "STOP4 has the first stop LED bytes");
+static_assert(SPECIAL_BUTTON_INPUTS[(int)SpecialButton::SELECTOR_WHEEL].input_mask == 0x04, "Wheel press is byte 3, bit 2");
+static_assert(F1_DESCRIPTOR.digits[0].dot_byte == 9 && F1_DESCRIPTOR.digits[1].segment_byte == 2,
+              "Left dot is byte 9, right segments start at byte 2");
+
+#endif // CONTROL_LAYOUT_H
@@ -0,0 +1,123 @@
+#ifndef CONTROL_SERVER_H
+#define CONTROL_SERVER_H
+
+#include <cstdint>                      // For fixed-size integer types
+#include <atomic>                       // For std::atomic (stop flag)
+#include <thread>                       // For std::thread (socket thread)
+#include "spsc_queue.h"                 // Lock-free hand-off to the main loop
+#include "led_controller.h"             // For LEDColor and LED button enums
+#include "led_controller_toggle.h"      // For MatrixToggleZone
+#include "led_controller_display.h"     // For DisplayController
+#include "state_publisher.h"            // For state queries (seqlock snapshot)
+
+// =============================================================================
+// CONSTANTS - Control socket configuration
+// =============================================================================
+
+const char CONTROL_SOCKET_DEFAULT_PATH[] = "/tmp/visual_sync_f1.sock";
+const int CONTROL_MAX_COMMANDS_PER_BATCH = 32;  // Commands in one request line
+const int CONTROL_QUEUE_CAPACITY = 16;          // Batches waiting for the main loop
+const int CONTROL_MAX_CLIENTS = 4;              // Connected clients at the same time
+const int CONTROL_LINE_SIZE = 1024;             // Longest request line
+const int CONTROL_POLL_TIMEOUT_MS = 100;        // Socket thread checks the stop flag this often
+
+/*
+* Protocol: one request per line, commands separated by ';', one reply line per request
+*
+*   led matrix <row> <col> <color> [brightness]     e.g. led matrix 1 2 red 0.5
+*   led button <name> <brightness>                  browse, size, type, reverse, shift, capture, quant, sync
+*   led stop <1-4> <brightness>
+*   display number <1-99>
+*   display text <1-2 characters>
+*   page <1-99>                                     Load effects page (like pressing the selector wheel)
+*   zone <full|split|rows|columns|quadrants|free>   Matrix toggle zone mode
+*   state                                           Query the latest controller state
+*
+* All commands of a request are checked first; if one is invalid nothing is applied.
+* Valid requests are applied together in one main loop tick (one LED report).
+*
+* Replies: "ok" (followed by " key=value ..." when state was queried),
+*          "error <command number>: <reason>" or "error busy" (queue full)
+*/
+
+// =============================================================================
+// COMMANDS
+// =============================================================================
+
+enum class ControlCommandType : uint8_t {
+    MATRIX_LED,
+    SPECIAL_LED,
+    CONTROL_LED,
+    STOP_LED,
+    DISPLAY_NUMBER,
+    DISPLAY_TEXT,
+    LOAD_PAGE,
+    ZONE_MODE
+};
+
+// One parsed command (only the fields of its type are used)
+struct ControlCommand {
+    ControlCommandType type;
+    MatrixPad pad;                  // MATRIX_LED
+    uint8_t button_index;           // SPECIAL/CONTROL/STOP_LED: index in enum order
+    LEDColor color;                 // MATRIX_LED
+    float brightness;               // *_LED
+    int value;                      // DISPLAY_NUMBER, LOAD_PAGE
+    MatrixToggleZone zone_mode;     // ZONE_MODE
+    char text[3];                   // DISPLAY_TEXT
+};
+
+// All commands of one request, applied together
+struct ControlBatch {
+    int count;
+    ControlCommand commands[CONTROL_MAX_COMMANDS_PER_BATCH];
+};
+
+// Parse one command ("led matrix 1 1 red"); on failure error points to a reason
+bool parseControlCommand(char* text, ControlCommand& command, const char*& error);
+
+// Apply one LED/display command (call inside the LED frame); false for page/zone commands
+bool applyControlCommand(const ControlCommand& command, DisplayController& display);
+
+// =============================================================================
+// CONTROL SERVER CLASS
+// =============================================================================
+
+class ControlServer {
+private:
+    int listen_fd = -1;
+    char socket_path[108] = {};                     // sockaddr_un path size
+    const SharedStateSegment* state_segment = nullptr;
+
+    std::thread server_thread;
+    std::atomic<bool> stop_requested{false};
+
+    // Socket thread -> main loop
+    SpscQueue<ControlBatch, CONTROL_QUEUE_CAPACITY> batch_queue;
+
+    // Client connections (socket thread only)
+    int client_fds[CONTROL_MAX_CLIENTS];
+    char client_lines[CONTROL_MAX_CLIENTS][CONTROL_LINE_SIZE];
+    int client_line_lengths[CONTROL_MAX_CLIENTS];
+
+    // Socket thread functions
+    void run();
+    void acceptClient();
+    void readClient(int slot);
+    void closeClient(int slot);
+    bool handleRequest(int fd, char* line);     // false = client gone
+
+public:
+    // Bind the socket and start the socket thread (fails if path is a file or a live socket)
+    // @param state_segment: Snapshot answered by "state" queries (may be nullptr)
+    bool start(const char* path, const SharedStateSegment* state_segment);
+    void stop();
+    bool isRunning() const;
+
+    // Main loop side - false if no batch is waiting
+    bool popBatch(ControlBatch& batch);
+
+    ~ControlServer();
+};
+
+#endif // CONTROL_SERVER_H
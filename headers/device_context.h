@@ -0,0 +1,109 @@
+#ifndef DEVICE_CONTEXT_H
+#define DEVICE_CONTEXT_H
+
+#include <hidapi/hidapi.h>
+#include <cstdint>                      // For uint64_t
+#include <atomic>                       // For std::atomic (loop start/stop flags)
+#include "led_controller.h"             // For LEDControllerContext
+#include "led_controller_toggle.h"      // For ButtonToggleSystem
+#include "led_controller_display.h"     // For DisplayController
+#include "led_scene_controller.h"       // For SceneController
+#include "input_reader_wheel.h"         // For WheelInputReader
+#include "input_reader_knob.h"          // For KnobInputReader
+#include "input_reader_fader.h"         // For FaderInputReader
+#include "osc_sender.h"                 // For OscSender
+#include "osc_listener.h"               // For OscListener
+#include "midi_output.h"                // For MidiOutput
+#include "state_publisher.h"            // For StatePublisher, ControllerState
+#include "led_frame_receiver.h"         // For LEDFrameReceiver
+#include "control_server.h"             // For ControlServer, ControlBatch
+#include "dmx_output.h"                 // For DmxOutput
+
+// =============================================================================
+// CONSTANTS - Multiple devices
+// =============================================================================
+
+const int MAX_F1_DEVICES = 8;               // Devices one process services
+const int DEVICE_SERIAL_SIZE = 64;
+const int DEVICE_PATH_SIZE = 256;
+const int DEVICE_RECONNECT_POLL_MS = 100;   // How often a disconnected F1 is looked for
+
+// One connected F1 found by enumerateF1Devices()
+struct F1DeviceInfo {
+    unsigned short vendor_id;
+    unsigned short product_id;
+    char serial[DEVICE_SERIAL_SIZE];        // USB serial number (empty if the device reports none)
+    char path[DEVICE_PATH_SIZE];            // Platform path for hid_open_path()
+};
+
+// Find connected F1s, one entry per device, sorted by serial number
+// @return: Number of devices written to devices
+int enumerateF1Devices(unsigned short vendor_id, unsigned short product_id, F1DeviceInfo* devices, int max_devices);
+
+// =============================================================================
+// DEVICE CONTEXT - Everything one F1 needs, serviced by its own thread
+// =============================================================================
+
+/*
+* Per-device state
+*
+* The LED functions work on led_context once the device thread has called
+* bindLEDController(&led_context), so toggles, display and scenes of one F1
+* never touch another F1's LEDs.
+*
+* Integrations: every device sends OSC (/f1, /f2, ...). OSC feedback, MIDI,
+* DMX, shared memory and the control socket serve one process-wide endpoint
+* each and are only opened on the first device.
+*/
+struct DeviceContext {
+    int number = 1;                                 // 1-based, in log output and OSC addresses
+    F1DeviceInfo info = {};
+    hid_device* device = nullptr;
+
+    // Controller state
+    LEDControllerContext led_context;
+    ButtonToggleSystem btn_toggle_system;
+    WheelInputReader wheel_input_reader;
+    KnobInputReader knob_input_reader;
+    FaderInputReader fader_input_reader;
+    DisplayController display_controller;
+    SceneController scene_controller;
+    int current_effect_page = 1;
+
+    // Integrations
+    OscSender osc_sender;
+    MidiOutput midi_output;
+    OscListener osc_listener;
+    StatePublisher state_publisher;
+    ControllerState published_state = {};
+    LEDFrameReceiver led_frame_receiver;
+    ControlServer control_server;
+    ControlBatch control_batch;
+    DmxOutput dmx_output;
+
+    // Hot-plug
+    uint64_t disconnected_since_ms = 0;
+    uint64_t next_reconnect_ms = 0;
+    uint32_t reconnect_count = 0;
+
+    // Device loop (see device_loop.h)
+    bool print_analog_values = false;               // Knob/fader debug line on stdout, every report (off with --rt)
+    std::atomic<bool> running{false};               // Set once initialized, cleared when the loop ends
+    std::atomic<bool> stop_requested{false};        // Ends the loop after the current tick
+
+    // Bind LEDs to the calling thread, clear them, run the startup sequence and load the first page
+    bool initialize();
+
+    // Load an effects page: scene, matrix toggle zones and behaviors (selector wheel press or control socket)
+    void loadEffectsPage(int page, uint64_t now_ms);
+
+    // Hot-plug (call on the device thread): page, toggles, scene and LEDs stay in memory while the F1 is gone
+    bool isConnected() const;
+    void handleDisconnect(uint64_t now_ms);
+    bool tryReconnect(uint64_t now_ms);     // Reopen and replay the current LED frame, false if not back yet
+
+    // Close integrations and the device
+    void close();
+};
+
+#endif // DEVICE_CONTEXT_H
@@ -0,0 +1,29 @@
+#ifndef DEVICE_LOOP_H
+#define DEVICE_LOOP_H
+
+#include "device_context.h"             // For DeviceContext
+#include "realtime.h"                   // For RealtimeConfig
+
+// =============================================================================
+// FUNCTION DECLARATIONS - Device loop
+// =============================================================================
+
+/*
+* One loop tick: timed behaviors, feedback, control batches and the input report, one LED frame
+* Call on the device's thread (after context.initialize()); now_ms is injectable for replays.
+*
+* @param input_report_buffer: Report read this tick (INPUT_REPORT_SIZE bytes), nullptr if none
+* @param now_ms: Current tick time
+*/
+void runDeviceTick(DeviceContext& context, const unsigned char* input_report_buffer, uint64_t now_ms);
+
+/*
+* Services one F1 until context.stop_requested is set (main sets it on Ctrl+C / SIGTERM)
+* Run one call per device, each on its own thread. Used by main and the stress test.
+*
+* @param context: The device's context (device opened, integrations set up)
+* @param realtime: Real-time mode (--rt), applied to the calling thread first
+*/
+void serviceDevice(DeviceContext& context, const RealtimeConfig& realtime);
+
+#endif // DEVICE_LOOP_H
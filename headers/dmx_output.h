@@ -0,0 +1,135 @@
+#ifndef DMX_OUTPUT_H
+#define DMX_OUTPUT_H
+
+#include <cstdint>                      // For uint8_t, uint16_t, uint32_t, uint64_t types
+#include <netinet/in.h>                 // For sockaddr_in (one target per universe)
+#include "led_controller_toggle.h"      // For TOGGLE_BIT_COUNT (button bit layout)
+#include "input_reader_knob.h"          // For KNOB_COUNT and raw knob values
+#include "input_reader_fader.h"         // For FADER_COUNT and raw fader values
+
+// =============================================================================
+// CONSTANTS - DMX output configuration
+// =============================================================================
+
+const int DMX_UNIVERSE_SIZE = 512;                  // Channels per universe
+const int DMX_MAX_UNIVERSES = 4;                    // Universes one controller can fill
+const int DMX_MAX_MAPPINGS = 64;                    // Entries in a mapping config
+const int DMX_ANALOG_COUNT = KNOB_COUNT + FADER_COUNT;
+const int DMX_DEFAULT_REFRESH_HZ = 40;              // Packets per second for changed universes
+const int DMX_KEEPALIVE_MS = 1000;                  // Unchanged universes are resent this often
+
+const int ARTNET_DEFAULT_PORT = 6454;
+const int ARTNET_HEADER_SIZE = 18;                  // ArtDmx header before the channel data
+const int SACN_DEFAULT_PORT = 5568;
+const int SACN_HEADER_SIZE = 126;                   // Root + framing + DMP layer incl. start code
+const int DMX_PACKET_MAX_SIZE = SACN_HEADER_SIZE + DMX_UNIVERSE_SIZE;
+const char SACN_MULTICAST_HOST[] = "multicast";     // sACN target: 239.255.<universe hi>.<universe lo>
+const char DMX_SOURCE_NAME[] = "Visual Sync F1";
+
+enum class DmxProtocol {
+    ARTNET,     // Art-Net 4 ArtDmx (UDP 6454, unicast or broadcast)
+    SACN        // ANSI E1.31 streaming ACN (UDP 5568, unicast or multicast)
+};
+
+// What drives a DMX channel
+enum class DmxSource : uint8_t {
+    KNOB,       // source_index 1-4, 12-bit value scaled to 0-255 (or 16-bit with fine)
+    FADER,      // source_index 1-4
+    TOGGLE      // source_index = toggle bit 0-27, 255 when toggled on, 0 when off
+};
+
+struct DmxChannelMapping {
+    DmxSource source;
+    uint8_t source_index;
+    uint8_t universe_index;     // 0 = first universe, counted from DmxOutput's first universe
+    uint16_t channel;           // 1-512
+    bool fine;                  // Analog only: coarse on channel, fine on channel + 1
+};
+
+struct DmxMappingConfig {
+    int mapping_count;
+    DmxChannelMapping mappings[DMX_MAX_MAPPINGS];
+};
+
+// Default mapping (first universe): faders 1-4 on channels 1-4, knobs 1-4 on 5-8,
+// matrix toggles (row-major) on 9-24, stop toggles on 25-28
+DmxMappingConfig getDefaultDmxMapping();
+
+// =============================================================================
+// DMX OUTPUT CLASS
+// =============================================================================
+
+/*
+* Compiled channel targets: offsets straight into the packet buffers,
+* so updating a channel is one store into the packet that gets sent
+*/
+struct DmxAnalogTarget {
+    uint8_t analog_index;       // Knobs 0-3, faders 4-7
+    uint8_t universe_index;
+    uint16_t coarse_offset;     // Offset in packets[universe_index]
+    uint16_t fine_offset;       // 0 = no fine channel (offset 0 is always header)
+};
+
+struct DmxToggleTarget {
+    uint8_t bit;
+    uint8_t universe_index;
+    uint16_t offset;
+};
+
+class DmxOutput {
+private:
+    int socket_fd = -1;                                 // UDP socket, -1 if closed
+    DmxProtocol protocol = DmxProtocol::ARTNET;
+    DmxMappingConfig mapping = getDefaultDmxMapping();
+
+    // Packets with prebuilt headers, channel data is written in place
+    unsigned char packets[DMX_MAX_UNIVERSES][DMX_PACKET_MAX_SIZE];
+    int packet_size = 0;
+    int data_offset = 0;                                // First channel inside a packet
+    int sequence_offset = 0;                            // Sequence byte inside a packet
+    sockaddr_in destinations[DMX_MAX_UNIVERSES];
+    int universe_count = 0;
+
+    // Compiled mapping
+    DmxAnalogTarget analog_targets[DMX_MAX_MAPPINGS];
+    int analog_target_count = 0;
+    DmxToggleTarget toggle_targets[DMX_MAX_MAPPINGS];
+    int toggle_target_count = 0;
+
+    // Refresh state
+    uint32_t dirty_universes = 0;                       // Bit per universe with changed channels
+    uint32_t last_toggle_mask = 0;
+    uint8_t sequence[DMX_MAX_UNIVERSES] = {};
+    uint64_t last_sent_ms[DMX_MAX_UNIVERSES] = {};
+    uint64_t next_refresh_ms = 0;
+    int refresh_interval_ms = 1000 / DMX_DEFAULT_REFRESH_HZ;
+    uint32_t sent_count = 0;
+
+    // Readers for raw 12-bit analog values
+    KnobInputReader knob_reader;
+    FaderInputReader fader_reader;
+
+    void buildPackets(int first_universe);
+    bool compileMapping();
+    void sendUniverse(int universe_index, uint64_t now_ms);
+
+public:
+    // Open UDP socket and build the packet headers
+    // @param host: Target host, broadcast address, or "multicast" (sACN only)
+    bool initialize(DmxProtocol protocol, const char* host, int port, int first_universe, int refresh_hz);
+    void close();
+    bool isOpen() const;
+
+    // Replace the channel mapping (checked and compiled, all channels start at 0)
+    bool setMapping(const DmxMappingConfig& new_mapping);
+
+    // Store knob/fader values of this report (call once per input report)
+    void processInputReport(const unsigned char* input_report);
+
+    // Store toggle states and send due universes (call every tick)
+    void tick(uint32_t toggled_mask, uint64_t now_ms);
+
+    uint32_t getSentCount() const;
+};
+
+#endif // DMX_OUTPUT_H
@@ -2,6 +2,7 @@
 #define INPUT_READER_H
 
 #include <hidapi/hidapi.h>
+#include "matrix_pad.h"     // For MatrixPad
 
 // =============================================================================
 // CONSTANTS - These define the structure of the F1's input reports
@@ -36,25 +37,8 @@ const unsigned char BIT_MASK_SYNC = 0x08;     // Bit 3
 const unsigned char BIT_MASK_QUANT = 0x04;    // Bit 2
 const unsigned char BIT_MASK_CAPTURE = 0x02;  // Bit 1
 
-// Matrix button bit masks for byte 1 (top half - rows 1-2)
-const unsigned char BIT_MASK_MATRIX_1_1 = 0x80;  // Bit 7
-const unsigned char BIT_MASK_MATRIX_2_1 = 0x40;  // Bit 6
-const unsigned char BIT_MASK_MATRIX_3_1 = 0x20;  // Bit 5
-const unsigned char BIT_MASK_MATRIX_4_1 = 0x10;  // Bit 4
-const unsigned char BIT_MASK_MATRIX_1_2 = 0x08;  // Bit 3
-const unsigned char BIT_MASK_MATRIX_2_2 = 0x04;  // Bit 2
-const unsigned char BIT_MASK_MATRIX_3_2 = 0x02;  // Bit 1
-const unsigned char BIT_MASK_MATRIX_4_2 = 0x01;  // Bit 0
-
-// Matrix button bit masks for byte 2 (bottom half - rows 3-4)
-const unsigned char BIT_MASK_MATRIX_1_3 = 0x80;  // Bit 7
-const unsigned char BIT_MASK_MATRIX_2_3 = 0x40;  // Bit 6
-const unsigned char BIT_MASK_MATRIX_3_3 = 0x20;  // Bit 5
-const unsigned char BIT_MASK_MATRIX_4_3 = 0x10;  // Bit 4
-const unsigned char BIT_MASK_MATRIX_1_4 = 0x08;  // Bit 3
-const unsigned char BIT_MASK_MATRIX_2_4 = 0x04;  // Bit 2
-const unsigned char BIT_MASK_MATRIX_3_4 = 0x02;  // Bit 1
-const unsigned char BIT_MASK_MATRIX_4_4 = 0x01;  // Bit 0
+// Matrix button bits are generated from the controller descriptor (control_layout.h):
+// pad (row-1) * 4 + (col-1), 8 pads per byte from bit 7 down
 
 // =============================================================================
 // ENUMS - These make the code more readable than using magic numbers
@@ -70,6 +54,8 @@ enum class SpecialButton {
     SELECTOR_WHEEL
 };
 
+const int SPECIAL_BUTTON_COUNT = 6;     // Number of SpecialButton values
+
 // Stop buttons enum
 enum class StopButton {
     STOP1 = 1,
@@ -78,6 +64,8 @@ enum class StopButton {
     STOP4 = 4
 };
 
+const int STOP_BUTTON_COUNT = 4;        // Number of StopButton values
+
 // Control buttons enum
 enum class ControlButton {
     SYNC,
@@ -85,6 +73,8 @@ enum class ControlButton {
     CAPTURE
 };
 
+const int CONTROL_BUTTON_COUNT = 3;     // Number of ControlButton values
+
 // =============================================================================
 // FUNCTION DECLARATIONS - What functions are provided to other files
 // =============================================================================
@@ -92,11 +82,17 @@ enum class ControlButton {
 // Main input reading function
 bool readInputReport(hid_device* device, unsigned char* buffer);
 
+// Input reading with timeout: 1 = report read, 0 = timeout or invalid report (skipped), -1 = error
+int readInputReportTimeout(hid_device* device, unsigned char* buffer, int timeout_ms);
+
+// A whole 22-byte report with ID 0x01 (length = bytes returned by hid_read)
+bool isValidInputReport(const unsigned char* buffer, int length);
+
 // Button checking functions
 bool isSpecialButtonPressed(const unsigned char* buffer, SpecialButton button);
 bool isStopButtonPressed(const unsigned char* buffer, StopButton button);
 bool isControlButtonPressed(const unsigned char* buffer, ControlButton button);
-bool isMatrixButtonPressed(const unsigned char* buffer, int row, int col);
+bool isMatrixButtonPressed(const unsigned char* buffer, MatrixPad pad);
 
 // Utility functions for testing and debugging
 void printRawInputReport(const unsigned char* buffer);
@@ -16,6 +16,8 @@ const uint16_t FADER_RAW_MIN = 0x000;       // Minimum raw value (12-bit)
 const uint16_t FADER_RAW_MAX = 0xFFF;       // Maximum raw value (12-bit)
 const uint16_t FADER_12BIT_MASK = 0x0FFF;   // Mask for 12-bit values
 
+const float FADER_MOVE_THRESHOLD = 0.005f;  // Default minimum movement for hasFaderMoved (0.5%)
+
 // =============================================================================
 // FADER INPUT READER CLASS
 // =============================================================================
@@ -24,6 +26,8 @@ class FaderInputReader {
 private:
     float previous_values[FADER_COUNT];      // Previous fader values for change detection  // ==== UNUSED ====
     bool initialized;                        // Track if there is a baseline value  // ==== UNUSED ====
+    float moved_values[FADER_COUNT];         // Value at the last reported movement (hasFaderMoved)
+    bool moved_initialized[FADER_COUNT];     // Track if hasFaderMoved has a baseline per fader
 
     // Helper function to extract raw 12-bit value from buffer
     uint16_t extractRawFaderValue(const unsigned char* buffer, int fader_number) const;
@@ -44,9 +48,13 @@ public:
     
     // Update function - call this once per frame after reading all fader values
     void updateFaderStates(const unsigned char* buffer);  // ==== UNUSED ====
+
+    // Movement detection - true once the fader moved beyond threshold since the last true
+    // Unlike hasFaderChanged(), slow movements add up, and no separate update call is needed
+    bool hasFaderMoved(const unsigned char* buffer, int fader_number, float threshold = FADER_MOVE_THRESHOLD);
     
     // Utility functions
-    uint16_t getRawFaderValue(const unsigned char* buffer, int fader_number);  // ==== UNUSED ====
+    uint16_t getRawFaderValue(const unsigned char* buffer, int fader_number);  // Raw 12-bit value (OSC, MIDI, DMX, state)
     void printFaderValues(const unsigned char* buffer);
 };
 
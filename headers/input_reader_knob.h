@@ -16,6 +16,8 @@ const uint16_t KNOB_RAW_MIN = 0x000;        // Minimum raw value (12-bit)
 const uint16_t KNOB_RAW_MAX = 0xFFF;        // Maximum raw value (12-bit)
 const uint16_t KNOB_12BIT_MASK = 0x0FFF;    // Mask for 12-bit values
 
+const float KNOB_MOVE_THRESHOLD = 0.005f;   // Default minimum movement for hasKnobMoved (0.5%)
+
 // =============================================================================
 // KNOB INPUT READER CLASS
 // =============================================================================
@@ -24,6 +26,8 @@ class KnobInputReader {
 private:
     float previous_values[KNOB_COUNT];       // Previous knob values for change detection  // ==== UNUSED ====
     bool initialized;                        // Track if there is a baseline value  // ==== UNUSED ====
+    float moved_values[KNOB_COUNT];          // Value at the last reported movement (hasKnobMoved)
+    bool moved_initialized[KNOB_COUNT];      // Track if hasKnobMoved has a baseline per knob
 
     // Helper function to extract raw 12-bit value from buffer
     uint16_t extractRawKnobValue(const unsigned char* buffer, int knob_number) const;
@@ -36,7 +40,7 @@ private:
 
 public:
     // Initialization
-    bool initialize();  // ==== UNUSED ====
+    bool initialize();
     
     // Main functions
     float getKnobValue(const unsigned char* buffer, int knob_number);
@@ -45,8 +49,12 @@ public:
     // Update function - call this once per frame after reading all knob values
     void updateKnobStates(const unsigned char* buffer); // ==== UNUSED ====
 
+    // Movement detection - true once the knob moved beyond threshold since the last true
+    // Unlike hasKnobChanged(), slow movements add up, and no separate update call is needed
+    bool hasKnobMoved(const unsigned char* buffer, int knob_number, float threshold = KNOB_MOVE_THRESHOLD);
+
     // Debug/utility functions
-    uint16_t getRawKnobValue(const unsigned char* buffer, int knob_number); // ==== UNUSED ====
+    uint16_t getRawKnobValue(const unsigned char* buffer, int knob_number); // Raw 12-bit value (OSC, MIDI, DMX, state)
     void printKnobValues(const unsigned char* buffer);
 
 };
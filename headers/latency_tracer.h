@@ -0,0 +1,142 @@
+#ifndef LATENCY_TRACER_H
+#define LATENCY_TRACER_H
+
+#include <cstdint>          // For uint64_t
+#include <atomic>           // For std::atomic (lock-free histogram buckets)
+#include <chrono>           // For std::chrono::steady_clock
+
+// =============================================================================
+// LATENCY TRACING - Compiled in with -DTRAKTOR_LATENCY_TRACING only
+// =============================================================================
+
+/*
+* Each processed input report is timestamped at fixed points of the device loop:
+*
+*   READ       hid_read returned the report
+*   DECODE     wheel, knobs, faders and value overlays decoded
+*   DISPATCH   button edges dispatched to the toggle system (LED buffer changed)
+*   LED_FRAME  LED frame complete (after OSC/MIDI/DMX/state), endLEDFrame() next
+*   WRITE      hid_write of the LED report completed (only if the frame changed LEDs)
+*
+* The differences go into lock-free log-linear (HDR-style) histograms, one per
+* stage, shared by all device threads. kill -USR1 <pid> prints p50/p99/p99.9/max.
+* Without TRAKTOR_LATENCY_TRACING the LATENCY_* macros compile to nothing.
+*/
+
+// =============================================================================
+// CONSTANTS - Histogram layout
+// =============================================================================
+
+const int LATENCY_SUB_BUCKET_BITS = 4;                                  // 16 sub-buckets per power of two (~6% precision)
+const int LATENCY_SUB_BUCKETS = 1 << LATENCY_SUB_BUCKET_BITS;
+const int LATENCY_MAX_EXPONENT = 40;                                    // Values up to ~18 minutes in ns
+const int LATENCY_BUCKET_COUNT = (LATENCY_MAX_EXPONENT - LATENCY_SUB_BUCKET_BITS + 2) * LATENCY_SUB_BUCKETS;
+
+// Timestamped points of one report
+enum class LatencyPoint {
+    READ,
+    DECODE,
+    DISPATCH,
+    LED_FRAME,
+    WRITE,
+    COUNT
+};
+
+// Histograms (differences between points)
+enum class LatencyStage {
+    READ_TO_DECODE,
+    DECODE_TO_DISPATCH,
+    DISPATCH_TO_LED_FRAME,
+    LED_FRAME_TO_WRITE,
+    READ_TO_WRITE,          // Input report to LED change, the number that matters on stage
+    COUNT
+};
+
+// =============================================================================
+// LATENCY HISTOGRAM - Lock-free, any number of writers and readers
+// =============================================================================
+
+class LatencyHistogram {
+private:
+    std::atomic<uint64_t> buckets[LATENCY_BUCKET_COUNT] = {};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> max_ns{0};
+
+    static int getBucketIndex(uint64_t value_ns);
+    static uint64_t getBucketUpperBound(int index);
+
+public:
+    void record(uint64_t value_ns);
+
+    uint64_t getCount() const;
+    uint64_t getMax() const;
+
+    // Upper bound of the bucket holding the given percentile (0-100), 0 if empty
+    uint64_t getPercentile(double percentile) const;
+};
+
+// =============================================================================
+// PER-REPORT TRACE - One per device thread
+// =============================================================================
+
+struct LatencyTrace {
+    bool active = false;
+    uint64_t point_ns[(int)LatencyPoint::COUNT] = {};
+};
+
+extern thread_local LatencyTrace latency_trace;
+
+inline uint64_t getLatencyClockNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Start a report trace (stamps READ)
+inline void beginLatencyTrace() {
+    latency_trace.active = true;
+    latency_trace.point_ns[(int)LatencyPoint::WRITE] = 0;
+    latency_trace.point_ns[(int)LatencyPoint::READ] = getLatencyClockNs();
+}
+
+// Stamp a point of the current report (ignored outside a report, e.g. timed LED updates)
+inline void markLatencyPoint(LatencyPoint point) {
+    if (latency_trace.active) {
+        latency_trace.point_ns[(int)point] = getLatencyClockNs();
+    }
+}
+
+// Record the stages of the current report into the histograms
+void endLatencyTrace();
+
+// =============================================================================
+// FUNCTION DECLARATIONS - Dump
+// =============================================================================
+
+const LatencyHistogram& getLatencyHistogram(LatencyStage stage);
+
+// Ask for a dump (async-signal-safe, e.g. from a SIGUSR1 handler)
+void requestLatencyDump();
+
+// Print all stages if a dump was requested (called by the device loop, only one thread prints)
+void printLatencyDumpIfRequested();
+
+// Print p50/p99/p99.9/max of every stage in microseconds
+void printLatencyHistograms();
+
+// =============================================================================
+// MACROS - Nothing without TRAKTOR_LATENCY_TRACING
+// =============================================================================
+
+#ifdef TRAKTOR_LATENCY_TRACING
+#define LATENCY_BEGIN_REPORT() beginLatencyTrace()
+#define LATENCY_MARK(point) markLatencyPoint(LatencyPoint::point)
+#define LATENCY_END_REPORT() endLatencyTrace()
+#define LATENCY_POLL_DUMP() printLatencyDumpIfRequested()
+#else
+#define LATENCY_BEGIN_REPORT() ((void)0)
+#define LATENCY_MARK(point) ((void)0)
+#define LATENCY_END_REPORT() ((void)0)
+#define LATENCY_POLL_DUMP() ((void)0)
+#endif
+
+#endif // LATENCY_TRACER_H
@@ -2,20 +2,19 @@
 #define LED_CONTROLLER_H
 
 #include <hidapi/hidapi.h>
+#include "matrix_pad.h"     // For MatrixPad, MATRIX_ROWS, MATRIX_COLS
 
 // =============================================================================
-// GLOBAL LED STATE BYTE BUFFER - Persistent byte buffer for all LED states
+// LED REPORT - Persistent byte buffer for all LED states
 // =============================================================================
 
 // LED output report structure
 const int LED_REPORT_SIZE = 81;              // F1 always expects 81-byte LED reports
 const unsigned char LED_REPORT_ID = 0x80;    // First byte is always 0x80
 
-// This byte buffer holds the current state of all LEDs on the F1.
+// Each F1 has its own LED byte buffer (see LEDControllerContext below).
 // It's persistent, so changing one LED does not affect the others.
 // The byte buffer is always ready to send to the F1 device.
-extern unsigned char led_buffer[LED_REPORT_SIZE];
-extern hid_device* current_device;
 
 // =============================================================================
 // CONSTANTS - These define the structure of the F1's LED output reports
@@ -53,8 +52,6 @@ const int LED_OFFSET_STOP1_LEFT = 7;     // Byte 80
 
 // Matrix LED calculation constants
 const int MATRIX_LEDS_PER_BUTTON = 3;    // Each matrix button has 3 LEDs (B, R, G)
-const int MATRIX_ROWS = 4;               // 4 rows in the matrix
-const int MATRIX_COLS = 4;               // 4 columns in the matrix
 
 
 // =============================================================================
@@ -90,6 +87,8 @@ enum class LEDColor {
     white
 };
 
+const int LED_COLOR_COUNT = 18;     // Number of LEDColor values
+
 // Special buttons enum (matches input_reader structure)
 enum class SpecialLEDButton {
     BROWSE,
@@ -99,6 +98,8 @@ enum class SpecialLEDButton {
     SHIFT
 };
 
+const int SPECIAL_LED_COUNT = 5;    // Number of SpecialLEDButton values
+
 // Control buttons enum (matches input_reader structure)
 enum class ControlLEDButton {
     CAPTURE,
@@ -106,6 +107,8 @@ enum class ControlLEDButton {
     SYNC
 };
 
+const int CONTROL_LED_COUNT = 3;    // Number of ControlLEDButton values
+
 // Stop buttons enum (matches input_reader structure) 
 enum class StopLEDButton {
     STOP1,
@@ -114,6 +117,8 @@ enum class StopLEDButton {
     STOP4
 };
 
+const int STOP_LED_COUNT = 4;       // Number of StopLEDButton values
+
 
 // =============================================================================
 // STATE STORAGE SYSTEM - NEW! Parallel storage for original LED states
@@ -139,6 +144,38 @@ struct LEDState {
 };
 
 
+// =============================================================================
+// LED CONTROLLER CONTEXT - Everything the LED functions keep per F1
+// =============================================================================
+
+/*
+* One context per connected F1. The LED functions below work on the context
+* bound to the calling thread (bindLEDController), so every device thread
+* uses the same functions on its own buffer, frame and state storage.
+*/
+struct LEDControllerContext {
+    unsigned char led_buffer[LED_REPORT_SIZE] = {};        // Current state of all LEDs, ready to send
+    hid_device* device = nullptr;                          // Device for automatic sending
+
+    // LED frame batching
+    int frame_depth = 0;                                   // > 0 while an LED frame is open
+    bool frame_dirty = false;                              // Buffer changed inside the open frame
+    unsigned char last_sent_buffer[LED_REPORT_SIZE] = {};  // Last report that reached the F1
+    bool last_sent_valid = false;                          // last_sent_buffer holds a real report
+
+    // Original color/brightness values (before 7-bit conversion)
+    LEDStateMatrix matrix_states[MATRIX_PAD_COUNT] = {};   // By pad index
+    LEDState special_states[SPECIAL_LED_COUNT] = {};
+    LEDState control_states[CONTROL_LED_COUNT] = {};
+    LEDState stop_states[STOP_LED_COUNT] = {};
+};
+
+// Bind a context to the calling thread (nullptr = shared default context)
+void bindLEDController(LEDControllerContext* context);
+LEDControllerContext* getBoundLEDController();
+unsigned char* getLEDBuffer();              // LED buffer of the bound context
+
+
 
 // =============================================================================
 // FUNCTION DECLARATIONS - Functions are provided to other files
@@ -149,8 +186,19 @@ bool initializeLEDController(hid_device* device);
 bool sendLEDReport(hid_device* device);
 void clearAllLEDs();
 
+// LED frame batching - all LED changes between begin and end go out as one report
+void beginLEDFrame();
+bool endLEDFrame();
+bool commitLEDBuffer();     // Send after a buffer change, or defer while a frame is open
+
+// Hot-plug - buffer and stored states survive a disconnect, replay sends them in one report
+void setLEDControllerDevice(hid_device* device);   // nullptr while disconnected
+bool replayLEDFrame();
+
 // Matrix LED functions (RGB buttons)
-bool setMatrixButtonLED(int row, int col, LEDColor color, float brightness, bool store_led_state = true);
+// Pads are checked where they are created (MatrixPad), so these never fail on the position
+bool setMatrixButtonLED(MatrixPad pad, LEDColor color, float brightness, bool store_led_state = true);
+bool setMatrixButtonRGB(MatrixPad pad, unsigned char red, unsigned char green, unsigned char blue, float brightness = 1.0f);
 
 // Special button LED functions (single brightness)  
 bool setSpecialButtonLED(SpecialLEDButton button, float brightness, bool store_led_state = true);
@@ -163,6 +211,7 @@ bool setStopButtonLED(StopLEDButton button, float brightness, bool store_led_sta
 
 // Color system functions
 BRGColor getColorWithBrightness(LEDColor color, float brightness);
+bool getLEDColorByName(const char* name, LEDColor& color);     // "red", "white", ... (false if unknown)
 
 
 // =============================================================================
@@ -187,7 +236,7 @@ int getControlButtonIndex(ControlLEDButton button);
 int getStopButtonIndex(StopLEDButton button);
 
 // Get original state for matrix buttons
-LEDStateMatrix getMatrixButtonState(int row, int col);
+LEDStateMatrix getMatrixButtonState(MatrixPad pad);
 
 // Get original state for special buttons  
 LEDState getSpecialButtonState(SpecialLEDButton button);
@@ -2,15 +2,43 @@
 #define LED_CONTROLLER_DISPLAY_H
 
 #include <cstdint>                  // For uint8_t type
+#include <array>                    // For std::array (glyph table)
 #include "led_controller.h"
 
 // =============================================================================
-// CONSTANTS - 7-Segment digit patterns lookup table
+// CONSTANTS - 7-Segment glyph table
 // =============================================================================
 
-// 7-Segment digit patterns: [middle, lower_right, upper_right, top, upper_left, lower_left, bottom]
-// 127 = full brightness, 0 = off
-extern const uint8_t DIGIT_PATTERNS[11][7]; // 0-9 + blank (index 10)
+// Segment bits of a glyph: [middle, lower_right, upper_right, top, upper_left, lower_left, bottom]
+const uint8_t SEG_MIDDLE = 0x01;
+const uint8_t SEG_LOWER_RIGHT = 0x02;
+const uint8_t SEG_UPPER_RIGHT = 0x04;
+const uint8_t SEG_TOP = 0x08;
+const uint8_t SEG_UPPER_LEFT = 0x10;
+const uint8_t SEG_LOWER_LEFT = 0x20;
+const uint8_t SEG_BOTTOM = 0x40;
+
+// Glyph for every ASCII character (0-127), unknown characters are blank
+// Covers digits, letters (upper and lower case where they differ) and - _ = ' " [ ] ? *
+// M/N and U/V/W share a glyph (7 segments cannot tell them apart)
+extern const std::array<uint8_t, 128> SEGMENT_GLYPHS;
+
+// Marquee configuration
+const int MAX_MARQUEE_LENGTH = 32;          // Longest text that can be scrolled
+const int DEFAULT_MARQUEE_STEP_MS = 300;    // Time per scroll step
+
+// Value overlay configuration
+const int MAX_DISPLAY_OVERLAYS = 8;         // One per knob/fader
+const int DEFAULT_OVERLAY_TIMEOUT_MS = 1000;// Time a value stays visible after the last change
+const int OVERLAY_SOURCE_KNOB_BASE = 0;     // Overlay source ids: knobs 1-4 = 1-4
+const int OVERLAY_SOURCE_FADER_BASE = 4;    // Overlay source ids: faders 1-4 = 5-8
+
+// One entry of the overlay stack
+struct DisplayOverlay {
+    int source_id;          // Which control the value belongs to
+    uint8_t value;          // Value to show (0-99)
+    uint64_t expiry_ms;     // Time the overlay disappears
+};
 
 // =============================================================================
 // LED CONTROLLER DISPLAY CLASS
@@ -18,13 +46,60 @@ extern const uint8_t DIGIT_PATTERNS[11][7]; // 0-9 + blank (index 10)
 
 class DisplayController {
 private:
-    // Private helper function to set individual display segments
-    void setDisplaySegment(int display, int digit);
+    // Base content (shown when no marquee is running)
+    uint8_t base_glyphs[2] = {0, 0};                // [left, right]
+
+    // Glyphs currently in the LED buffer (to skip unchanged writes)
+    uint8_t shown_glyphs[2] = {0, 0};
+    bool shown_valid = false;
+
+    // Marquee state
+    char marquee_text[MAX_MARQUEE_LENGTH + 1] = {};
+    int marquee_length = 0;                         // Text length
+    int marquee_position = 0;                       // Current scroll step
+    int marquee_step_ms = DEFAULT_MARQUEE_STEP_MS;  // Time per scroll step
+    uint64_t marquee_next_step_ms = 0;              // Time of next scroll step
+    bool marquee_loop = false;                      // Repeat until stopped
+    bool marquee_active = false;
+    uint8_t marquee_glyphs[2] = {0, 0};             // Current marquee window
+
+    // Value overlay stack (top = last entry), covers marquee and base content
+    DisplayOverlay overlays[MAX_DISPLAY_OVERLAYS] = {};
+    int overlay_count = 0;
+
+    // Write one glyph into the LED buffer (no report sent)
+    void writeGlyph(int display, uint8_t glyph);
+
+    // Show two glyphs, only touching the LED buffer if they changed
+    void showGlyphs(uint8_t left, uint8_t right);
+
+    // Compute current marquee window
+    void renderMarqueeStep();
+
+    // Show the top layer: overlay, else marquee, else base content
+    void render();
 
 public:
     // Main display functions
     void setDisplayNumber(int number);
     void setDisplayDot(int display, bool on);
+
+    // Text functions
+    void setDisplayText(const char* text);      // Show up to 2 characters
+    static uint8_t getGlyph(char character);
+
+    // Marquee functions - scroll text across both digits
+    void startMarquee(const char* text, uint64_t now_ms, int step_ms = DEFAULT_MARQUEE_STEP_MS, bool loop = false);
+    void stopMarquee();
+    bool isMarqueeActive() const;
+
+    // Value overlay functions - show a value (00-99) for a while, then fall back
+    void showValueOverlay(int source_id, int value, uint64_t now_ms, int timeout_ms = DEFAULT_OVERLAY_TIMEOUT_MS);
+    void clearOverlays();
+    bool hasOverlay() const;
+
+    // Advance animations and expire overlays - call once per main loop tick
+    void tick(uint64_t now_ms);
 };
 
-#endif // LED_CONTROLLER_DISPLAY_H
\ No newline at end of file
+#endif // LED_CONTROLLER_DISPLAY_H
@@ -1,6 +1,7 @@
 #ifndef LED_CONTROLLER_TOGGLE_H
 #define LED_CONTROLLER_TOGGLE_H
 
+#include <cstdint>          // For uint32_t mask types
 #include "input_reader.h"   // Access to the input reading functions
 #include "led_controller.h" // Access to the LED controller functions and state structures
 
@@ -10,9 +11,103 @@
 
 enum class MatrixToggleZone {
     FULL_MATRIX,        // All 16 buttons = 1 zone (default behavior)
-    LEFT_RIGHT_SPLIT    // Columns 1-2 and 3-4 = 2 independent zones
+    LEFT_RIGHT_SPLIT,   // Columns 1-2 and 3-4 = 2 independent zones
+    ROWS,               // Each row = 1 zone (4 radio groups)
+    COLUMNS,            // Each column = 1 zone (4 radio groups)
+    QUADRANTS,          // Each 2x2 corner = 1 zone
+    FREE,               // Every button toggles on its own (no exclusivity)
+    CUSTOM              // User-defined layout, see setMatrixZoneLayout()
 };
 
+// =============================================================================
+// MATRIX ZONE MAP - Compiled zone layout for constant-time exclusivity checks
+// =============================================================================
+
+// Maximum number of matrix zones (every button in its own zone)
+const int MAX_MATRIX_ZONES = 16;
+
+// Layout value for a button that toggles on its own (free-toggle pad)
+const int MATRIX_ZONE_FREE = -1;
+
+/*
+* Zone layouts are written as a 4x4 grid of zone ids, indexed [row-1][col-1]:
+*
+*   const int layout[4][4] = {
+*       {0, 0, 1, 1},
+*       {0, 0, 1, 1},
+*       {2, 2, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE},
+*       {2, 2, MATRIX_ZONE_FREE, MATRIX_ZONE_FREE}
+*   };
+*
+* Buttons with the same id are exclusive. compileMatrixZoneMap() turns the grid
+* into a 16-entry button->zone lookup plus one bit mask per zone, so the toggle
+* system never has to search the layout at runtime.
+*/
+struct MatrixZoneMap {
+    uint8_t button_zone[16];                // Zone id for each matrix bit (0-15)
+    uint32_t zone_masks[MAX_MATRIX_ZONES];  // Matrix bits belonging to each zone
+    int zone_count;                         // Number of zones in use
+};
+
+// Compile a 4x4 layout grid into a zone map (false if a zone id is out of range)
+bool compileMatrixZoneMap(const int layout[4][4], MatrixZoneMap& zone_map);
+
+// Get the compiled zone map for one of the predefined modes (not CUSTOM)
+MatrixZoneMap getPresetMatrixZoneMap(MatrixToggleZone mode);
+
+// =============================================================================
+// TOGGLE BIT LAYOUT - Every toggleable button owns one bit in a 32-bit mask
+// =============================================================================
+
+/*
+* Bit layout shared by all toggle and was-pressed masks:
+*
+*   Bits  0-15: Matrix buttons, bit = (row-1) * 4 + (col-1)
+*   Bits 16-20: Special buttons, bit = 16 + getSpecialButtonIndex()
+*   Bits 21-23: Control buttons, bit = 21 + getControlButtonIndex()
+*   Bits 24-27: Stop buttons,    bit = 24 + getStopButtonIndex()
+*/
+const int TOGGLE_BIT_MATRIX_START = 0;
+const int TOGGLE_BIT_SPECIAL_START = 16;
+const int TOGGLE_BIT_CONTROL_START = 21;
+const int TOGGLE_BIT_STOP_START = 24;
+const int TOGGLE_BIT_COUNT = 28;
+
+const uint32_t TOGGLE_MASK_MATRIX = 0x0000FFFF;   // All 16 matrix buttons
+
+// =============================================================================
+// BUTTON BEHAVIORS - How a button reacts to press and release
+// =============================================================================
+
+enum class ButtonBehavior : uint8_t {
+    LATCH,      // Press toggles between original and full brightness (default for non-matrix buttons)
+    RADIO,      // Like LATCH, but untoggles the other buttons in the same matrix zone (default for matrix)
+    MOMENTARY,  // Full brightness while held, original brightness when released
+    CYCLE,      // Each press steps to the next color/brightness, wraps back to original
+    ONE_SHOT    // Press flashes full brightness, restored after one_shot_ms
+};
+
+const int BUTTON_BEHAVIOR_COUNT = 5;
+const int MAX_CYCLE_STEPS = 8;                 // Step 0 is always the original state
+const uint16_t DEFAULT_ONE_SHOT_MS = 150;      // Default flash length for ONE_SHOT
+
+/*
+* Behavior configuration for one button
+* cycle_colors is only used by matrix buttons, single-color buttons only use cycle_brightness
+*/
+struct ButtonBehaviorConfig {
+    ButtonBehavior behavior;
+    uint8_t cycle_steps;                        // CYCLE: number of steps including original (2-8)
+    LEDColor cycle_colors[MAX_CYCLE_STEPS];     // CYCLE: color per step (step 0 unused)
+    float cycle_brightness[MAX_CYCLE_STEPS];    // CYCLE: brightness per step (step 0 unused)
+    uint16_t one_shot_ms;                       // ONE_SHOT: flash length in milliseconds
+};
+
+// Behavior config helpers
+ButtonBehaviorConfig makeButtonBehavior(ButtonBehavior behavior);
+ButtonBehaviorConfig makeOneShotBehavior(uint16_t flash_ms = DEFAULT_ONE_SHOT_MS);
+ButtonBehaviorConfig makeCycleBehavior(const LEDColor* colors, const float* brightness, int steps);
+
 // =============================================================================
 // BUTTON TOGGLE SYSTEM - Main
 // =============================================================================
@@ -22,28 +117,30 @@ struct ButtonToggleSystem {
     // =======================================
     // Variables to track button toggle states
     // =======================================
-    // Toggle state tracking arrays
-    bool special_toggled[5];           // Track which special buttons are toggled
-    bool control_toggled[3];           // Track which control buttons are toggled
-    bool stop_toggled[4];              // Track which stop buttons are toggled
-    bool matrix_toggled[5][5];         // Track which matrix buttons are toggled
-    
-    // Toggle state tracking for immediate button toggle - track if button was tracked in last while(true) frame
-    bool special_was_pressed[5];       // Track if special button was pressed in last frame
-    bool control_was_pressed[3];       // Track if control button was pressed in last frame
-    bool stop_was_pressed[4];          // Track if stop button was pressed in last frame
-    bool matrix_was_pressed[5][5];     // Track if matrix button was pressed in last frame
+    // One bit per button (see TOGGLE BIT LAYOUT above)
+    uint32_t toggled_mask;             // Bit set = button is toggled to full brightness
+    uint32_t was_pressed_mask;         // Bit set = button was pressed in last while(true) frame
+
+    // =======================================
+    // Per-button behavior state
+    // =======================================
+    ButtonBehaviorConfig behaviors[TOGGLE_BIT_COUNT];   // Behavior for each button bit
+    uint8_t cycle_step[TOGGLE_BIT_COUNT];               // CYCLE: current step (0 = original)
+    uint64_t one_shot_expiry_ms[TOGGLE_BIT_COUNT];      // ONE_SHOT: time the flash ends
+    uint32_t one_shot_mask;                             // Bit set = one-shot flash is running
+    uint64_t current_time_ms;                           // Time of the last processed frame/tick
 
     // =======================================
     // Matrix zone mode configuration
     // =======================================
-    MatrixToggleZone current_matrix_mode;  // Current zone configuration
+    MatrixToggleZone current_matrix_mode;       // Current zone configuration
+    MatrixZoneMap zone_map;                     // Compiled zones for the current configuration
 
     // =======================================
     // Matrix toggle brightness constant
     // =======================================
     static constexpr float TOGGLED_BRIGHTNESS = 1.0f;
-    
+
     // =======================================
     // Matrix main functions
     // =======================================
@@ -54,28 +151,78 @@ struct ButtonToggleSystem {
     bool toggleSpecialButton(SpecialLEDButton button);
     bool toggleControlButton(ControlLEDButton button);
     bool toggleStopButton(StopLEDButton button);
-    bool toggleMatrixButton(int row, int col);
+    bool toggleMatrixButton(MatrixPad pad);
 
     bool shouldToggleSpecialButton(unsigned char* input_data, SpecialButton button, SpecialLEDButton led_button);
     bool shouldToggleControlButton(unsigned char* input_data, ControlButton button, ControlLEDButton led_button);
     bool shouldToggleStopButton(unsigned char* input_data, StopButton button, StopLEDButton led_button);
-    bool shouldToggleMatrixButton(unsigned char* input_data, int row, int col);
+    bool shouldToggleMatrixButton(unsigned char* input_data, MatrixPad pad);
 
     void updateButtonStates(unsigned char* input_report);
     void resetAllToggleStates();
-    
+
+    // Build the pressed-button mask for an input report (same bit layout as toggled_mask)
+    static uint32_t getPressedButtonMask(const unsigned char* input_report);
+
+    // =======================================
+    // Behavior dispatch functions
+    // =======================================
+    // Handle all button presses/releases of one report through the behavior table
+    void processInputReport(const unsigned char* input_report, uint64_t now_ms);
+
+    // Release every button still held in the edge state (e.g. after a reconnect)
+    void releaseAllButtons(uint64_t now_ms);
+
+    // Advance timed behaviors (ONE_SHOT) - call once per main loop tick
+    void updateTimedBehaviors(uint64_t now_ms);
+
+    // Behavior configuration
+    void setButtonBehavior(int bit, const ButtonBehaviorConfig& config);
+    void resetButtonBehaviors();
+    ButtonBehavior getButtonBehavior(int bit) const;
+
+    // Map buttons to their bit in the toggle masks (-1 if invalid, matrix pads are always valid)
+    static constexpr int getMatrixButtonBit(MatrixPad pad) { return TOGGLE_BIT_MATRIX_START + pad.index(); }
+    static int getSpecialButtonBit(SpecialLEDButton button);
+    static int getControlButtonBit(ControlLEDButton button);
+    static int getStopButtonBit(StopLEDButton button);
+
     // =======================================
     // Matrix zone toggle functions
     // =======================================
     // Zone configuration
-    void setMatrixToggleMode(MatrixToggleZone mode);
+    void setMatrixToggleMode(MatrixToggleZone mode);   // Predefined layouts only (CUSTOM is rejected)
+    bool setMatrixZoneLayout(const int layout[4][4]);
+    void setMatrixZoneMap(const MatrixZoneMap& map, MatrixToggleZone mode = MatrixToggleZone::CUSTOM);
     MatrixToggleZone getMatrixToggleMode() const;
 
      // Zone utility functions
-    int getButtonZone(int row, int col) const;
+    int getButtonZone(MatrixPad pad) const;
     void untoggleMatrixZone(int zone_id);
     void untoggleAllMatrixButtons();
-    
+
+private:
+    // Restore original LED states for every button bit set in the mask
+    void restoreButtons(uint32_t button_bits);
+
+    // Generic per-bit LED helpers
+    void setButtonLED(int bit, LEDColor color, float brightness);
+    void setButtonFullBrightness(int bit);
+    void restoreButtonLED(int bit);
+
+    // Dispatch one press/release edge to the button's behavior handler
+    void dispatchButtonEdge(int bit, bool pressed);
+
+    // Behavior handlers, one per ButtonBehavior (see behavior_handlers table)
+    void handleLatch(int bit, bool pressed);
+    void handleRadio(int bit, bool pressed);
+    void handleMomentary(int bit, bool pressed);
+    void handleCycle(int bit, bool pressed);
+    void handleOneShot(int bit, bool pressed);
+
+    using BehaviorHandler = void (ButtonToggleSystem::*)(int bit, bool pressed);
+    static const BehaviorHandler behavior_handlers[BUTTON_BEHAVIOR_COUNT];
+
 };
 
-#endif // LED_CONTROLLER_TOGGLE_H
\ No newline at end of file
+#endif // LED_CONTROLLER_TOGGLE_H
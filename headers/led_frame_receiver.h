@@ -0,0 +1,113 @@
+#ifndef LED_FRAME_RECEIVER_H
+#define LED_FRAME_RECEIVER_H
+
+#include <cstdint>                      // For fixed-size integer types
+#include <atomic>                       // For std::atomic (frame publication)
+#include "led_controller_display.h"     // For DisplayController
+
+// =============================================================================
+// CONSTANTS - Shared memory LED frame configuration
+// =============================================================================
+
+const char LED_FRAME_SHM_DEFAULT_NAME[] = "/visual_sync_f1_leds";
+const uint32_t LED_FRAME_SHM_MAGIC = 0x46314C46;    // "F1LF"
+const uint32_t LED_FRAME_SHM_VERSION = 1;           // Bump when ExternalLEDFrame changes
+const int LED_FRAME_READ_MAX_RETRIES = 4;           // Torn copies before a frame counts as dropped
+
+// Which parts of a frame are used (ExternalLEDFrame::flags)
+const uint8_t LED_FRAME_HAS_MATRIX = 0x01;
+const uint8_t LED_FRAME_HAS_BUTTONS = 0x02;
+const uint8_t LED_FRAME_HAS_DISPLAY = 0x04;
+
+// =============================================================================
+// SHARED LAYOUT - Written by the external renderer, read by the controller
+// =============================================================================
+
+/*
+* One LED frame from an external renderer
+* Matrix is indexed [row-1][col-1][r,g,b] with 8-bit values,
+* button brightness is 0-255 (0 = off, 255 = full)
+*/
+struct ExternalLEDFrame {
+    uint8_t flags;                      // LED_FRAME_HAS_* bits
+    uint8_t matrix_rgb[4][4][3];        // RGB per pad
+    uint8_t special_brightness[5];      // browse, size, type, reverse, shift
+    uint8_t control_brightness[3];      // capture, quant, sync
+    uint8_t stop_brightness[4];         // stop 1-4
+    char display_text[2];               // Left and right character (' ' = blank)
+};
+
+/*
+* Double buffer: the renderer writes into the buffer that is not published,
+* then publishes it. Each buffer also has its own sequence (odd = writing),
+* so the controller can detect when the renderer overwrote a buffer while it
+* was being copied (renderer two frames ahead).
+*
+*   published = (frame_number << 1) | buffer_index, frame_number starts at 1
+*/
+struct LEDFrameSegment {
+    uint32_t magic;                             // LED_FRAME_SHM_MAGIC once initialized
+    uint32_t version;                           // LED_FRAME_SHM_VERSION
+    std::atomic<uint64_t> published;            // Latest complete frame
+    std::atomic<uint32_t> buffer_sequence[2];   // Per-buffer seqlock
+    ExternalLEDFrame buffers[2];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Frame publication must be lock-free to work across processes");
+
+// =============================================================================
+// RENDERER SIDE - For external C++ renderers (and testing)
+// =============================================================================
+
+// Map the controller's LED frame segment read/write (nullptr if missing or wrong version)
+LEDFrameSegment* openLEDFrameSegment(const char* name = LED_FRAME_SHM_DEFAULT_NAME);
+void closeLEDFrameSegment(LEDFrameSegment* segment);
+
+// Write and publish one frame (single renderer per segment)
+void writeLEDFrame(LEDFrameSegment* segment, const ExternalLEDFrame& frame);
+
+// =============================================================================
+// LED FRAME RECEIVER CLASS - Controller side
+// =============================================================================
+
+class LEDFrameReceiver {
+private:
+    LEDFrameSegment* segment = nullptr;
+    bool owns_shm_name = false;             // Unlink the shm name on close
+    char shm_name[64] = {};
+
+    uint64_t last_frame_number = 0;         // Last consumed (or skipped) frame
+
+    // Statistics
+    uint32_t consumed_count = 0;
+    uint32_t dropped_count = 0;
+
+    // Copy the published frame, false if it was overwritten during every attempt
+    bool copyLatestFrame(ExternalLEDFrame& frame, uint64_t& frame_number);
+
+    // Write one frame into the LED buffer/display
+    void applyFrame(const ExternalLEDFrame& frame, DisplayController& display);
+
+public:
+    // Create the named segment renderers write into
+    bool open(const char* name = LED_FRAME_SHM_DEFAULT_NAME);
+
+    // Use a private in-process segment (no shm name, for testing and single-process use)
+    bool openInProcess();
+
+    void close();
+    bool isOpen() const;
+
+    // Apply the newest frame if there is one - call once per main loop tick inside the LED frame
+    // @return: true if a frame was applied
+    bool poll(DisplayController& display);
+
+    // Segment access for in-process renderers
+    LEDFrameSegment* getSegment();
+
+    // Statistics
+    uint32_t getConsumedCount() const;      // Frames applied to the LEDs
+    uint32_t getDroppedCount() const;       // Frames replaced by a newer one before the next tick, or torn
+};
+
+#endif // LED_FRAME_RECEIVER_H
@@ -2,6 +2,7 @@
 #define LED_SCENE_CONTROLLER_H
 
 #include "led_controller.h"
+#include "led_controller_toggle.h"
 #include <hidapi/hidapi.h>
 
 
@@ -21,6 +22,27 @@ public:
      */
     static void setEffectsPageScene(int effects_page);
 
+    /*
+     * Apply the matrix toggle zones for the specified effects page
+     * @param toggle_system Button toggle system to configure
+     * @param effects_page Effects page number (1-99)
+     */
+    static void setEffectsPageZones(ButtonToggleSystem& toggle_system, int effects_page);
+
+    /*
+     * Apply the button behaviors (latch, momentary, cycle, ...) for the specified effects page
+     * @param toggle_system Button toggle system to configure
+     * @param effects_page Effects page number (1-99)
+     */
+    static void setEffectsPageBehaviors(ButtonToggleSystem& toggle_system, int effects_page);
+
+    /*
+     * Get the name of the specified effects page (scrolled on the display when loaded)
+     * @param effects_page Effects page number (1-99)
+     * @return Page name, or nullptr if the page has no name
+     */
+    static const char* getEffectsPageName(int effects_page);
+
 private:
     /*
      * Apply scene for effects page 1 - All Green
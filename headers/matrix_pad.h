@@ -0,0 +1,73 @@
+#ifndef MATRIX_PAD_H
+#define MATRIX_PAD_H
+
+#include <cstdint>          // For uint8_t
+
+// =============================================================================
+// MATRIX PAD - A matrix button position that is always valid
+// =============================================================================
+
+const int MATRIX_ROWS = 4;               // 4 rows in the matrix
+const int MATRIX_COLS = 4;               // 4 columns in the matrix
+const int MATRIX_PAD_COUNT = MATRIX_ROWS * MATRIX_COLS;
+
+/*
+* Row and column (1-4) of one of the 16 matrix buttons, stored as the pad
+* index (row-1) * 4 + (col-1) that every table is indexed by.
+*
+* Positions are checked once where they enter the program, after that no
+* function has to check them again:
+*
+*   MatrixPad(2, 3)                 Literal position, checked by the compiler
+*   setMatrixButtonLED({2, 3}, ...) (consteval: an invalid literal does not compile)
+*   MatrixPad::fromRowCol(r, c, pad)  Position from outside (OSC, control socket),
+*                                     false if it is not on the matrix
+*   MatrixPad::fromIndex(i)         Loops over all pads (0-15)
+*/
+class MatrixPad {
+private:
+    uint8_t pad_index = 0;
+
+    static consteval uint8_t checkedIndex(int row, int col) {
+        if (row < 1 || row > MATRIX_ROWS || col < 1 || col > MATRIX_COLS) {
+            throw "MatrixPad: row and column must be 1-4";     // Not a constant expression = compile error
+        }
+        return (uint8_t)((row - 1) * MATRIX_COLS + (col - 1));
+    }
+
+    struct IndexTag {};
+    constexpr MatrixPad(IndexTag, int index) : pad_index((uint8_t)(index & (MATRIX_PAD_COUNT - 1))) {}
+
+public:
+    // Pad (1,1)
+    constexpr MatrixPad() = default;
+
+    // Compile-time position
+    consteval MatrixPad(int row, int col) : pad_index(checkedIndex(row, col)) {}
+
+    // Pad index 0-15 (only the low 4 bits are used, so the result is always a pad)
+    static constexpr MatrixPad fromIndex(int index) {
+        return MatrixPad(IndexTag{}, index);
+    }
+
+    // Runtime position from outside the program
+    // @return: false (pad unchanged) if row or col is not 1-4
+    static constexpr bool fromRowCol(int row, int col, MatrixPad& pad) {
+        if (row < 1 || row > MATRIX_ROWS || col < 1 || col > MATRIX_COLS) {
+            return false;
+        }
+        pad = fromIndex((row - 1) * MATRIX_COLS + (col - 1));
+        return true;
+    }
+
+    constexpr int index() const { return pad_index; }
+    constexpr int row() const { return pad_index / MATRIX_COLS + 1; }
+    constexpr int col() const { return pad_index % MATRIX_COLS + 1; }
+
+    constexpr bool operator==(const MatrixPad& other) const = default;
+};
+
+static_assert(MatrixPad(1, 1).index() == 0 && MatrixPad(4, 4).index() == 15, "Pad index = (row-1) * 4 + (col-1)");
+static_assert(MatrixPad(3, 2).row() == 3 && MatrixPad(3, 2).col() == 2, "Pad index round trip");
+
+#endif // MATRIX_PAD_H
@@ -0,0 +1,84 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <cstdint>                  // For uint64_t
+#include <atomic>                   // For std::atomic (counters and gauges)
+#include "latency_tracer.h"         // For LatencyHistogram (LED write time)
+
+// =============================================================================
+// CONSTANTS - Metrics
+// =============================================================================
+
+const int METRICS_MAX_DEVICES = 8;          // Same as MAX_F1_DEVICES
+
+/*
+* USB I/O and health metrics per F1
+*
+* Counters and gauges are relaxed atomics: the device thread adds, the metrics
+* server thread reads, nobody waits. The device thread binds its slot once
+* (bindDeviceMetrics), after that the count functions need no device argument,
+* like the LED functions after bindLEDController().
+*/
+
+// Only ever increase
+enum class MetricCounter : uint8_t {
+    INPUT_REPORTS,              // Input reports read
+    READ_ERRORS,                // hid_read failed (unplugged, USB error)
+    INVALID_REPORTS,            // Short reports or reports with an unexpected report ID
+    LED_REPORTS,                // LED reports written completely
+    LED_FRAMES_SUPPRESSED,      // LED frames not sent because the F1 already shows them
+    LED_PARTIAL_WRITES,         // hid_write wrote fewer bytes than the LED report
+    LED_WRITE_ERRORS,           // hid_write failed
+    LED_WRITE_NS,               // Total time spent in hid_write (LED reports)
+    RECONNECTS,                 // Reopened after a disconnect
+    COUNT
+};
+
+// Current values
+enum class MetricGauge : uint8_t {
+    CONNECTED,                  // 1 while the F1 is open
+    INPUT_REPORTS_PER_SECOND,   // Updated every second by the metrics server
+    LED_REPORTS_PER_SECOND,
+    COUNT
+};
+
+struct DeviceMetrics {
+    std::atomic<bool> registered{false};
+    std::atomic<uint64_t> counters[(int)MetricCounter::COUNT] = {};
+    std::atomic<uint64_t> gauges[(int)MetricGauge::COUNT] = {};
+    LatencyHistogram led_write_time;
+
+    // Rate calculation (metrics server thread only)
+    uint64_t rate_input_reports = 0;
+    uint64_t rate_led_reports = 0;
+};
+
+// Slot of the calling thread (slot 0 = not bound, never exported)
+extern thread_local DeviceMetrics* device_metrics;
+
+inline void countMetric(MetricCounter counter, uint64_t amount = 1) {
+    device_metrics->counters[(int)counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+inline void setMetricGauge(MetricGauge gauge, uint64_t value) {
+    device_metrics->gauges[(int)gauge].store(value, std::memory_order_relaxed);
+}
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+
+// Bind the calling thread to the metrics of this F1 (1-based) and export them
+void bindDeviceMetrics(int device_number);
+
+// Count one LED report write: time, complete/partial/failed
+void recordLEDWrite(uint64_t duration_ns, int bytes_written, int report_size);
+
+// Recalculate the per-second gauges (call about once per second)
+void updateMetricRates(uint64_t elapsed_ns);
+
+// Write all exported metrics in Prometheus text format
+// @return: Length written (output is cut at buffer_size - 1)
+int formatPrometheusMetrics(char* buffer, int buffer_size);
+
+#endif // METRICS_REGISTRY_H
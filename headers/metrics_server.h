@@ -0,0 +1,51 @@
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+#include <atomic>                       // For std::atomic (stop flag)
+#include <thread>                       // For std::thread (server thread)
+
+// =============================================================================
+// CONSTANTS - Metrics endpoint configuration
+// =============================================================================
+
+const int METRICS_DEFAULT_PORT = 9102;
+const int METRICS_RESPONSE_SIZE = 16384;        // Prometheus text of all F1s
+const int METRICS_REQUEST_SIZE = 1024;          // Only the request line is looked at
+const int METRICS_POLL_TIMEOUT_MS = 1000;       // Per-second gauges are updated this often
+const int METRICS_CLIENT_TIMEOUT_MS = 200;      // Slow clients are dropped
+
+/*
+* Minimal HTTP endpoint on 127.0.0.1 for Prometheus (or curl):
+*
+*   GET /metrics    ->  200, metrics in Prometheus text format (version 0.0.4)
+*   anything else   ->  404
+*
+* One connection at a time, closed after the response. The server thread also
+* updates the per-second gauges, so they are only calculated while it runs.
+*/
+
+// =============================================================================
+// METRICS SERVER CLASS
+// =============================================================================
+
+class MetricsServer {
+private:
+    int listen_fd = -1;
+    int port = 0;
+    std::thread server_thread;
+    std::atomic<bool> stop_requested{false};
+
+    // Server thread functions
+    void run();
+    void serveClient(int fd);
+
+public:
+    // Listen on 127.0.0.1:port and start the server thread
+    bool start(int port);
+    void stop();
+    bool isRunning() const;
+
+    ~MetricsServer();
+};
+
+#endif // METRICS_SERVER_H
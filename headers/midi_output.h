@@ -0,0 +1,135 @@
+#ifndef MIDI_OUTPUT_H
+#define MIDI_OUTPUT_H
+
+#include <cstdint>                      // For uint8_t, uint16_t, uint32_t types
+#include <cstdio>                       // For FILE (text sink)
+#include "led_controller_toggle.h"      // For TOGGLE_BIT_COUNT (button bit layout)
+#include "input_reader_knob.h"          // For KNOB_COUNT and raw knob values
+#include "input_reader_fader.h"         // For FADER_COUNT and raw fader values
+
+#ifdef HAVE_ALSA
+#include <alsa/asoundlib.h>             // ALSA sequencer (virtual MIDI port)
+#endif
+
+// =============================================================================
+// CONSTANTS - MIDI output configuration
+// =============================================================================
+
+const char MIDI_DEFAULT_PORT_NAME[] = "Visual Sync F1";
+const int MIDI_ANALOG_COUNT = KNOB_COUNT + FADER_COUNT;    // Knobs first, then faders
+const int MIDI_DEFAULT_MESSAGES_PER_SECOND = 1000;          // Per MIDI channel, about what a DIN cable carries
+const int MIDI_RATE_BURST_MS = 20;                          // Token bucket holds this much time worth of messages
+const int MIDI_TEXT_BUFFER_SIZE = 4096;                     // Text sink stdio buffer (owned, so writes never allocate)
+
+// Where MIDI messages go
+enum class MidiBackend {
+    NONE,       // Closed
+    ALSA,       // Virtual ALSA sequencer port (only if built with HAVE_ALSA)
+    TEXT_FILE   // One text line per message into a file or named pipe (for testing)
+};
+
+// How 12-bit knobs/faders are sent
+enum class MidiAnalogMode {
+    CC14,       // 14-bit CC pair: MSB on CC n, LSB on CC n+32
+    NRPN        // NRPN: CC 99/98 parameter, CC 6/38 data
+};
+
+/*
+* Mapping of controls to MIDI messages (channels are 0-15)
+*
+*   Matrix buttons:          Note on/off, note = matrix_first_note + toggle bit (row-major)
+*   Special/control/stop:    CC 127/0, cc = button_first_cc + (toggle bit - 16)
+*   Knobs 1-4, faders 1-4:   CC14 on analog_first_cc + index (0-7), or NRPN nrpn_first_param + index
+*/
+struct MidiMappingConfig {
+    uint8_t button_channel;
+    uint8_t knob_channel;
+    uint8_t fader_channel;
+    uint8_t matrix_first_note;
+    uint8_t button_first_cc;
+    uint8_t analog_first_cc;
+    uint16_t nrpn_first_param;
+    MidiAnalogMode analog_mode;
+    int messages_per_second;        // Rate limit per MIDI channel
+};
+
+// Default mapping: all on channel 1, matrix on notes 36-51, buttons on CC 102-113, analog on CC 16-23 (+32 LSB)
+MidiMappingConfig getDefaultMidiMapping();
+
+// =============================================================================
+// MIDI OUTPUT CLASS
+// =============================================================================
+
+class MidiOutput {
+private:
+    MidiBackend backend = MidiBackend::NONE;
+    MidiMappingConfig mapping = getDefaultMidiMapping();
+
+    // Text sink
+    FILE* text_file = nullptr;
+    char text_buffer[MIDI_TEXT_BUFFER_SIZE];
+
+#ifdef HAVE_ALSA
+    // ALSA sequencer
+    snd_seq_t* seq = nullptr;
+    int seq_port = -1;
+#endif
+
+    // Last state for change detection
+    uint32_t last_button_mask = 0;
+    uint16_t last_sent_values[MIDI_ANALOG_COUNT] = {};         // Last sent 14-bit value per control
+    bool has_last_state = false;
+
+    // Coalesced analog updates waiting for rate limit tokens (latest value wins)
+    uint16_t pending_values[MIDI_ANALOG_COUNT] = {};
+    uint32_t pending_mask = 0;
+    int flush_start_index = 0;                                  // Round robin start for flushPendingAnalog()
+
+    // Rate limiting: one token bucket per MIDI channel (tokens = messages, may go negative)
+    int channel_tokens[16] = {};
+    uint64_t last_refill_ms = 0;
+
+    // Statistics
+    uint32_t sent_count = 0;
+    uint32_t coalesced_count = 0;
+
+    // Current time for the text sink
+    uint64_t current_time_ms = 0;
+
+    // Readers for raw 12-bit analog values
+    KnobInputReader knob_reader;
+    FaderInputReader fader_reader;
+
+    // Helper functions
+    void resetState();
+    void refillTokens(uint64_t now_ms);
+    int getRateBurst() const;
+    uint8_t getAnalogChannel(int index) const;
+    void flushPendingAnalog();
+    void sendAnalog(int index, uint16_t value14);
+    void sendMessage(uint8_t status, uint8_t data1, uint8_t data2);
+    void flushOutput();
+
+public:
+    // Open one backend (closes the previous one)
+    bool openAlsaPort(const char* port_name = MIDI_DEFAULT_PORT_NAME);
+    bool openTextSink(const char* path);
+    void close();
+    bool isOpen() const;
+
+    // Mapping configuration
+    void setMapping(const MidiMappingConfig& config);
+    const MidiMappingConfig& getMapping() const;
+
+    // Send all button changes and queue all analog changes of one report
+    void processInputReport(const unsigned char* input_report, uint64_t now_ms);
+
+    // Send queued analog updates when rate limit allows - call once per main loop tick
+    void tick(uint64_t now_ms);
+
+    // Statistics
+    uint32_t getSentCount() const;          // Messages sent since open
+    uint32_t getCoalescedCount() const;     // Analog updates replaced by a newer value before sending
+};
+
+#endif // MIDI_OUTPUT_H
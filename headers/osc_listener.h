@@ -0,0 +1,78 @@
+#ifndef OSC_LISTENER_H
+#define OSC_LISTENER_H
+
+#include <cstdint>                      // For int32_t, uint32_t types
+#include "led_controller.h"             // For LED functions and LEDColor
+#include "led_controller_display.h"     // For DisplayController
+
+// =============================================================================
+// CONSTANTS - OSC input configuration
+// =============================================================================
+
+const int OSC_LISTEN_DEFAULT_PORT = 9001;       // Feedback from the visual software
+const int OSC_MAX_PACKET_SIZE = 1536;           // Larger packets are dropped
+const int OSC_MAX_PACKETS_PER_POLL = 64;        // Rest waits for the next tick
+const int OSC_MAX_ARGUMENTS = 4;                // More arguments are ignored
+const int OSC_MAX_BUNDLE_DEPTH = 4;             // Nested bundles deeper than this are ignored
+const float OSC_MAX_INT_ARGUMENT = 1000000.0f;  // Larger float arguments are rejected where an int is expected
+
+/*
+* Addresses received (all LED changes of one tick go out as one LED report):
+*
+*   /f1/led/matrix/<row>/<col>  color (string name or int 0-17), [brightness float 0.0-1.0]
+*   /f1/led/button/<name>       brightness float 0.0-1.0 (browse, size, type, reverse, shift, capture, quant, sync)
+*   /f1/led/stop/<1-4>          brightness float 0.0-1.0
+*   /f1/display/number          int 1-99 (same range as setDisplayNumber)
+*   /f1/display/text            string (up to 2 characters)
+*   /f1/display/dot/<1-2>       int 1 = on, 0 = off
+*
+* Numbers may be sent as int or float. Messages with a brightness outside
+* 0.0-1.0 (or NaN) or a number out of range are ignored.
+*/
+
+// Parsed arguments of one OSC message (strings point into the packet)
+struct OscArguments {
+    int count;
+    char types[OSC_MAX_ARGUMENTS];
+    int32_t ints[OSC_MAX_ARGUMENTS];
+    float floats[OSC_MAX_ARGUMENTS];
+    const char* strings[OSC_MAX_ARGUMENTS];
+};
+
+// =============================================================================
+// OSC LISTENER CLASS
+// =============================================================================
+
+class OscListener {
+private:
+    int socket_fd = -1;                                 // Bound non-blocking UDP socket, -1 if closed
+    unsigned char packet_buffer[OSC_MAX_PACKET_SIZE];
+
+    // Statistics
+    uint32_t applied_count = 0;
+    uint32_t ignored_count = 0;
+
+    // Parsing helpers
+    void handlePacket(const unsigned char* data, int length, DisplayController& display, int depth);
+    void handleMessage(const unsigned char* data, int length, DisplayController& display);
+
+    // Apply one message to the LED buffer/display
+    bool applyMessage(const char* address, const OscArguments& args, DisplayController& display);
+
+public:
+    // Bind UDP socket on all interfaces (port 0 = any free port, see getPort)
+    bool initialize(int port);
+    void close();
+    bool isOpen() const;
+    int getPort() const;                // Bound UDP port, -1 if closed
+
+    // Apply all waiting messages - call once per main loop tick inside the LED frame
+    // @return: Number of applied messages
+    int poll(DisplayController& display);
+
+    // Statistics
+    uint32_t getAppliedCount() const;
+    uint32_t getIgnoredCount() const;   // Unknown addresses or wrong arguments
+};
+
+#endif // OSC_LISTENER_H
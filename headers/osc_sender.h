@@ -0,0 +1,96 @@
+#ifndef OSC_SENDER_H
+#define OSC_SENDER_H
+
+#include <cstdint>                      // For uint16_t, uint32_t types
+#include "led_controller_toggle.h"      // For TOGGLE_BIT_COUNT (button bit layout)
+#include "input_reader_knob.h"          // For KNOB_COUNT and raw knob values
+#include "input_reader_fader.h"         // For FADER_COUNT and raw fader values
+
+// =============================================================================
+// CONSTANTS - OSC output configuration
+// =============================================================================
+
+const char OSC_DEFAULT_HOST[] = "127.0.0.1";    // Visual software runs on the same machine
+const int OSC_DEFAULT_PORT = 9000;
+
+/*
+* Addresses sent (one per control):
+*
+*   /f1/knob/1-4           float 0.0-1.0
+*   /f1/fader/1-4          float 0.0-1.0
+*   /f1/matrix/<row>/<col> int 1 = pressed, 0 = released
+*   /f1/button/<name>      int (browse, size, type, reverse, shift, capture, quant, sync)
+*   /f1/stop/1-4           int
+*
+* All changes of one input report are sent as one OSC bundle (immediate time tag).
+* With several F1s, the second one sends /f2/..., the third /f3/... and so on.
+*/
+const int OSC_ADDRESS_SIZE = 24;                                // Longest address incl. padding (up to /f99)
+const int OSC_ANALOG_COUNT = KNOB_COUNT + FADER_COUNT;          // Knobs first, then faders
+const int OSC_BUTTON_COUNT = TOGGLE_BIT_COUNT;                  // Same bit layout as the toggle masks
+const int OSC_BUNDLE_HEADER_SIZE = 16;                          // "#bundle\0" + 8 byte time tag
+const int OSC_MESSAGE_MAX_SIZE = 4 + OSC_ADDRESS_SIZE + 4 + 4;  // Size prefix + address + type tag + argument
+const int OSC_BUNDLE_MAX_SIZE = OSC_BUNDLE_HEADER_SIZE + (OSC_ANALOG_COUNT + OSC_BUTTON_COUNT) * OSC_MESSAGE_MAX_SIZE;
+const int OSC_ANALOG_RAW_THRESHOLD = 4;                         // Minimum raw 12-bit change to send (hides ADC jitter)
+
+// Preformatted OSC address (null-terminated and zero-padded to a multiple of 4)
+struct OscAddress {
+    char text[OSC_ADDRESS_SIZE];
+    int padded_length;
+};
+
+// Parse "host:port" or "host" (port stays unchanged), false if the text is invalid
+bool parseOscTarget(const char* text, char* host, int host_size, int& port);
+
+// =============================================================================
+// OSC SENDER CLASS
+// =============================================================================
+
+class OscSender {
+private:
+    int socket_fd = -1;                                 // Connected UDP socket, -1 if closed
+
+    // Address table, built once in initialize()
+    OscAddress analog_addresses[OSC_ANALOG_COUNT];
+    OscAddress button_addresses[OSC_BUTTON_COUNT];
+
+    // Last sent state for change-only output
+    uint16_t last_analog_values[OSC_ANALOG_COUNT] = {};
+    uint32_t last_button_mask = 0;
+    bool has_last_state = false;                        // First report sends everything
+
+    // Bundle under construction (fixed buffer, no heap use per message)
+    unsigned char bundle_buffer[OSC_BUNDLE_MAX_SIZE];
+    int bundle_length = 0;
+    int bundle_message_count = 0;
+
+    // Readers for raw 12-bit analog values
+    KnobInputReader knob_reader;
+    FaderInputReader fader_reader;
+
+    // Address table helpers
+    void buildAddressTable(int device_number);
+    static void setAddress(OscAddress& address, const char* text);
+
+    // Bundle helpers
+    void beginBundle();
+    void appendMessage(const OscAddress& address, char type_tag, uint32_t argument_bits);
+    void appendFloat(const OscAddress& address, float value);
+    void appendInt(const OscAddress& address, int32_t value);
+    bool sendBundle();
+
+public:
+    // Open UDP socket to host:port, addresses start with /f<device_number>
+    bool initialize(const char* host, int port, int device_number = 1);
+    void close();
+    bool isOpen() const;
+
+    // Send every knob/fader/button that changed in this report as one bundle
+    // @return: false only if sending failed
+    bool sendInputChanges(const unsigned char* input_report);
+
+    // Send the full state with the next report (e.g. after the receiver restarted)
+    void resendAll();
+};
+
+#endif // OSC_SENDER_H
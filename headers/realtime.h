@@ -0,0 +1,44 @@
+#ifndef REALTIME_H
+#define REALTIME_H
+
+// =============================================================================
+// CONSTANTS - Real-time mode
+// =============================================================================
+
+const int RT_DEFAULT_PRIORITY = 80;             // SCHED_FIFO priority of the device threads (1-99)
+const int RT_MAX_CPUS = 8;                      // CPUs in --rt-cpus
+const int RT_STACK_PREFAULT_SIZE = 256 * 1024;  // Stack touched once per thread, so the loop never page-faults on it
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+/*
+* Opt-in real-time mode (--rt)
+* Device thread i is pinned to cpus[i % cpu_count]; without CPUs the threads are not pinned.
+*/
+struct RealtimeConfig {
+    bool enabled = false;
+    int priority = RT_DEFAULT_PRIORITY;
+    int cpus[RT_MAX_CPUS];
+    int cpu_count = 0;
+};
+
+// Parse a CPU list like "2,3"
+// @return: false if the list is empty or invalid
+bool parseCpuList(const char* text, RealtimeConfig& config);
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+
+// Lock all current and future memory of the process (call once all buffers are allocated)
+// @return: true if mlockall succeeded
+bool lockProcessMemory();
+
+// Pin, raise to SCHED_FIFO and prefault the stack of the calling thread, print what was applied
+// Each step falls back on its own (no privileges = normal scheduling, the controller keeps working)
+// @return: true if SCHED_FIFO was applied
+bool applyRealtimeToThread(const RealtimeConfig& config, int thread_index, const char* thread_name);
+
+#endif // REALTIME_H
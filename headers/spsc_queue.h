@@ -0,0 +1,61 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>           // For std::atomic (head/tail indices)
+#include <cstddef>          // For size_t
+
+// =============================================================================
+// SPSC QUEUE - Lock-free single-producer single-consumer ring buffer
+// =============================================================================
+
+/*
+* Fixed-size queue for handing items from one thread to another without locks
+*
+* - Exactly one thread calls push(), exactly one other thread calls pop()
+* - Neither side ever blocks or allocates: push() fails when full, pop() when empty
+* - Capacity must be a power of two; all slots are usable
+*
+* Used to hand control commands from the control socket thread to the main loop.
+*/
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+    T slots[Capacity];
+
+    // Indices count up forever, slot = index % Capacity
+    // Separate cache lines, so producer and consumer do not slow each other down
+    alignas(64) std::atomic<size_t> head{0};    // Next slot to pop (written by consumer)
+    alignas(64) std::atomic<size_t> tail{0};    // Next slot to push (written by producer)
+
+public:
+    // Producer side - false if the queue is full
+    bool push(const T& item) {
+        size_t current_tail = tail.load(std::memory_order_relaxed);
+        if (current_tail - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[current_tail & (Capacity - 1)] = item;
+        tail.store(current_tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side - false if the queue is empty
+    bool pop(T& item) {
+        size_t current_head = head.load(std::memory_order_relaxed);
+        if (current_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = slots[current_head & (Capacity - 1)];
+        head.store(current_head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate (exact only when called from one of the two sides while the other is idle)
+    size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+};
+
+#endif // SPSC_QUEUE_H
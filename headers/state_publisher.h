@@ -0,0 +1,93 @@
+#ifndef STATE_PUBLISHER_H
+#define STATE_PUBLISHER_H
+
+#include <cstdint>          // For fixed-size integer types
+#include <atomic>           // For std::atomic (seqlock sequence counter)
+
+// =============================================================================
+// CONSTANTS - Shared memory state configuration
+// =============================================================================
+
+const char STATE_SHM_DEFAULT_NAME[] = "/visual_sync_f1_state";
+const uint32_t STATE_SHM_MAGIC = 0x46315354;    // "F1ST"
+const uint32_t STATE_SHM_VERSION = 1;           // Bump when ControllerState changes
+const int STATE_ANALOG_COUNT = 8;               // Knobs 1-4, then faders 1-4
+const int STATE_READ_MAX_RETRIES = 64;          // readState() gives up after this many torn reads
+
+// =============================================================================
+// SHARED LAYOUT - Fixed layout, readable from any language
+// =============================================================================
+
+/*
+* One snapshot of the controller, written once per processed input report
+* Only fixed-size fields, no pointers: the same bytes are valid in every process
+*/
+struct ControllerState {
+    uint64_t timestamp_ms;                      // Tick clock time of the report (steady clock)
+    uint64_t report_count;                      // Number of processed input reports
+    uint32_t button_mask;                       // Pressed buttons (toggle bit layout)
+    uint32_t toggled_mask;                      // Toggled buttons (toggle bit layout)
+    uint16_t analog_raw[STATE_ANALOG_COUNT];    // Raw 12-bit knob/fader values
+    int32_t wheel_position;                     // Raw selector wheel counter (0-255)
+    int32_t current_page;                       // Effects page shown on the display
+};
+
+/*
+* Shared memory segment: header + seqlock + snapshot
+*
+* Seqlock protocol (single writer, any number of readers):
+*   Writer: sequence = odd, write state, sequence = next even
+*   Reader: read sequence (retry if odd), copy state, read sequence again,
+*           retry if it changed
+* The writer never waits for readers; readers never write to the segment.
+*/
+struct SharedStateSegment {
+    uint32_t magic;                         // STATE_SHM_MAGIC once initialized
+    uint32_t version;                       // STATE_SHM_VERSION
+    std::atomic<uint32_t> sequence;         // Even = stable, odd = write in progress
+    uint32_t reserved;                      // Keeps state 8-byte aligned
+    ControllerState state;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Seqlock counter must be lock-free to work across processes");
+
+// =============================================================================
+// STATE PUBLISHER CLASS - Writer side
+// =============================================================================
+
+class StatePublisher {
+private:
+    SharedStateSegment* segment = nullptr;
+    bool owns_shm_name = false;             // Unlink the shm name on close
+    char shm_name[64] = {};
+
+public:
+    // Create (or reuse) a POSIX shared memory segment, readable by other processes
+    bool open(const char* name = STATE_SHM_DEFAULT_NAME);
+
+    // Use a private in-process segment (no shm name, for testing and single-process use)
+    bool openInProcess();
+
+    void close();
+    bool isOpen() const;
+
+    // Publish one snapshot (never blocks)
+    void publish(const ControllerState& state);
+
+    // Direct access for in-process readers
+    const SharedStateSegment* getSegment() const;
+};
+
+// =============================================================================
+// STATE READER - Reader side (other processes or threads)
+// =============================================================================
+
+// Map an existing segment read-only (nullptr if missing or wrong version)
+const SharedStateSegment* openStateSegment(const char* name = STATE_SHM_DEFAULT_NAME);
+void closeStateSegment(const SharedStateSegment* segment);
+
+// Copy a consistent snapshot, retrying torn reads up to STATE_READ_MAX_RETRIES times
+// @return: false if no consistent copy was possible (writer extremely busy) or segment invalid
+bool readState(const SharedStateSegment* segment, ControllerState& out, uint32_t* sequence_out = nullptr);
+
+#endif // STATE_PUBLISHER_H
@@ -0,0 +1,21 @@
+#ifndef TICK_CLOCK_H
+#define TICK_CLOCK_H
+
+#include <cstdint>      // For uint64_t
+
+// =============================================================================
+// CONSTANTS - Main loop tick
+// =============================================================================
+
+// The main loop wakes up at least this often, even without input reports,
+// so timed behaviors (flashes, display animations) keep running
+const int MAIN_LOOP_TICK_MS = 10;
+
+// =============================================================================
+// FUNCTION DECLARATIONS
+// =============================================================================
+
+// Monotonic time in milliseconds (only differences are meaningful)
+uint64_t getTickTimeMs();
+
+#endif // TICK_CLOCK_H
@@ -0,0 +1,123 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <cstdint>          // For fixed-size integer types
+#include <atomic>           // For std::atomic (ring write index)
+#include <chrono>           // For std::chrono::steady_clock
+
+// =============================================================================
+// CONSTANTS - Trace recording (--trace)
+// =============================================================================
+
+const int TRACE_DEFAULT_EVENTS_PER_THREAD = 1 << 16;    // 64k events * 24 bytes = 1.5 MB per thread
+const int TRACE_MAX_THREADS = 16;
+const int TRACE_WRITER_POLL_MS = 50;                    // How often the writer thread checks for requests
+
+/*
+* Chrome trace-event export (chrome://tracing, ui.perfetto.dev)
+*
+* Device threads record spans (hid_read wait, decode, toggle handling, scene
+* load, LED write) and instant events (button edges, page changes) into their
+* own ring buffer. Recording is lock-free: one relaxed load of the write index,
+* one event store, one release store. The rings have a fixed size and overwrite
+* their oldest events, so memory stays bounded for multi-hour sessions.
+*
+* The trace file is written by a separate writer thread on kill -USR2 (snapshot,
+* recording continues) and by stopTraceRecorder(), which main calls when Ctrl+C /
+* SIGTERM has stopped the device loops.
+* Threads that never called registerTraceThread() record nothing.
+*/
+
+// Event names (index into the name table of trace_recorder.cpp)
+enum class TraceName : uint8_t {
+    HID_READ,               // Span: waiting for an input report
+    DECODE,                 // Span: wheel, knobs, faders, overlays
+    TOGGLE_HANDLING,        // Span: ButtonToggleSystem::processInputReport
+    SCENE_LOAD,             // Span: effects page scene, zones and behaviors (value = page)
+    LED_WRITE,              // Span: hid_write of one LED report
+    BUTTON_PRESS,           // Instant: value = toggle bit
+    BUTTON_RELEASE,         // Instant: value = toggle bit
+    PAGE_CHANGE,            // Instant: value = page
+    COUNT
+};
+
+enum class TracePhase : uint8_t {
+    SPAN,                   // "ph":"X"
+    INSTANT                 // "ph":"i"
+};
+
+struct TraceEvent {
+    uint64_t timestamp_ns;  // Span start or instant time (steady clock)
+    uint32_t duration_ns;   // Spans only
+    int32_t value;          // Page, toggle bit, ... (-1 = none)
+    TraceName name;
+    TracePhase phase;
+};
+
+// =============================================================================
+// TRACE RING - One per thread, single writer
+// =============================================================================
+
+struct TraceRing {
+    int thread_index = 0;
+    char thread_name[32] = {};
+    uint32_t capacity = 0;                      // Power of two
+    TraceEvent* events = nullptr;
+    std::atomic<uint64_t> write_index{0};       // Events ever written (slot = index & (capacity - 1))
+};
+
+extern constinit thread_local TraceRing* trace_ring;
+
+inline uint64_t getTraceClockNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline void pushTraceEvent(const TraceEvent& event) {
+    TraceRing* ring = trace_ring;
+    uint64_t index = ring->write_index.load(std::memory_order_relaxed);
+    ring->events[index & (ring->capacity - 1)] = event;
+    ring->write_index.store(index + 1, std::memory_order_release);
+}
+
+// Start of a span (0 if this thread does not record)
+inline uint64_t traceBegin() {
+    return trace_ring != nullptr ? getTraceClockNs() : 0;
+}
+
+// End of a span started with traceBegin()
+inline void traceEnd(TraceName name, uint64_t start_ns, int32_t value = -1) {
+    if (trace_ring == nullptr || start_ns == 0) {
+        return;
+    }
+    uint64_t duration_ns = getTraceClockNs() - start_ns;
+    pushTraceEvent({ start_ns, duration_ns > UINT32_MAX ? UINT32_MAX : (uint32_t)duration_ns, value, name, TracePhase::SPAN });
+}
+
+inline void traceInstant(TraceName name, int32_t value = -1) {
+    if (trace_ring == nullptr) {
+        return;
+    }
+    pushTraceEvent({ getTraceClockNs(), 0, value, name, TracePhase::INSTANT });
+}
+
+// =============================================================================
+// FUNCTION DECLARATIONS - Setup and export
+// =============================================================================
+
+// Enable tracing: rings get events_per_thread slots (rounded up to a power of two),
+// the writer thread starts and SIGUSR2 writes a snapshot
+// @return: false if tracing was already started or the path is empty
+bool startTraceRecorder(const char* path, int events_per_thread);
+
+// Give the calling thread a ring (no-op while tracing is off)
+void registerTraceThread(const char* thread_name);
+
+// Write the trace file now (any thread, recording continues)
+// @return: false if the file could not be written
+bool writeTraceFile();
+
+// Write the file a last time and stop the writer thread
+void stopTraceRecorder();
+
+#endif // TRACE_RECORDER_H
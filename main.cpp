@@ -11,10 +11,14 @@
 #include <hidapi/hidapi.h>  // HIDAPI library for USB HID device access
 #include <fcntl.h>          // fcntl.h gives access to the POSIX file control API.
 #include <cstring>          // string.h gives access to C-style string functions.
+#include <cstdlib>          // cstdlib gives atoi() and strtol() for command line options.
+#include <cerrno>           // For errno (strtol range errors)
 #include <chrono>
 #include <thread>
+#include <functional>         // For std::ref (device threads)
 #include <iomanip>
 #include <cmath>
+#include <csignal>            // For SIGINT/SIGTERM (shutdown), SIGUSR1 (latency dump)
 
 #include "headers/startup_sequence.h"					// Include startup effects module
 #include "headers/input_reader.h"							// Include input read module
@@ -25,14 +29,202 @@
 #include "headers/led_scene_controller.h"     // Include LED scene controller module
 #include "headers/input_reader_knob.h"        // Include knob input read module
 #include "headers/input_reader_fader.h"       // Include fader input read module
+#include "headers/tick_clock.h"               // Include main loop tick clock
+#include "headers/osc_sender.h"               // Include OSC output module
+#include "headers/midi_output.h"              // Include MIDI output module
+#include "headers/osc_listener.h"             // Include OSC feedback input module
+#include "headers/state_publisher.h"          // Include shared memory state module
+#include "headers/led_frame_receiver.h"       // Include shared memory LED frame module
+#include "headers/control_server.h"           // Include Unix socket control module
+#include "headers/dmx_output.h"               // Include Art-Net/sACN DMX output module
+#include "headers/device_context.h"           // Include per-device context module
+#include "headers/realtime.h"                 // Include real-time scheduling module
+#include "headers/latency_tracer.h"           // Include latency tracing module (-DTRAKTOR_LATENCY_TRACING)
+#include "headers/trace_recorder.h"           // Include Chrome trace export module
+#include "headers/metrics_server.h"           // Include Prometheus metrics endpoint module
+#include "headers/device_loop.h"              // Include per-device loop module
+#include "headers/control_layout.h"           // Include controller descriptor (F1_DESCRIPTOR)
+
+
+// F1 device identifiers (from the controller descriptor)
+const unsigned short VENDOR_ID = F1_DESCRIPTOR.vendor_id;
+const unsigned short PRODUCT_ID = F1_DESCRIPTOR.product_id;
+
+// Contexts whose device loops Ctrl+C / SIGTERM stops (set before the handlers are installed)
+static DeviceContext* shutdown_contexts[MAX_F1_DEVICES];
+static int shutdown_context_count = 0;
+
+// Ctrl+C / SIGTERM: every device loop ends after its current tick, then main cleans up.
+// A second Ctrl+C kills the process if the shutdown hangs.
+static void requestShutdown(int signal_number) {
+	for (int i = 0; i < shutdown_context_count; i++) {
+		shutdown_contexts[i]->stop_requested.store(true);
+	}
+	signal(signal_number, SIG_DFL);
+}
+
+// Parse a whole command line number (no trailing text) within [min_value, max_value]
+static bool parseIntOption(const char* text, int min_value, int max_value, int& value) {
+	char* end = nullptr;
+	errno = 0;
+	long parsed = strtol(text, &end, 10);
+	if (end == text || *end != '\0' || errno != 0 || parsed < min_value || parsed > max_value) {
+		return false;
+	}
+	value = (int)parsed;
+	return true;
+}
+
+
+int main(int argc, char* argv[]) {
 
-
-// F1 device identifiers (same as before)
-const unsigned short VENDOR_ID = 0x17cc;
-const unsigned short PRODUCT_ID = 0x1120;
-
-
-int main() {
+		// =============================================================================
+		// COMMAND LINE OPTIONS
+		// =============================================================================
+		// --osc <host[:port]>   Send OSC to this target (default 127.0.0.1:9000)
+		// --no-osc              Disable OSC output
+		// --midi                Open a virtual ALSA sequencer MIDI port
+		// --midi-file <path>    Write MIDI messages as text lines to a file or pipe ("-" = stdout)
+		// --osc-in <port>       Receive LED/display feedback via OSC on this UDP port (default 9001)
+		// --no-osc-in           Disable OSC feedback input
+		// --shm <name>          Publish controller state in this POSIX shared memory segment
+		// --no-shm              Disable shared memory state
+		// --led-shm <name>      Accept LED frames from external renderers in this shared memory segment
+		// --no-led-shm          Disable shared memory LED frames
+		// --control <path>      Accept batched control commands on this Unix socket (default /tmp/visual_sync_f1.sock)
+		// --no-control          Disable the control socket
+		// --artnet <host[:port]> Send DMX as Art-Net to this host or broadcast address (default port 6454)
+		// --sacn <host[:port]>  Send DMX as sACN to this host, or "multicast" (default port 5568)
+		// --dmx-universe <n>    First DMX universe (default 0 for Art-Net, 1 for sACN)
+		// --dmx-rate <hz>       DMX refresh rate for changed universes (default 40)
+		// --serial <serial>     Only use the F1 with this serial number (repeat for several, default all F1s)
+		// --rt                  Real-time mode: SCHED_FIFO device threads, locked memory, prefaulted stacks
+		// --rt-priority <n>     SCHED_FIFO priority of the device threads (1-99, default 80)
+		// --rt-cpus <list>      Pin device thread i to the i-th CPU of the list, e.g. 2,3
+		// --trace <file>        Record a Chrome trace (written on kill -USR2 and Ctrl+C)
+		// --trace-events <n>    Trace ring size per thread (default 65536 events)
+		// --metrics-port <port> Serve USB I/O metrics for Prometheus on http://127.0.0.1:<port>/metrics
+		char osc_host[256];
+		int osc_port = OSC_DEFAULT_PORT;
+		bool osc_enabled = true;
+		snprintf(osc_host, sizeof(osc_host), "%s", OSC_DEFAULT_HOST);
+		bool midi_alsa_enabled = false;
+		const char* midi_file_path = nullptr;
+		int osc_in_port = OSC_LISTEN_DEFAULT_PORT;
+		bool osc_in_enabled = true;
+		const char* shm_name = STATE_SHM_DEFAULT_NAME;
+		bool shm_enabled = true;
+		const char* led_shm_name = LED_FRAME_SHM_DEFAULT_NAME;
+		bool led_shm_enabled = true;
+		const char* control_path = CONTROL_SOCKET_DEFAULT_PATH;
+		bool control_enabled = true;
+		char dmx_host[256] = "";
+		int dmx_port = 0;
+		DmxProtocol dmx_protocol = DmxProtocol::ARTNET;
+		int dmx_universe = -1;
+		int dmx_rate = DMX_DEFAULT_REFRESH_HZ;
+		const char* selected_serials[MAX_F1_DEVICES];
+		int selected_serial_count = 0;
+		RealtimeConfig realtime;
+		const char* trace_path = nullptr;
+		int trace_events = TRACE_DEFAULT_EVENTS_PER_THREAD;
+		int metrics_port = 0;
+
+		for (int i = 1; i < argc; i++) {
+				if (strcmp(argv[i], "--osc") == 0 && i + 1 < argc) {
+						if (!parseOscTarget(argv[++i], osc_host, sizeof(osc_host), osc_port)) {
+								return 1;
+						}
+				} else if (strcmp(argv[i], "--no-osc") == 0) {
+						osc_enabled = false;
+				} else if (strcmp(argv[i], "--midi") == 0) {
+						midi_alsa_enabled = true;
+				} else if (strcmp(argv[i], "--midi-file") == 0 && i + 1 < argc) {
+						midi_file_path = argv[++i];
+				} else if (strcmp(argv[i], "--osc-in") == 0 && i + 1 < argc) {
+						osc_in_port = atoi(argv[++i]);
+						if (osc_in_port < 1 || osc_in_port > 65535) {
+								std::cout << "Invalid OSC input port: " << argv[i] << std::endl;
+								return 1;
+						}
+				} else if (strcmp(argv[i], "--no-osc-in") == 0) {
+						osc_in_enabled = false;
+				} else if (strcmp(argv[i], "--shm") == 0 && i + 1 < argc) {
+						shm_name = argv[++i];
+				} else if (strcmp(argv[i], "--no-shm") == 0) {
+						shm_enabled = false;
+				} else if (strcmp(argv[i], "--led-shm") == 0 && i + 1 < argc) {
+						led_shm_name = argv[++i];
+				} else if (strcmp(argv[i], "--no-led-shm") == 0) {
+						led_shm_enabled = false;
+				} else if (strcmp(argv[i], "--control") == 0 && i + 1 < argc) {
+						control_path = argv[++i];
+				} else if (strcmp(argv[i], "--no-control") == 0) {
+						control_enabled = false;
+				} else if ((strcmp(argv[i], "--artnet") == 0 || strcmp(argv[i], "--sacn") == 0) && i + 1 < argc) {
+						dmx_protocol = strcmp(argv[i], "--artnet") == 0 ? DmxProtocol::ARTNET : DmxProtocol::SACN;
+						dmx_port = dmx_protocol == DmxProtocol::ARTNET ? ARTNET_DEFAULT_PORT : SACN_DEFAULT_PORT;
+						if (!parseOscTarget(argv[++i], dmx_host, sizeof(dmx_host), dmx_port)) {
+								return 1;
+						}
+				} else if (strcmp(argv[i], "--dmx-universe") == 0 && i + 1 < argc) {
+						// Protocol range (Art-Net 0-32767, sACN 1-63999) is checked when the output opens
+						if (!parseIntOption(argv[++i], 0, 65535, dmx_universe)) {
+								std::cout << "Invalid DMX universe: " << argv[i] << std::endl;
+								return 1;
+						}
+				} else if (strcmp(argv[i], "--dmx-rate") == 0 && i + 1 < argc) {
+						if (!parseIntOption(argv[++i], 1, 44, dmx_rate)) {
+								std::cout << "Invalid DMX rate (1-44 Hz): " << argv[i] << std::endl;
+								return 1;
+						}
+				} else if (strcmp(argv[i], "--serial") == 0 && i + 1 < argc && selected_serial_count < MAX_F1_DEVICES) {
+						// The same F1 twice would be opened by two device threads
+						const char* serial = argv[++i];
+						for (int s = 0; s < selected_serial_count; s++) {
+								if (strcmp(selected_serials[s], serial) == 0) {
+										std::cout << "Duplicate serial: " << serial << std::endl;
+										return 1;
+								}
+						}
+						selected_serials[selected_serial_count++] = serial;
+				} else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+						trace_path = argv[++i];
+				} else if (strcmp(argv[i], "--trace-events") == 0 && i + 1 < argc) {
+						trace_events = atoi(argv[++i]);
+						if (trace_events < 1) {
+								std::cout << "Invalid trace ring size: " << argv[i] << std::endl;
+								return 1;
+						}
+				} else if (strcmp(argv[i], "--metrics-port") == 0 && i + 1 < argc) {
+						metrics_port = atoi(argv[++i]);
+						if (metrics_port <= 0 || metrics_port > 65535) {
+								std::cout << "Invalid metrics port: " << argv[i] << std::endl;
+								return 1;
+						}
+				} else if (strcmp(argv[i], "--rt") == 0) {
+						realtime.enabled = true;
+				} else if (strcmp(argv[i], "--rt-priority") == 0 && i + 1 < argc) {
+						realtime.priority = atoi(argv[++i]);
+						if (realtime.priority < 1 || realtime.priority > 99) {
+								std::cout << "Invalid real-time priority: " << argv[i] << std::endl;
+								return 1;
+						}
+				} else if (strcmp(argv[i], "--rt-cpus") == 0 && i + 1 < argc) {
+						if (!parseCpuList(argv[++i], realtime)) {
+								std::cout << "Invalid CPU list: " << argv[i] << std::endl;
+								return 1;
+						}
+				} else {
+						std::cout << "Usage: " << argv[0] << " [--osc host[:port]] [--no-osc] [--midi] [--midi-file path]"
+						          << " [--osc-in port] [--no-osc-in] [--shm name] [--no-shm]"
+						          << " [--led-shm name] [--no-led-shm] [--control path] [--no-control]"
+						          << " [--artnet host[:port] | --sacn host[:port]|multicast] [--dmx-universe n] [--dmx-rate hz]"
+						          << " [--serial serial]... [--rt] [--rt-priority n] [--rt-cpus list]"
+						          << " [--trace file] [--trace-events n] [--metrics-port port]" << std::endl;
+						return 1;
+				}
+		}
 
 		// =============================================================================
 		// START UP SEQUENCE
@@ -52,54 +244,49 @@ int main() {
 				std::cout << "- HID_API initialized successfully!" << std::endl;
 		}
 
-		// Open the device:
-		// Declare pointer to HID device handle
-		hid_device *device;
-		// Declare button toggle system
-		ButtonToggleSystem btn_toggle_system;
-		// Declare wheel reader system
-		WheelInputReader wheel_input_reader;
-		// Declare knob input reader
-		KnobInputReader knob_input_reader;
-		// Declare fader input reader
-		FaderInputReader fader_input_reader;
-		// Declare current effects page variable
-		int current_effect_page = 1;
-		// Delare display controller
-		DisplayController display_controller;
-		// Declare LED scene controller
-		SceneController scene_controller;
-
-		// Open the device using the VendorID, ProductID, and optionally the Serial number.
-		// If the device is opened successfully, the pointer will not be null.
-		device = hid_open(VENDOR_ID, PRODUCT_ID, NULL);
-		if (device) {
-				std::cout << "- Opening Traktor Kontrol F1..." << std::endl;
-
-				// Initialize the LED controller
-				initializeLEDController(device);
-
-				// Run startup sequence
-				startupSequence(device);
-
-				// Initialize button toggle system
-				btn_toggle_system.initialize();
-
-				// Initialize wheel input reader and set first page
-				wheel_input_reader.initialize();
-
-				// Set first effects page on display
-				// Turn on left dot to indicate page is loaded
-				display_controller.setDisplayNumber(current_effect_page);
-				display_controller.setDisplayDot(1, true);
-
-				// Load first effects page scene
-				scene_controller.setEffectsPageScene(current_effect_page);
-
-				// Send success message
-				std::cout << "" << std::endl;
-				std::cout << "- Traktor Kontrol F1 opened successfully!" << std::endl;
-		} else {
+		// Find all connected F1s (sorted by serial number, so the numbering is stable)
+		F1DeviceInfo found_devices[MAX_F1_DEVICES];
+		int found_count = enumerateF1Devices(VENDOR_ID, PRODUCT_ID, found_devices, MAX_F1_DEVICES);
+
+		// Keep the selected ones (--serial, in the given order) or all of them
+		F1DeviceInfo device_infos[MAX_F1_DEVICES];
+		int device_count = 0;
+		if (selected_serial_count == 0) {
+				for (int i = 0; i < found_count; i++) {
+						device_infos[device_count++] = found_devices[i];
+				}
+		}
+		for (int s = 0; s < selected_serial_count; s++) {
+				for (int i = 0; i < found_count; i++) {
+						if (strcmp(found_devices[i].serial, selected_serials[s]) == 0) {
+								device_infos[device_count++] = found_devices[i];
+								break;
+						}
+				}
+				if (device_count == 0 || strcmp(device_infos[device_count - 1].serial, selected_serials[s]) != 0) {
+						std::cout << "- F1 with serial " << selected_serials[s] << " not found" << std::endl;
+				}
+		}
+
+		// Open the devices, one context each (contexts are large, so they live on the heap)
+		DeviceContext* contexts[MAX_F1_DEVICES];
+		int context_count = 0;
+		for (int i = 0; i < device_count; i++) {
+				hid_device* device = hid_open_path(device_infos[i].path);
+				if (device == nullptr) {
+						std::cout << "- Unable to open F1 " << device_infos[i].serial << std::endl;
+						continue;
+				}
+				DeviceContext* context = new DeviceContext();
+				context->number = context_count + 1;
+				context->info = device_infos[i];
+				context->device = device;
+				context->print_analog_values = context->number == 1 && !realtime.enabled;	// Debug line for the first F1 only (no terminal I/O on a SCHED_FIFO thread)
+				contexts[context_count++] = context;
+				std::cout << "- Opening Traktor Kontrol F1 #" << context->number << "..." << std::endl;
+		}
+
+		if (context_count == 0) {
 				// Send error message and close program
 				std::cout << "- Unable to open device..." << std::endl;
 				std::cout << "Shutting down..." << std::endl;
@@ -107,6 +294,62 @@ int main() {
 						return 0;
 		}
 
+		// Open OSC output on every F1 (/f1/..., /f2/..., controller keeps working without it)
+		if (osc_enabled) {
+				for (int i = 0; i < context_count; i++) {
+						contexts[i]->osc_sender.initialize(osc_host, osc_port, contexts[i]->number);
+				}
+		}
+
+		// Process-wide integrations are served by the first F1
+		DeviceContext& primary = *contexts[0];
+
+		// Open OSC feedback input (LEDs/display driven by the visual software)
+		if (osc_in_enabled) {
+				primary.osc_listener.initialize(osc_in_port);
+		}
+
+		// Publish controller state for other local processes
+		// (control socket state queries use a private snapshot when shared memory is off)
+		if (shm_enabled) {
+				primary.state_publisher.open(shm_name);
+		} else if (control_enabled) {
+				primary.state_publisher.openInProcess();
+		}
+
+		// Accept LED frames from external renderers
+		if (led_shm_enabled) {
+				primary.led_frame_receiver.open(led_shm_name);
+		}
+
+		// Publish first snapshot (state queries work before the first input report)
+		primary.published_state.current_page = primary.current_effect_page;
+		primary.state_publisher.publish(primary.published_state);
+
+		// Accept batched commands from local tools (socket handled on its own thread)
+		if (control_enabled) {
+				primary.control_server.start(control_path, primary.state_publisher.getSegment());
+		}
+
+		// Open DMX output for lighting (only when --artnet or --sacn is given)
+		if (dmx_host[0] != '\0') {
+				if (dmx_universe < 0) {
+						dmx_universe = dmx_protocol == DmxProtocol::SACN ? 1 : 0;
+				}
+				primary.dmx_output.initialize(dmx_protocol, dmx_host, dmx_port, dmx_universe, dmx_rate);
+		}
+
+		// Open MIDI output (text sink wins if both are given)
+		if (midi_file_path != nullptr) {
+				primary.midi_output.openTextSink(midi_file_path);
+		} else if (midi_alsa_enabled) {
+				primary.midi_output.openAlsaPort();
+		}
+
+		// Send success message
+		std::cout << "" << std::endl;
+		std::cout << "- " << context_count << " Traktor Kontrol F1 opened successfully!" << std::endl;
+
 		// Send startup message how to terminate while(true) loop
 		std::cout << "" << std::endl;
 		std::cout << "+++ Press Ctrl+C to exit. +++" << std::endl;
@@ -114,128 +357,64 @@ int main() {
 
 
 		// =============================================================================
-		// STUFFs HAPPENIN HERE
+		// SERVICE EVERY F1 ON ITS OWN THREAD
 		// =============================================================================
 
-		btn_toggle_system.setMatrixToggleMode(MatrixToggleZone::LEFT_RIGHT_SPLIT);
-
-		while (true) {
-
-				// =======================================
-				// Read input report
-				// =======================================
-				unsigned char input_report_buffer[INPUT_REPORT_SIZE];
-				if (!readInputReport(device, input_report_buffer)) {
-						std::cerr << "Error, shutting down..." << std::endl;
-						return -1;
-				}
+		// Serve USB I/O metrics (counted always, device threads bind their slot when they start)
+		MetricsServer metrics_server;
+		if (metrics_port > 0) {
+				metrics_server.start(metrics_port);
+		}
 
-				// =======================================
-				// Read and update Selector Wheel rotation
-				// =======================================
-				// Get wheel direction
-				WheelDirection selector_wheel_direction = wheel_input_reader.checkWheelRotation(input_report_buffer);
-
-				// Select effects page accordingly
-				if (selector_wheel_direction == WheelDirection::CLOCKWISE) {
-						// increase page by 1
-        		current_effect_page = std::min(current_effect_page + 1, 99);
-						// Update display
-						display_controller.setDisplayDot(1, false); // Turn off left dot when changing page
-						display_controller.setDisplayNumber(current_effect_page);
-				}
-				else if (selector_wheel_direction == WheelDirection::COUNTER_CLOCKWISE) {
-						// decrease page by 1
-						current_effect_page = std::max(current_effect_page - 1, 1);
-						// Update display
-						display_controller.setDisplayDot(1, false); // Turn off left dot when changing page
-						display_controller.setDisplayNumber(current_effect_page);
-				}
+		// Record a Chrome trace (device threads register their rings when they start)
+		if (trace_path != nullptr) {
+				startTraceRecorder(trace_path, trace_events);
+		}
 
-				// Load effects page on selector wheel button press
-				if (isSpecialButtonPressed(input_report_buffer, SpecialButton::SELECTOR_WHEEL)) {
-						// Turn on left dot to indicate page is loaded
-						display_controller.setDisplayDot(1, true);
-						// Load effects page scene
-						scene_controller.setEffectsPageScene(current_effect_page);
-						// Reset button states
-						btn_toggle_system.resetAllToggleStates();
-				}
+#ifdef TRAKTOR_LATENCY_TRACING
+		// kill -USR1 <pid> prints the latency histograms (printed by a device thread)
+		signal(SIGUSR1, [](int) { requestLatencyDump(); });
+		std::cout << "- Latency tracing on, kill -USR1 " << getpid() << " prints the histograms" << std::endl;
+#endif
 
-				// =======================================
-				// Read and update Knob values
-				// =======================================
-				//knob_input_reader.printKnobValues(input_report_buffer);
-				float knob_value_1 = knob_input_reader.getKnobValue(input_report_buffer, 1);
-				float knob_value_2 = knob_input_reader.getKnobValue(input_report_buffer, 2);
-				float knob_value_3 = knob_input_reader.getKnobValue(input_report_buffer, 3);
-				float knob_value_4 = knob_input_reader.getKnobValue(input_report_buffer, 4);
-
-				// =======================================
-				// Read and update Fader values
-				// =======================================
-				//fader_input_reader.printFaderValues(input_report_buffer);
-				float fader_value_1 = fader_input_reader.getFaderValue(input_report_buffer, 1);
-				float fader_value_2 = fader_input_reader.getFaderValue(input_report_buffer, 2);
-				float fader_value_3 = fader_input_reader.getFaderValue(input_report_buffer, 3);
-				float fader_value_4 = fader_input_reader.getFaderValue(input_report_buffer, 4);
-
-				// Print knob and fader values for debugging
-				std::cout << "Knob Values: "
-								<< "1: " << std::fixed << std::setprecision(3) << knob_value_1 << " | "
-								<< "2: " << std::fixed << std::setprecision(3) << knob_value_2 << " | "
-								<< "3: " << std::fixed << std::setprecision(3) << knob_value_3 << " | "
-								<< "4: " << std::fixed << std::setprecision(3) << knob_value_4 << " || "
-								<< "Fader Values: "
-								<< "1: " << std::fixed << std::setprecision(3) << fader_value_1 << " | "
-								<< "2: " << std::fixed << std::setprecision(3) << fader_value_2 << " | "
-								<< "3: " << std::fixed << std::setprecision(3) << fader_value_3 << " | "
-								<< "4: " << std::fixed << std::setprecision(3) << fader_value_4 << " || "
-								<< "        \r"; // Carriage return to overwrite the line
-				std::cout.flush();
-
-				// =======================================
-				// Check for button toggles
-				// =======================================
-
-				// Special button toggles (only triggers on press, not hold)
-				btn_toggle_system.shouldToggleSpecialButton(input_report_buffer, SpecialButton::SHIFT, SpecialLEDButton::SHIFT);
-				btn_toggle_system.shouldToggleSpecialButton(input_report_buffer, SpecialButton::REVERSE, SpecialLEDButton::REVERSE);
-				btn_toggle_system.shouldToggleSpecialButton(input_report_buffer, SpecialButton::TYPE, SpecialLEDButton::TYPE);
-				btn_toggle_system.shouldToggleSpecialButton(input_report_buffer, SpecialButton::SIZE, SpecialLEDButton::SIZE);
-				btn_toggle_system.shouldToggleSpecialButton(input_report_buffer, SpecialButton::BROWSE, SpecialLEDButton::BROWSE);
-
-				// Control button toggles
-				btn_toggle_system.shouldToggleControlButton(input_report_buffer, ControlButton::CAPTURE, ControlLEDButton::CAPTURE);
-				btn_toggle_system.shouldToggleControlButton(input_report_buffer, ControlButton::QUANT, ControlLEDButton::QUANT);
-				btn_toggle_system.shouldToggleControlButton(input_report_buffer, ControlButton::SYNC, ControlLEDButton::SYNC);
-
-				// Stop button toggles
-				btn_toggle_system.shouldToggleStopButton(input_report_buffer, StopButton::STOP1, StopLEDButton::STOP1);
-				btn_toggle_system.shouldToggleStopButton(input_report_buffer, StopButton::STOP2, StopLEDButton::STOP2);
-				btn_toggle_system.shouldToggleStopButton(input_report_buffer, StopButton::STOP3, StopLEDButton::STOP3);
-				btn_toggle_system.shouldToggleStopButton(input_report_buffer, StopButton::STOP4, StopLEDButton::STOP4);
-
-				// Matrix button toggles
-				for (int row = 1; row <= 4; row++) {
-					for (int col = 1; col <= 4; col++) {
-						btn_toggle_system.shouldToggleMatrixButton(input_report_buffer, row, col);
-					}
-				}
+		// Real-time mode: lock memory now that contexts, packets and segments are allocated
+		if (realtime.enabled) {
+				lockProcessMemory();
+		}
 
-				// Update button states for next frame
-				btn_toggle_system.updateButtonStates(input_report_buffer);
+		// Ctrl+C / SIGTERM stop the device loops, the cleanup below runs after the join
+		for (int i = 0; i < context_count; i++) {
+				shutdown_contexts[i] = contexts[i];
+		}
+		shutdown_context_count = context_count;
+		signal(SIGINT, requestShutdown);
+		signal(SIGTERM, requestShutdown);
 
+		std::thread device_threads[MAX_F1_DEVICES];
+		for (int i = 0; i < context_count; i++) {
+				device_threads[i] = std::thread(serviceDevice, std::ref(*contexts[i]), std::cref(realtime));
+		}
+		for (int i = 0; i < context_count; i++) {
+				device_threads[i].join();
 		}
 
 	// =============================================================================
 	// CODE CLOSES
 	//=============================================================================
-	// Close the device
-	hid_close(device);
+	std::cout << "Shutting down..." << std::endl;
+
+	// Write the trace file a last time (--trace), stop the metrics endpoint
+	stopTraceRecorder();
+	metrics_server.stop();
+
+	// Close control socket, OSC/MIDI/DMX output and the devices
+	for (int i = 0; i < context_count; i++) {
+		contexts[i]->close();
+		delete contexts[i];
+	}
 
 	// Finalize the hidapi library
 	res = hid_exit();
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,292 @@
+#include "mock_hid_device.h"            // Include header file
+
+#include <cstdio>                       // For snprintf, sscanf
+#include <cstring>                      // For memcpy, strncmp
+#include <cwchar>                       // For wcsncpy, swprintf
+#include <atomic>                       // For std::atomic (live input read count)
+#include <chrono>                       // For std::chrono (read timeouts)
+#include <mutex>                        // For std::mutex (read wake-up)
+#include <condition_variable>           // For std::condition_variable (read wake-up)
+#include "headers/spsc_queue.h"         // For SpscQueue (live input reports)
+
+// =============================================================================
+// MOCK DEVICE STATE
+// =============================================================================
+
+// One mock F1 (hid_device handles point straight at it)
+struct hid_device_ {
+    int index;
+    bool connected;
+    const unsigned char* reports;
+    int report_count;
+    int report_size;
+    int next_report;
+    bool loop;
+    uint64_t write_count;
+    unsigned char last_write[MOCK_HID_MAX_REPORT_SIZE];
+    int last_write_size;
+};
+
+static hid_device_ mock_devices[MOCK_HID_MAX_DEVICES];
+static int mock_device_count = 1;
+
+// Live input of one mock F1 (allocated by mockHidEnableLiveInput)
+struct MockLiveReport {
+    uint64_t stamp_ns;
+    int size;
+    unsigned char data[MOCK_HID_LIVE_REPORT_SIZE];
+};
+
+struct MockLiveInput {
+    SpscQueue<MockLiveReport, MOCK_HID_LIVE_QUEUE_SIZE> queue;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    std::atomic<uint64_t> read_count{0};
+    uint64_t unwritten_stamp_ns = 0;        // Device thread only
+};
+
+static MockLiveInput* mock_live_inputs[MOCK_HID_MAX_DEVICES];
+static std::atomic<MockHidWriteHook> mock_write_hook{nullptr};
+
+// Enumeration entries handed out by hid_enumerate()
+static hid_device_info mock_infos[MOCK_HID_MAX_DEVICES];
+static char mock_paths[MOCK_HID_MAX_DEVICES][16];
+static wchar_t mock_serials[MOCK_HID_MAX_DEVICES][16];
+
+// =============================================================================
+// CONTROL FUNCTIONS
+// =============================================================================
+
+void mockHidReset() {
+    for (int i = 0; i < MOCK_HID_MAX_DEVICES; i++) {
+        memset(&mock_devices[i], 0, sizeof(mock_devices[i]));
+        mock_devices[i].index = i;
+        mock_devices[i].connected = true;
+    }
+    mock_device_count = 1;
+}
+
+// Devices start connected, before main() runs
+static const bool mock_devices_ready = (mockHidReset(), true);
+
+void mockHidSetDeviceCount(int count) {
+    if (count < 1) {
+        count = 1;
+    }
+    mock_device_count = count < MOCK_HID_MAX_DEVICES ? count : MOCK_HID_MAX_DEVICES;
+}
+
+hid_device* mockHidOpenDevice(int index) {
+    if (index < 0 || index >= mock_device_count || !mock_devices[index].connected) {
+        return nullptr;
+    }
+    mock_devices[index].index = index;
+    return &mock_devices[index];
+}
+
+void mockHidSetInputReports(int index, const unsigned char* reports, int report_count, int report_size, bool loop) {
+    hid_device_& device = mock_devices[index];
+    device.reports = reports;
+    device.report_count = report_count;
+    device.report_size = report_size;
+    device.next_report = 0;
+    device.loop = loop;
+}
+
+void mockHidSetConnected(int index, bool connected) {
+    mock_devices[index].connected = connected;
+}
+
+void mockHidEnableLiveInput(int index) {
+    if (mock_live_inputs[index] == nullptr) {
+        mock_live_inputs[index] = new MockLiveInput();
+    }
+}
+
+bool mockHidPushInputReport(int index, const unsigned char* report, int report_size, uint64_t stamp_ns) {
+    MockLiveInput* live = mock_live_inputs[index];
+    if (live == nullptr || report_size > MOCK_HID_LIVE_REPORT_SIZE) {
+        return false;
+    }
+    MockLiveReport item;
+    item.stamp_ns = stamp_ns;
+    item.size = report_size;
+    memcpy(item.data, report, report_size);
+    if (!live->queue.push(item)) {
+        return false;
+    }
+    // Taking the mutex orders the push before a reader that is about to wait
+    std::lock_guard<std::mutex> lock(live->wake_mutex);
+    live->wake.notify_one();
+    return true;
+}
+
+int mockHidGetPendingInputReports(int index) {
+    MockLiveInput* live = mock_live_inputs[index];
+    return live != nullptr ? (int)live->queue.size() : 0;
+}
+
+uint64_t mockHidGetReadCount(int index) {
+    MockLiveInput* live = mock_live_inputs[index];
+    return live != nullptr ? live->read_count.load(std::memory_order_relaxed) : 0;
+}
+
+void mockHidSetWriteHook(MockHidWriteHook hook) {
+    mock_write_hook.store(hook);
+}
+
+uint64_t mockHidGetWriteCount(int index) {
+    return mock_devices[index].write_count;
+}
+
+int mockHidGetLastWrite(int index, unsigned char* buffer, int buffer_size) {
+    const hid_device_& device = mock_devices[index];
+    int size = device.last_write_size < buffer_size ? device.last_write_size : buffer_size;
+    memcpy(buffer, device.last_write, size);
+    return device.last_write_size;
+}
+
+// =============================================================================
+// HIDAPI FUNCTIONS
+// =============================================================================
+
+extern "C" {
+
+int hid_init(void) {
+    return 0;
+}
+
+int hid_exit(void) {
+    return 0;
+}
+
+struct hid_device_info* hid_enumerate(unsigned short vendor_id, unsigned short product_id) {
+    if ((vendor_id != 0 && vendor_id != MOCK_HID_VENDOR_ID) || (product_id != 0 && product_id != MOCK_HID_PRODUCT_ID)) {
+        return nullptr;
+    }
+    hid_device_info* first = nullptr;
+    hid_device_info* last = nullptr;
+    for (int i = 0; i < mock_device_count; i++) {
+        if (!mock_devices[i].connected) {
+            continue;
+        }
+        snprintf(mock_paths[i], sizeof(mock_paths[i]), "mock:%d", i);
+        swprintf(mock_serials[i], 16, L"MOCK%d", i);
+        hid_device_info& info = mock_infos[i];
+        memset(&info, 0, sizeof(info));
+        info.path = mock_paths[i];
+        info.vendor_id = MOCK_HID_VENDOR_ID;
+        info.product_id = MOCK_HID_PRODUCT_ID;
+        info.serial_number = mock_serials[i];
+        if (last != nullptr) {
+            last->next = &info;
+        } else {
+            first = &info;
+        }
+        last = &info;
+    }
+    return first;
+}
+
+void hid_free_enumeration(struct hid_device_info*) {
+}
+
+hid_device* hid_open(unsigned short vendor_id, unsigned short product_id, const wchar_t*) {
+    if (vendor_id != MOCK_HID_VENDOR_ID || product_id != MOCK_HID_PRODUCT_ID) {
+        return nullptr;
+    }
+    return mockHidOpenDevice(0);
+}
+
+hid_device* hid_open_path(const char* path) {
+    int index = -1;
+    if (path == nullptr || sscanf(path, "mock:%d", &index) != 1) {
+        return nullptr;
+    }
+    return mockHidOpenDevice(index);
+}
+
+int hid_write(hid_device* dev, const unsigned char* data, size_t length) {
+    if (dev == nullptr || !dev->connected) {
+        return -1;
+    }
+    int size = length < (size_t)MOCK_HID_MAX_REPORT_SIZE ? (int)length : MOCK_HID_MAX_REPORT_SIZE;
+    memcpy(dev->last_write, data, size);
+    dev->last_write_size = size;
+    dev->write_count++;
+
+    MockHidWriteHook hook = mock_write_hook.load(std::memory_order_relaxed);
+    MockLiveInput* live = mock_live_inputs[dev->index];
+    if (hook != nullptr) {
+        hook(dev->index, data, size, live != nullptr ? live->unwritten_stamp_ns : 0);
+    }
+    if (live != nullptr) {
+        live->unwritten_stamp_ns = 0;
+    }
+    return (int)length;
+}
+
+/*
+* Live input: next pushed report, waiting up to timeout_ms (-1 = forever) like a real F1
+*/
+static int readLiveReport(MockLiveInput* live, unsigned char* data, size_t length, int timeout_ms) {
+    MockLiveReport item;
+    if (!live->queue.pop(item)) {
+        std::unique_lock<std::mutex> lock(live->wake_mutex);
+        auto has_report = [live, &item]() { return live->queue.pop(item); };
+        if (timeout_ms < 0) {
+            live->wake.wait(lock, has_report);
+        } else if (!live->wake.wait_for(lock, std::chrono::milliseconds(timeout_ms), has_report)) {
+            return 0;
+        }
+    }
+    int size = length < (size_t)item.size ? (int)length : item.size;
+    memcpy(data, item.data, size);
+    live->unwritten_stamp_ns = item.stamp_ns;
+    live->read_count.fetch_add(1, std::memory_order_relaxed);
+    return size;
+}
+
+int hid_read_timeout(hid_device* dev, unsigned char* data, size_t length, int timeout_ms) {
+    if (dev == nullptr || !dev->connected) {
+        return -1;
+    }
+    if (mock_live_inputs[dev->index] != nullptr) {
+        return readLiveReport(mock_live_inputs[dev->index], data, length, timeout_ms);
+    }
+    if (dev->next_report >= dev->report_count) {
+        if (!dev->loop || dev->report_count == 0) {
+            return 0;
+        }
+        dev->next_report = 0;
+    }
+    int size = length < (size_t)dev->report_size ? (int)length : dev->report_size;
+    memcpy(data, dev->reports + (size_t)dev->next_report * dev->report_size, size);
+    dev->next_report++;
+    return size;
+}
+
+int hid_read(hid_device* dev, unsigned char* data, size_t length) {
+    return hid_read_timeout(dev, data, length, -1);
+}
+
+int hid_set_nonblocking(hid_device*, int) {
+    return 0;
+}
+
+int hid_get_serial_number_string(hid_device* dev, wchar_t* string, size_t maxlen) {
+    if (dev == nullptr || maxlen == 0) {
+        return -1;
+    }
+    swprintf(string, maxlen, L"MOCK%d", dev->index);
+    return 0;
+}
+
+const wchar_t* hid_error(hid_device*) {
+    return L"mock device disconnected";
+}
+
+void hid_close(hid_device*) {
+}
+
+}
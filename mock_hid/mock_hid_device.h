@@ -0,0 +1,75 @@
+#ifndef MOCK_HID_DEVICE_H
+#define MOCK_HID_DEVICE_H
+
+#include <hidapi/hidapi.h>      // Mock declarations (mock_hid/ comes first on the include path)
+#include <cstdint>              // For uint64_t
+
+// =============================================================================
+// CONSTANTS - Mock F1 devices
+// =============================================================================
+
+const int MOCK_HID_MAX_DEVICES = 8;
+const int MOCK_HID_MAX_REPORT_SIZE = 128;       // Largest report a mock device stores (LED report = 81)
+const unsigned short MOCK_HID_VENDOR_ID = 0x17cc;
+const unsigned short MOCK_HID_PRODUCT_ID = 0x1120;
+const int MOCK_HID_LIVE_QUEUE_SIZE = 4096;      // Pushed input reports a device holds (power of two)
+const int MOCK_HID_LIVE_REPORT_SIZE = 64;       // Largest pushed input report (F1 input report = 22)
+
+// Called on every successful write (device thread)
+// @param input_stamp_ns: Stamp of the newest live input report read since the previous write, 0 if none
+typedef void (*MockHidWriteHook)(int index, const unsigned char* data, int size, uint64_t input_stamp_ns);
+
+// =============================================================================
+// FUNCTION DECLARATIONS - Control the mock F1s from benchmarks and tools
+// =============================================================================
+
+/*
+* Mock devices are numbered 0..count-1. hid_enumerate() lists the connected ones
+* (path "mock:<n>", serial "MOCK<n>"), hid_open_path()/hid_open() open them.
+* Reads return the scripted input reports one by one, then 0 (timeout) without
+* sleeping. Writes are counted and the last one is kept.
+*
+* Live input (stress test): another thread pushes reports while the device loop
+* runs, reads wait up to their timeout for the next one like a real F1.
+*/
+
+// Back to one connected device, no scripts, all counters 0
+void mockHidReset();
+
+// Number of connected mock F1s (1-MOCK_HID_MAX_DEVICES)
+void mockHidSetDeviceCount(int count);
+
+// Open handle of a mock device without going through hid_open_path()
+hid_device* mockHidOpenDevice(int index);
+
+// Input reports returned by reads (report_count * report_size bytes, not copied: must stay valid)
+// @param loop: Start over after the last report instead of returning timeouts
+void mockHidSetInputReports(int index, const unsigned char* reports, int report_count, int report_size, bool loop);
+
+// Unplug/replug: while disconnected, reads and writes fail and the device is not enumerated
+void mockHidSetConnected(int index, bool connected);
+
+// Switch a device to live input (scripted reports are ignored from now on)
+void mockHidEnableLiveInput(int index);
+
+// Producer side of live input (one thread per device), stamp is handed to the write hook
+// @return: false if the device's queue is full (report dropped)
+bool mockHidPushInputReport(int index, const unsigned char* report, int report_size, uint64_t stamp_ns);
+
+// Live input reports pushed but not read yet
+int mockHidGetPendingInputReports(int index);
+
+// Live input reports read so far (safe to call while the device loop runs)
+uint64_t mockHidGetReadCount(int index);
+
+// Hook for every write, nullptr to remove
+void mockHidSetWriteHook(MockHidWriteHook hook);
+
+// Writes seen by a device (all handles of the device count together)
+uint64_t mockHidGetWriteCount(int index);
+
+// Copy of the last write
+// @return: Size of the last write (0 if nothing was written yet)
+int mockHidGetLastWrite(int index, unsigned char* buffer, int buffer_size);
+
+#endif // MOCK_HID_DEVICE_H
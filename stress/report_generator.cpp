@@ -0,0 +1,126 @@
+#include "report_generator.h"              // Include header file
+
+#include <cstring>                          // For memset, strcmp
+#include "headers/input_reader.h"           // For INPUT_REPORT_SIZE, button bytes and masks
+#include "headers/input_reader_knob.h"      // For KNOB_BYTE_START, KNOB_COUNT
+#include "headers/input_reader_fader.h"     // For FADER_BYTE_START, FADER_COUNT
+#include "headers/input_reader_wheel.h"     // For WHEEL_BYTE_POSITION
+
+// =============================================================================
+// CONSTANTS - Pattern shapes
+// =============================================================================
+
+const int SWEEP_STEP = 32;                  // 12-bit value change per report (full sweep in 128 reports)
+const int SWEEP_MAX = 4095;
+const int WHEEL_TURN_REPORTS = 64;          // Reports per wheel direction
+const int WHEEL_PRESS_INTERVAL = 250;       // Every n-th report presses the wheel (loads the page)
+
+// =============================================================================
+// PATTERN NAMES
+// =============================================================================
+
+bool parseStressPattern(const char* text, StressPattern& pattern) {
+    if (strcmp(text, "faders") == 0) {
+        pattern = StressPattern::FADER_SWEEP;
+    } else if (strcmp(text, "pads") == 0) {
+        pattern = StressPattern::PAD_MASH;
+    } else if (strcmp(text, "wheel") == 0) {
+        pattern = StressPattern::WHEEL_SPIN;
+    } else if (strcmp(text, "mixed") == 0) {
+        pattern = StressPattern::MIXED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* getStressPatternName(StressPattern pattern) {
+    switch (pattern) {
+        case StressPattern::FADER_SWEEP: return "faders";
+        case StressPattern::PAD_MASH:    return "pads";
+        case StressPattern::WHEEL_SPIN:  return "wheel";
+        default:                         return "mixed";
+    }
+}
+
+// =============================================================================
+// REPORT GENERATOR
+// =============================================================================
+
+void ReportGenerator::initialize(StressPattern pattern, uint32_t seed) {
+    this->pattern = pattern;
+    random_state = seed != 0 ? seed : 1;
+    sequence = 0;
+    pressed_pads = 0;
+    wheel_position = 0;
+}
+
+/*
+* xorshift32 - same sequence on every run
+*/
+uint32_t ReportGenerator::nextRandom() {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+/*
+* Knobs and faders follow a triangle wave, each control a bit ahead of the previous one
+*/
+void ReportGenerator::addFaderSweep(unsigned char* report) {
+    for (int i = 0; i < KNOB_COUNT + FADER_COUNT; i++) {
+        int phase = (int)((sequence * SWEEP_STEP + (uint64_t)i * 512) % (2 * SWEEP_MAX));
+        int value = phase <= SWEEP_MAX ? phase : 2 * SWEEP_MAX - phase;
+        int byte = i < KNOB_COUNT ? KNOB_BYTE_START + i * KNOB_BYTES_PER_KNOB
+                                  : FADER_BYTE_START + (i - KNOB_COUNT) * FADER_BYTES_PER_FADER;
+        report[byte] = (unsigned char)(value & 0xff);           // LSB first
+        report[byte + 1] = (unsigned char)(value >> 8);
+    }
+}
+
+/*
+* One random pad changes per report: pressed if it was up, released if it was down
+*/
+void ReportGenerator::addPadMash(unsigned char* report) {
+    int pad = (int)(nextRandom() % 16);
+    pressed_pads ^= (uint16_t)(1u << pad);
+    for (int n = 0; n < 16; n++) {
+        if (pressed_pads & (1u << n)) {
+            report[BUTTON_BYTE_MATRIX_TOP + n / 8] |= (unsigned char)(0x80 >> (n % 8));
+        }
+    }
+}
+
+/*
+* One wheel step per report, direction changes every WHEEL_TURN_REPORTS reports
+*/
+void ReportGenerator::addWheelSpin(unsigned char* report) {
+    bool clockwise = (sequence / WHEEL_TURN_REPORTS) % 2 == 0;
+    wheel_position = (unsigned char)(wheel_position + (clockwise ? 1 : -1));
+    report[WHEEL_BYTE_POSITION] = wheel_position;
+    if (sequence % WHEEL_PRESS_INTERVAL == WHEEL_PRESS_INTERVAL - 1) {
+        report[BUTTON_BYTE_SPECIAL] |= BIT_MASK_SELECTOR_WHEEL;
+    }
+}
+
+/*
+* Builds the next report of the pattern
+*
+* @param report: Output buffer (INPUT_REPORT_SIZE bytes)
+*/
+void ReportGenerator::nextReport(unsigned char* report) {
+    memset(report, 0, INPUT_REPORT_SIZE);
+    report[0] = INPUT_REPORT_ID;
+
+    if (pattern == StressPattern::FADER_SWEEP || pattern == StressPattern::MIXED) {
+        addFaderSweep(report);
+    }
+    if (pattern == StressPattern::PAD_MASH || pattern == StressPattern::MIXED) {
+        addPadMash(report);
+    }
+    if (pattern == StressPattern::WHEEL_SPIN || pattern == StressPattern::MIXED) {
+        addWheelSpin(report);
+    }
+    sequence++;
+}
@@ -0,0 +1,51 @@
+#ifndef REPORT_GENERATOR_H
+#define REPORT_GENERATOR_H
+
+#include <cstdint>                      // For uint32_t, uint64_t
+
+// =============================================================================
+// ENUMS - Synthetic input patterns
+// =============================================================================
+
+enum class StressPattern {
+    FADER_SWEEP,        // All knobs and faders sweep up and down (overlay, OSC, state on every report)
+    PAD_MASH,           // Random matrix pads pressed and released (toggle edges, LED changes)
+    WHEEL_SPIN,         // Selector wheel turns back and forth, pressed now and then (page changes, scene loads)
+    MIXED               // All of the above in every report
+};
+
+// Parse "faders", "pads", "wheel" or "mixed"
+// @return: false if the name is unknown
+bool parseStressPattern(const char* text, StressPattern& pattern);
+
+const char* getStressPatternName(StressPattern pattern);
+
+// =============================================================================
+// REPORT GENERATOR - One per simulated F1
+// =============================================================================
+
+/*
+* Builds one valid 22-byte F1 input report per call
+* Deterministic for a given seed, so runs are comparable.
+*/
+class ReportGenerator {
+private:
+    StressPattern pattern = StressPattern::MIXED;
+    uint32_t random_state = 1;
+    uint64_t sequence = 0;
+    uint16_t pressed_pads = 0;          // Matrix pads held down, bit n = pad n
+    unsigned char wheel_position = 0;
+
+    uint32_t nextRandom();
+    void addFaderSweep(unsigned char* report);
+    void addPadMash(unsigned char* report);
+    void addWheelSpin(unsigned char* report);
+
+public:
+    void initialize(StressPattern pattern, uint32_t seed);
+
+    // Write the next report (INPUT_REPORT_SIZE bytes)
+    void nextReport(unsigned char* report);
+};
+
+#endif // REPORT_GENERATOR_H
@@ -0,0 +1,332 @@
+// Stress test: synthetic input at a fixed rate through the full device loop, against mock F1s
+// Build: cmake -S stress -B build-stress && cmake --build build-stress
+// Run:   ./build-stress/traktor_stress [--rate hz] [--seconds n] [--pattern faders|pads|wheel|mixed]
+//                                      [--devices n] [--no-osc] [--max-p99-us n] [--rt] [--rt-cpus list]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "mock_hid_device.h"                // Mock F1 (live input queue, write hook)
+#include "report_generator.h"               // ReportGenerator, StressPattern
+#include "headers/device_context.h"         // DeviceContext, enumerateF1Devices
+#include "headers/device_loop.h"            // serviceDevice
+#include "headers/input_reader.h"           // INPUT_REPORT_SIZE
+#include "headers/latency_tracer.h"         // LatencyHistogram, getLatencyClockNs, printLatencyHistograms
+#include "headers/osc_sender.h"             // OSC_DEFAULT_HOST, OSC_DEFAULT_PORT
+
+
+// =============================================================================
+// CONSTANTS AND OPTIONS
+// =============================================================================
+
+const int STRESS_DEFAULT_RATE_HZ = 1000;        // A real F1 sends at most about 250 reports per second
+const int STRESS_DEFAULT_SECONDS = 10;
+const int STRESS_SAMPLE_INTERVAL_MS = 10;       // Queue depth sampling
+const int STRESS_READY_TIMEOUT_MS = 5000;       // Startup sequence of every device
+const int STRESS_DRAIN_TIMEOUT_MS = 2000;       // Time the loops get to read what is left in the queues
+
+struct StressOptions {
+    int rate_hz = STRESS_DEFAULT_RATE_HZ;
+    int seconds = STRESS_DEFAULT_SECONDS;
+    StressPattern pattern = StressPattern::MIXED;
+    int devices = 1;
+    bool osc_enabled = true;
+    int max_p99_us = 0;                         // 0 = no latency limit
+    RealtimeConfig realtime;
+};
+
+static bool parseArguments(int argc, char* argv[], StressOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            options.rate_hz = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            options.seconds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--pattern") == 0 && i + 1 < argc) {
+            if (!parseStressPattern(argv[++i], options.pattern)) {
+                printf("Unknown pattern: %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--devices") == 0 && i + 1 < argc) {
+            options.devices = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-osc") == 0) {
+            options.osc_enabled = false;
+        } else if (strcmp(argv[i], "--max-p99-us") == 0 && i + 1 < argc) {
+            options.max_p99_us = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rt") == 0) {
+            options.realtime.enabled = true;
+        } else if (strcmp(argv[i], "--rt-cpus") == 0 && i + 1 < argc) {
+            if (!parseCpuList(argv[++i], options.realtime)) {
+                printf("Invalid CPU list: %s\n", argv[i]);
+                return false;
+            }
+        } else {
+            printf("Usage: %s [--rate hz] [--seconds n] [--pattern faders|pads|wheel|mixed] [--devices n]"
+                   " [--no-osc] [--max-p99-us n] [--rt] [--rt-cpus list]\n", argv[0]);
+            return false;
+        }
+    }
+    if (options.rate_hz < 1 || options.rate_hz > 1000000 || options.seconds < 1 ||
+        options.devices < 1 || options.devices > MOCK_HID_MAX_DEVICES) {
+        printf("Invalid rate, duration or device count\n");
+        return false;
+    }
+    return true;
+}
+
+
+// =============================================================================
+// MEASUREMENTS - Filled by generator threads, the write hook and the sampler
+// =============================================================================
+
+struct DeviceStats {
+    uint64_t generated = 0;                     // Generator thread only
+    uint64_t dropped = 0;                       // Queue full: the loop fell behind by a whole queue
+    uint64_t late_ns_max = 0;                   // Largest delay of the generator behind its schedule
+    std::atomic<uint64_t> led_writes{0};
+    LatencyHistogram input_to_write;            // Report generated -> LED report written (device thread)
+    int queue_depth_max = 0;                    // Sampler only
+    uint64_t queue_depth_sum = 0;
+    uint64_t queue_depth_samples = 0;
+};
+
+static DeviceStats device_stats[MOCK_HID_MAX_DEVICES];
+
+/*
+* Every LED report: time since the newest input report the loop read before it
+* (writes without a new input report, e.g. marquee steps, are not counted)
+*/
+static void recordLEDWrite(int index, const unsigned char*, int, uint64_t input_stamp_ns) {
+    device_stats[index].led_writes.fetch_add(1, std::memory_order_relaxed);
+    if (input_stamp_ns != 0) {
+        device_stats[index].input_to_write.record(getLatencyClockNs() - input_stamp_ns);
+    }
+}
+
+/*
+* Pushes reports at a fixed rate until end_ns
+* The schedule is absolute: after a late wake-up, reports are pushed back to back until on time again.
+*/
+static void generateReports(int index, const StressOptions& options, uint64_t start_ns, uint64_t end_ns) {
+    DeviceStats& stats = device_stats[index];
+    ReportGenerator generator;
+    generator.initialize(options.pattern, 0x9e3779b9u * (uint32_t)(index + 1));
+    unsigned char report[INPUT_REPORT_SIZE];
+
+    const uint64_t period_ns = 1000000000ull / (uint64_t)options.rate_hz;
+    uint64_t next_ns = start_ns;
+    while (next_ns < end_ns) {
+        uint64_t now_ns = getLatencyClockNs();
+        if (now_ns < next_ns) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(next_ns - now_ns));
+            now_ns = getLatencyClockNs();
+        }
+        if (now_ns - next_ns > stats.late_ns_max) {
+            stats.late_ns_max = now_ns - next_ns;
+        }
+
+        generator.nextReport(report);
+        stats.generated++;
+        if (!mockHidPushInputReport(index, report, INPUT_REPORT_SIZE, now_ns)) {
+            stats.dropped++;
+        }
+        next_ns += period_ns;
+    }
+}
+
+/*
+* Samples the input queue of every device until end_ns
+*/
+static void sampleQueueDepths(int device_count, uint64_t end_ns) {
+    while (getLatencyClockNs() < end_ns) {
+        for (int i = 0; i < device_count; i++) {
+            int depth = mockHidGetPendingInputReports(i);
+            DeviceStats& stats = device_stats[i];
+            if (depth > stats.queue_depth_max) {
+                stats.queue_depth_max = depth;
+            }
+            stats.queue_depth_sum += (uint64_t)depth;
+            stats.queue_depth_samples++;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(STRESS_SAMPLE_INTERVAL_MS));
+    }
+}
+
+
+// =============================================================================
+// SETUP - Mock F1s and their contexts, as main() opens real ones
+// =============================================================================
+
+static int openDevices(const StressOptions& options, DeviceContext** contexts) {
+    mockHidSetDeviceCount(options.devices);
+    for (int i = 0; i < options.devices; i++) {
+        mockHidEnableLiveInput(i);
+    }
+    mockHidSetWriteHook(recordLEDWrite);
+
+    F1DeviceInfo infos[MAX_F1_DEVICES];
+    int found = enumerateF1Devices(MOCK_HID_VENDOR_ID, MOCK_HID_PRODUCT_ID, infos, MAX_F1_DEVICES);
+    int count = 0;
+    for (int i = 0; i < found; i++) {
+        DeviceContext* context = new DeviceContext();
+        context->number = count + 1;
+        context->info = infos[i];
+        context->device = hid_open_path(infos[i].path);
+        if (options.osc_enabled) {
+            context->osc_sender.initialize(OSC_DEFAULT_HOST, OSC_DEFAULT_PORT, context->number);
+        }
+        contexts[count++] = context;
+    }
+
+    // State snapshots are published as with --no-shm (private segment, same seqlock writes)
+    if (count > 0) {
+        contexts[0]->state_publisher.openInProcess();
+        contexts[0]->published_state.current_page = contexts[0]->current_effect_page;
+        contexts[0]->state_publisher.publish(contexts[0]->published_state);
+    }
+    return count;
+}
+
+static bool waitUntilRunning(DeviceContext** contexts, int count) {
+    uint64_t deadline_ns = getLatencyClockNs() + (uint64_t)STRESS_READY_TIMEOUT_MS * 1000000ull;
+    for (int i = 0; i < count; i++) {
+        while (!contexts[i]->running.load()) {
+            if (getLatencyClockNs() > deadline_ns) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    return true;
+}
+
+static void waitUntilDrained(int count) {
+    uint64_t deadline_ns = getLatencyClockNs() + (uint64_t)STRESS_DRAIN_TIMEOUT_MS * 1000000ull;
+    for (int i = 0; i < count; i++) {
+        while (mockHidGetPendingInputReports(i) > 0 && getLatencyClockNs() < deadline_ns) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+/*
+* Prints one line per device and the pass/fail verdict
+*
+* @return: true if every device kept up (no drops, queue drained, rate held, p99 within the limit)
+*/
+static bool printResults(const StressOptions& options, int count, double run_seconds) {
+    bool passed = true;
+    printf("\n=== Stress results: %s, %d Hz per device, %.1f s ===\n",
+           getStressPatternName(options.pattern), options.rate_hz, run_seconds);
+    printf("%-6s %10s %8s %10s %12s %10s %9s %9s %9s %9s %9s %9s %10s\n",
+           "device", "generated", "dropped", "processed", "reports/s", "led/s", "queue", "queue",
+           "p50", "p99", "p99.9", "max", "gen late");
+    printf("%-6s %10s %8s %10s %12s %10s %9s %9s %9s %9s %9s %9s %10s\n",
+           "", "", "", "", "", "", "mean", "max", "(us)", "(us)", "(us)", "(us)", "max (us)");
+
+    for (int i = 0; i < count; i++) {
+        const DeviceStats& stats = device_stats[i];
+        uint64_t processed = mockHidGetReadCount(i);
+        double rate = processed / run_seconds;
+        double queue_mean = stats.queue_depth_samples > 0 ? (double)stats.queue_depth_sum / stats.queue_depth_samples : 0.0;
+        uint64_t p99_ns = stats.input_to_write.getPercentile(99.0);
+        printf("F1 #%-2d %10llu %8llu %10llu %12.1f %10.1f %9.2f %9d %9.1f %9.1f %9.1f %9.1f %10.1f\n",
+               i + 1, (unsigned long long)stats.generated, (unsigned long long)stats.dropped,
+               (unsigned long long)processed, rate, stats.led_writes.load() / run_seconds,
+               queue_mean, stats.queue_depth_max,
+               stats.input_to_write.getPercentile(50.0) / 1000.0, p99_ns / 1000.0,
+               stats.input_to_write.getPercentile(99.9) / 1000.0, stats.input_to_write.getMax() / 1000.0,
+               stats.late_ns_max / 1000.0);
+
+        // Verdict per device
+        if (stats.dropped > 0 || processed < stats.generated) {
+            printf("  F1 #%d fell behind: %llu reports dropped or never read\n",
+                   i + 1, (unsigned long long)(stats.generated - processed));
+            passed = false;
+        }
+        if (rate < options.rate_hz * 0.95) {
+            printf("  F1 #%d sustained %.1f reports/s, below 95%% of %d Hz\n", i + 1, rate, options.rate_hz);
+            passed = false;
+        }
+        if (options.max_p99_us > 0 && p99_ns > (uint64_t)options.max_p99_us * 1000ull) {
+            printf("  F1 #%d p99 latency %.1f us above %d us\n", i + 1, p99_ns / 1000.0, options.max_p99_us);
+            passed = false;
+        }
+    }
+
+#ifdef TRAKTOR_LATENCY_TRACING
+    // Where the time goes inside the loop (all devices together)
+    printLatencyHistograms();
+#endif
+
+    printf("\n%s\n", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+
+int main(int argc, char* argv[]) {
+    StressOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        return 2;
+    }
+
+    // Step 1: Mock F1s with live input, one context each
+    DeviceContext* contexts[MAX_F1_DEVICES];
+    int count = openDevices(options, contexts);
+    if (count == 0) {
+        printf("No mock F1 opened\n");
+        return 2;
+    }
+
+    // Step 2: Full device loop per F1, as in the program
+    if (options.realtime.enabled) {
+        lockProcessMemory();
+    }
+    std::thread device_threads[MAX_F1_DEVICES];
+    for (int i = 0; i < count; i++) {
+        device_threads[i] = std::thread(serviceDevice, std::ref(*contexts[i]), std::cref(options.realtime));
+    }
+    if (!waitUntilRunning(contexts, count)) {
+        printf("Device loops did not start\n");
+        return 2;
+    }
+    printf("\n- Generating %s input at %d Hz on %d F1(s) for %d s\n",
+           getStressPatternName(options.pattern), options.rate_hz, count, options.seconds);
+    fflush(stdout);
+
+    // Step 3: Generators on their own threads, queue depths sampled here
+    uint64_t start_ns = getLatencyClockNs();
+    uint64_t end_ns = start_ns + (uint64_t)options.seconds * 1000000000ull;
+    std::thread generator_threads[MAX_F1_DEVICES];
+    for (int i = 0; i < count; i++) {
+        generator_threads[i] = std::thread(generateReports, i, std::cref(options), start_ns, end_ns);
+    }
+    sampleQueueDepths(count, end_ns);
+    for (int i = 0; i < count; i++) {
+        generator_threads[i].join();
+    }
+
+    // Step 4: Let the loops finish the queued reports, then stop them
+    waitUntilDrained(count);
+    double run_seconds = (getLatencyClockNs() - start_ns) / 1e9;
+    for (int i = 0; i < count; i++) {
+        contexts[i]->stop_requested.store(true);
+    }
+    for (int i = 0; i < count; i++) {
+        device_threads[i].join();
+        contexts[i]->close();
+        delete contexts[i];
+    }
+
+    // Step 5: Throughput, queue depths and latency percentiles
+    return printResults(options, count, run_seconds) ? 0 : 1;
+}
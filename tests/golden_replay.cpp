@@ -0,0 +1,201 @@
+// Golden-frame regression test: replays a session through the device loop on scripted time
+// and compares every LED report written to the mock F1 with a golden file
+// Run:    ./build-tests/traktor_golden_replay <session> <golden> [--update]
+// Update: --update writes the golden file from this run (review the diff before committing it)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mock_hid_device.h"                // Mock F1 (write hook)
+#include "replay_session.h"                 // loadReplaySession, ReplayStep
+#include "headers/device_context.h"         // DeviceContext
+#include "headers/device_loop.h"            // runDeviceTick
+#include "headers/led_controller.h"         // beginLEDFrame, endLEDFrame
+#include "headers/tick_clock.h"             // MAIN_LOOP_TICK_MS
+
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+const uint64_t REPLAY_CLOCK_START_MS = 1000000;     // Session time 0 on the injected clock
+const int FRAME_BYTES_PER_LINE = 27;                // 81-byte LED report = 3 lines
+
+
+// =============================================================================
+// FRAME CAPTURE - Every LED report the mock F1 receives, as text
+// =============================================================================
+
+static std::ostringstream captured_frames;
+static int captured_frame_count = 0;
+static char current_label[REPLAY_TEXT_SIZE + 64] = "startup";
+
+static void captureFrame(int, const unsigned char* data, int size, uint64_t) {
+    captured_frames << "frame " << captured_frame_count++ << "  " << current_label << "\n";
+    char hex[4];
+    for (int i = 0; i < size; i++) {
+        snprintf(hex, sizeof(hex), "%02x", data[i]);
+        captured_frames << hex << ((i + 1) % FRAME_BYTES_PER_LINE == 0 || i + 1 == size ? "\n" : " ");
+    }
+}
+
+static void setLabel(uint64_t time_ms, const ReplayStep& step) {
+    snprintf(current_label, sizeof(current_label), "t=%llu  line %d: %s",
+             (unsigned long long)time_ms, step.line, step.text);
+}
+
+
+// =============================================================================
+// REPLAY
+// =============================================================================
+
+/*
+* Runs every step the way the device loop would see it
+* Input reports and idle ticks go through runDeviceTick(); zone, behavior and page
+* changes are applied inside one LED frame, like a control socket batch.
+*/
+static void replaySession(DeviceContext& context, const std::vector<ReplayStep>& steps) {
+    for (const ReplayStep& step : steps) {
+        uint64_t now_ms = REPLAY_CLOCK_START_MS + step.time_ms;
+        setLabel(step.time_ms, step);
+
+        switch (step.action) {
+            case ReplayAction::REPORT:
+                runDeviceTick(context, step.report, now_ms);
+                break;
+
+            case ReplayAction::IDLE:
+                for (uint64_t t = 0; t <= step.duration_ms; t += MAIN_LOOP_TICK_MS) {
+                    setLabel(step.time_ms + t, step);
+                    runDeviceTick(context, nullptr, now_ms + t);
+                }
+                break;
+
+            case ReplayAction::ZONE:
+                beginLEDFrame();
+                context.btn_toggle_system.setMatrixToggleMode(step.zone);
+                endLEDFrame();
+                break;
+
+            case ReplayAction::BEHAVIOR:
+                beginLEDFrame();
+                context.btn_toggle_system.setButtonBehavior(step.bit, step.behavior);
+                endLEDFrame();
+                break;
+
+            case ReplayAction::PAGE:
+                beginLEDFrame();
+                context.loadEffectsPage(step.page, now_ms);
+                endLEDFrame();
+                break;
+        }
+    }
+}
+
+
+// =============================================================================
+// GOLDEN FILE
+// =============================================================================
+
+static bool readFile(const char* path, std::string& text) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+/*
+* Prints the first frame that differs, golden and replayed side by side
+*/
+static void printFirstDifference(const std::string& expected, const std::string& actual) {
+    std::istringstream expected_lines(expected);
+    std::istringstream actual_lines(actual);
+    std::string expected_line;
+    std::string actual_line;
+    std::string frame_header = "(before the first frame)";
+    int line_number = 0;
+    while (true) {
+        bool has_expected = (bool)std::getline(expected_lines, expected_line);
+        bool has_actual = (bool)std::getline(actual_lines, actual_line);
+        line_number++;
+        if (!has_expected && !has_actual) {
+            return;
+        }
+        if (has_expected && has_actual && expected_line == actual_line) {
+            if (expected_line.rfind("frame ", 0) == 0) {
+                frame_header = expected_line;
+            }
+            continue;
+        }
+        std::cout << "First difference at golden line " << line_number << ", in " << frame_header << std::endl;
+        std::cout << "  golden:   " << (has_expected ? expected_line : "(end of file)") << std::endl;
+        std::cout << "  replayed: " << (has_actual ? actual_line : "(end of replay)") << std::endl;
+        return;
+    }
+}
+
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4 || (argc == 4 && strcmp(argv[3], "--update") != 0)) {
+        std::cout << "Usage: " << argv[0] << " <session> <golden> [--update]" << std::endl;
+        return 2;
+    }
+    const char* session_path = argv[1];
+    const char* golden_path = argv[2];
+    bool update = argc == 4;
+
+    // Step 1: Session script
+    std::vector<ReplayStep> steps;
+    if (!loadReplaySession(session_path, steps)) {
+        return 2;
+    }
+
+    // Step 2: Mock F1, every LED report captured (startup sequence and first page included)
+    mockHidSetWriteHook(captureFrame);
+    DeviceContext context;
+    context.device = mockHidOpenDevice(0);
+    if (!context.initialize()) {
+        return 2;
+    }
+
+    // Step 3: Replay on the injected clock
+    replaySession(context, steps);
+    context.close();
+
+    // Step 4: Compare with (or write) the golden file
+    std::string actual = "# Golden LED frames for " + std::string(session_path).substr(std::string(session_path).find_last_of('/') + 1) +
+                         " - regenerate with --update\n" + captured_frames.str();
+    if (update) {
+        std::ofstream file(golden_path);
+        file << actual;
+        if (!file) {
+            std::cout << "Cannot write " << golden_path << std::endl;
+            return 2;
+        }
+        std::cout << std::endl << "Wrote " << captured_frame_count << " frames to " << golden_path << std::endl;
+        return 0;
+    }
+
+    std::string expected;
+    if (!readFile(golden_path, expected)) {
+        std::cout << "No golden file " << golden_path << " (run with --update to create it)" << std::endl;
+        return 1;
+    }
+    if (expected != actual) {
+        std::cout << std::endl << "FAIL " << session_path << ": LED frames differ from " << golden_path << std::endl;
+        printFirstDifference(expected, actual);
+        return 1;
+    }
+    std::cout << std::endl << "PASS " << session_path << ": " << captured_frame_count << " frames match" << std::endl;
+    return 0;
+}
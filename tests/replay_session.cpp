@@ -0,0 +1,290 @@
+#include "replay_session.h"                 // Include header file
+
+#include <iostream>                         // For std::cerr
+#include <fstream>                          // For std::ifstream
+#include <string>                           // For std::string, std::getline
+#include <cstring>                          // For strcmp, strtok, strncpy
+#include <cstdlib>                          // For strtol, strtoull
+#include "headers/input_reader_knob.h"      // For KNOB_BYTE_START, KNOB_COUNT
+#include "headers/input_reader_fader.h"     // For FADER_BYTE_START, FADER_COUNT
+#include "headers/input_reader_wheel.h"     // For WHEEL_BYTE_POSITION
+
+// =============================================================================
+// BUTTON NAMES
+// =============================================================================
+
+// One F1 button: where it sits in the input report and its toggle bit (-1 = no LED)
+struct ReplayButton {
+    int byte;
+    unsigned char mask;
+    int bit;
+};
+
+struct NamedButton {
+    const char* name;
+    int byte;
+    unsigned char mask;
+};
+
+static const NamedButton NAMED_BUTTONS[] = {
+    { "shift",   BUTTON_BYTE_SPECIAL,          BIT_MASK_SHIFT },
+    { "reverse", BUTTON_BYTE_SPECIAL,          BIT_MASK_REVERSE },
+    { "type",    BUTTON_BYTE_SPECIAL,          BIT_MASK_TYPE },
+    { "size",    BUTTON_BYTE_SPECIAL,          BIT_MASK_SIZE },
+    { "browse",  BUTTON_BYTE_SPECIAL,          BIT_MASK_BROWSE },
+    { "wheel",   BUTTON_BYTE_SPECIAL,          BIT_MASK_SELECTOR_WHEEL },
+    { "sync",    BUTTON_BYTE_STOP_AND_CONTROL, BIT_MASK_SYNC },
+    { "quant",   BUTTON_BYTE_STOP_AND_CONTROL, BIT_MASK_QUANT },
+    { "capture", BUTTON_BYTE_STOP_AND_CONTROL, BIT_MASK_CAPTURE },
+};
+
+static int getNamedButtonBit(const char* name) {
+    if (strcmp(name, "shift") == 0)   return ButtonToggleSystem::getSpecialButtonBit(SpecialLEDButton::SHIFT);
+    if (strcmp(name, "reverse") == 0) return ButtonToggleSystem::getSpecialButtonBit(SpecialLEDButton::REVERSE);
+    if (strcmp(name, "type") == 0)    return ButtonToggleSystem::getSpecialButtonBit(SpecialLEDButton::TYPE);
+    if (strcmp(name, "size") == 0)    return ButtonToggleSystem::getSpecialButtonBit(SpecialLEDButton::SIZE);
+    if (strcmp(name, "browse") == 0)  return ButtonToggleSystem::getSpecialButtonBit(SpecialLEDButton::BROWSE);
+    if (strcmp(name, "sync") == 0)    return ButtonToggleSystem::getControlButtonBit(ControlLEDButton::SYNC);
+    if (strcmp(name, "quant") == 0)   return ButtonToggleSystem::getControlButtonBit(ControlLEDButton::QUANT);
+    if (strcmp(name, "capture") == 0) return ButtonToggleSystem::getControlButtonBit(ControlLEDButton::CAPTURE);
+    return -1;      // Selector wheel press has no LED
+}
+
+static bool parseInt(const char* text, long min_value, long max_value, long& value) {
+    if (text == nullptr) {
+        return false;
+    }
+    char* end = nullptr;
+    value = strtol(text, &end, 0);
+    return *end == '\0' && value >= min_value && value <= max_value;
+}
+
+/*
+* Parses a button name (and for pad/stop its position) from the next tokens
+*/
+static bool parseButton(const char* name, ReplayButton& button) {
+    long row = 0;
+    long col = 0;
+    long stop = 0;
+    if (name == nullptr) {
+        return false;
+    }
+    if (strcmp(name, "pad") == 0) {
+        if (!parseInt(strtok(nullptr, " \t"), 1, 4, row) || !parseInt(strtok(nullptr, " \t"), 1, 4, col)) {
+            return false;
+        }
+        MatrixPad pad;
+        MatrixPad::fromRowCol((int)row, (int)col, pad);
+        button.byte = BUTTON_BYTE_MATRIX_TOP + pad.index() / 8;
+        button.mask = (unsigned char)(0x80 >> (pad.index() % 8));
+        button.bit = ButtonToggleSystem::getMatrixButtonBit(pad);
+        return true;
+    }
+    if (strcmp(name, "stop") == 0) {
+        if (!parseInt(strtok(nullptr, " \t"), 1, 4, stop)) {
+            return false;
+        }
+        static const StopLEDButton stop_buttons[] = { StopLEDButton::STOP1, StopLEDButton::STOP2,
+                                                      StopLEDButton::STOP3, StopLEDButton::STOP4 };
+        button.byte = BUTTON_BYTE_STOP_AND_CONTROL;
+        button.mask = (unsigned char)(BIT_MASK_STOP1 >> (stop - 1));
+        button.bit = ButtonToggleSystem::getStopButtonBit(stop_buttons[stop - 1]);
+        return true;
+    }
+    for (const NamedButton& named : NAMED_BUTTONS) {
+        if (strcmp(name, named.name) == 0) {
+            button.byte = named.byte;
+            button.mask = named.mask;
+            button.bit = getNamedButtonBit(name);
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseZone(const char* name, MatrixToggleZone& zone) {
+    static const struct { const char* name; MatrixToggleZone zone; } ZONES[] = {
+        { "full_matrix", MatrixToggleZone::FULL_MATRIX },
+        { "left_right_split", MatrixToggleZone::LEFT_RIGHT_SPLIT },
+        { "rows", MatrixToggleZone::ROWS },
+        { "columns", MatrixToggleZone::COLUMNS },
+        { "quadrants", MatrixToggleZone::QUADRANTS },
+        { "free", MatrixToggleZone::FREE },
+    };
+    for (const auto& entry : ZONES) {
+        if (name != nullptr && strcmp(name, entry.name) == 0) {
+            zone = entry.zone;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+* Parses a behavior name; cycle steps through red, green and blue at full brightness
+*/
+static bool parseBehavior(const char* name, ButtonBehaviorConfig& config) {
+    if (name == nullptr) {
+        return false;
+    }
+    if (strcmp(name, "latch") == 0) {
+        config = makeButtonBehavior(ButtonBehavior::LATCH);
+    } else if (strcmp(name, "radio") == 0) {
+        config = makeButtonBehavior(ButtonBehavior::RADIO);
+    } else if (strcmp(name, "momentary") == 0) {
+        config = makeButtonBehavior(ButtonBehavior::MOMENTARY);
+    } else if (strcmp(name, "cycle") == 0) {
+        static const LEDColor colors[] = { LEDColor::red, LEDColor::green, LEDColor::blue };
+        static const float brightness[] = { 1.0f, 1.0f, 1.0f };
+        config = makeCycleBehavior(colors, brightness, 3);
+    } else if (strcmp(name, "one_shot") == 0) {
+        long flash_ms = DEFAULT_ONE_SHOT_MS;
+        const char* argument = strtok(nullptr, " \t");
+        if (argument != nullptr && !parseInt(argument, 1, 60000, flash_ms)) {
+            return false;
+        }
+        config = makeOneShotBehavior((uint16_t)flash_ms);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// SESSION FILE
+// =============================================================================
+
+/*
+* Parses one command (tokens after the time) into step
+* report holds the input state so far and is updated by REPORT commands
+*/
+static bool parseCommand(const char* command, unsigned char* report, ReplayStep& step) {
+    long value = 0;
+    long number = 0;
+    ReplayButton button;
+    step.action = ReplayAction::REPORT;
+
+    if (command == nullptr) {
+        return false;
+    }
+    if (strcmp(command, "press") == 0 || strcmp(command, "release") == 0) {
+        if (!parseButton(strtok(nullptr, " \t"), button)) {
+            return false;
+        }
+        if (strcmp(command, "press") == 0) {
+            report[button.byte] |= button.mask;
+        } else {
+            report[button.byte] &= (unsigned char)~button.mask;
+        }
+    } else if (strcmp(command, "knob") == 0 || strcmp(command, "fader") == 0) {
+        bool knob = strcmp(command, "knob") == 0;
+        if (!parseInt(strtok(nullptr, " \t"), 1, knob ? KNOB_COUNT : FADER_COUNT, number) ||
+            !parseInt(strtok(nullptr, " \t"), 0, 4095, value)) {
+            return false;
+        }
+        int byte = knob ? KNOB_BYTE_START + (int)(number - 1) * KNOB_BYTES_PER_KNOB
+                        : FADER_BYTE_START + (int)(number - 1) * FADER_BYTES_PER_FADER;
+        report[byte] = (unsigned char)(value & 0xff);       // LSB first
+        report[byte + 1] = (unsigned char)(value >> 8);
+    } else if (strcmp(command, "turn") == 0) {
+        if (!parseInt(strtok(nullptr, " \t"), -127, 127, value) || value == 0) {
+            return false;
+        }
+        report[WHEEL_BYTE_POSITION] = (unsigned char)(report[WHEEL_BYTE_POSITION] + value);
+    } else if (strcmp(command, "report") == 0) {
+        for (int i = 0; i < INPUT_REPORT_SIZE; i++) {
+            if (!parseInt(strtok(nullptr, " \t"), 0, 255, value)) {
+                return false;
+            }
+            report[i] = (unsigned char)value;
+        }
+    } else if (strcmp(command, "idle") == 0) {
+        step.action = ReplayAction::IDLE;
+        if (!parseInt(strtok(nullptr, " \t"), 0, 3600000, value)) {
+            return false;
+        }
+        step.duration_ms = (uint64_t)value;
+        return strtok(nullptr, " \t") == nullptr;
+    } else if (strcmp(command, "zone") == 0) {
+        step.action = ReplayAction::ZONE;
+        return parseZone(strtok(nullptr, " \t"), step.zone);
+    } else if (strcmp(command, "behavior") == 0) {
+        step.action = ReplayAction::BEHAVIOR;
+        if (!parseButton(strtok(nullptr, " \t"), button) || button.bit < 0) {
+            return false;
+        }
+        step.bit = button.bit;
+        return parseBehavior(strtok(nullptr, " \t"), step.behavior);
+    } else if (strcmp(command, "page") == 0) {
+        step.action = ReplayAction::PAGE;
+        if (!parseInt(strtok(nullptr, " \t"), 1, 99, value)) {
+            return false;
+        }
+        step.page = (int)value;
+        return strtok(nullptr, " \t") == nullptr;
+    } else {
+        return false;
+    }
+
+    // Input report commands: the step carries the whole report
+    memcpy(step.report, report, INPUT_REPORT_SIZE);
+    return strtok(nullptr, " \t") == nullptr;
+}
+
+/*
+* Reads a session file
+*
+* @param path: Session file
+* @param steps: Output, one step per command
+* @return: false if the file cannot be read or a line is invalid
+*/
+bool loadReplaySession(const char* path, std::vector<ReplayStep>& steps) {
+    // Step 1: Open file
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "ReplaySession Error: Cannot read " << path << std::endl;
+        return false;
+    }
+
+    // Step 2: One command per line, the input state carries over from line to line
+    unsigned char report[INPUT_REPORT_SIZE] = { INPUT_REPORT_ID };
+    uint64_t last_time_ms = 0;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        size_t last = line.find_last_not_of(" \t\r");
+        if (last == std::string::npos) {
+            continue;
+        }
+        line.erase(last + 1);
+
+        ReplayStep step;
+        step.line = line_number;
+        size_t command = line.find_first_of(" \t", line.find_first_not_of(" \t"));
+        if (command != std::string::npos) {
+            command = line.find_first_not_of(" \t", command);
+            strncpy(step.text, line.c_str() + command, sizeof(step.text) - 1);
+        }
+
+        char buffer[512];
+        strncpy(buffer, line.c_str(), sizeof(buffer) - 1);
+        buffer[sizeof(buffer) - 1] = '\0';
+        char* time_token = strtok(buffer, " \t");
+        char* end = nullptr;
+        step.time_ms = strtoull(time_token, &end, 10);
+        if (*end != '\0' || step.time_ms < last_time_ms || !parseCommand(strtok(nullptr, " \t"), report, step)) {
+            std::cerr << "ReplaySession Error: " << path << ":" << line_number << ": cannot parse '" << step.text
+                      << "'" << std::endl;
+            return false;
+        }
+        // Idle ticks run up to time + duration, the next command comes after them
+        last_time_ms = step.action == ReplayAction::IDLE ? step.time_ms + step.duration_ms : step.time_ms;
+        steps.push_back(step);
+    }
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef REPLAY_SESSION_H
+#define REPLAY_SESSION_H
+
+#include <cstdint>                          // For uint64_t
+#include <vector>                           // For std::vector (sessions of any length)
+#include "headers/input_reader.h"           // For INPUT_REPORT_SIZE
+#include "headers/led_controller_toggle.h"  // For MatrixToggleZone, ButtonBehaviorConfig
+
+// =============================================================================
+// SESSION SCRIPT - Input sequences replayed through the device loop
+// =============================================================================
+
+/*
+* One command per line, "<time_ms> <command> [arguments]", times never go back.
+* Buttons: pad <row> <col>, shift, reverse, type, size, browse, wheel, sync, quant, capture, stop <1-4>
+*
+*   0    press pad 1 1          Press a button (one input report, other buttons stay as they are)
+*   20   release pad 1 1        Release it (one input report)
+*   40   knob 2 2048            Move a knob or fader to a 12-bit value (one input report)
+*   60   fader 4 0
+*   80   turn +1                Turn the selector wheel by n steps (one input report)
+*   100  report 01 00 ...       Raw 22-byte input report, e.g. from a recorded session
+*   120  idle 200               Ticks without input every 10 ms, from 120 up to 320
+*   400  zone rows              Matrix zone mode (full_matrix, left_right_split, rows, columns, quadrants, free)
+*   420  behavior pad 1 1 one_shot 150    Button behavior (latch, radio, momentary, cycle, one_shot [ms])
+*   440  page 2                 Load an effects page, as the control socket does
+*/
+
+enum class ReplayAction {
+    REPORT,         // Input report (press, release, knob, fader, turn, report)
+    IDLE,           // Ticks without input
+    ZONE,           // setMatrixToggleMode()
+    BEHAVIOR,       // setButtonBehavior()
+    PAGE            // loadEffectsPage()
+};
+
+const int REPLAY_TEXT_SIZE = 96;
+
+struct ReplayStep {
+    int line = 0;                               // Line in the session file
+    char text[REPLAY_TEXT_SIZE] = "";           // Command as written (frame labels)
+    uint64_t time_ms = 0;
+    ReplayAction action = ReplayAction::IDLE;
+
+    unsigned char report[INPUT_REPORT_SIZE] = {};   // REPORT: whole report after this command
+    uint64_t duration_ms = 0;                       // IDLE
+    MatrixToggleZone zone = MatrixToggleZone::FULL_MATRIX;
+    int bit = -1;                                   // BEHAVIOR: toggle bit of the button
+    ButtonBehaviorConfig behavior = {};
+    int page = 1;
+};
+
+// Parse a session file
+// @return: false (with file and line on stderr) if a line cannot be parsed
+bool loadReplaySession(const char* path, std::vector<ReplayStep>& steps);
+
+#endif // REPLAY_SESSION_H
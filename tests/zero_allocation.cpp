@@ -0,0 +1,281 @@
+// Zero-allocation test: runs the device loop (serviceDevice) against a mock F1 with
+// synthetic input and fails if it allocates once it is warmed up
+// Run:  ./build-tests/traktor_zero_allocation [--reports n] [--warmup n] [--backtrace]
+// Built with TRAKTOR_COUNT_ALLOCATIONS (global operator new/malloc count every allocation)
+// OSC and Art-Net go to ports the test binds itself, nothing reaches other software on the machine
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "mock_hid_device.h"                // Mock F1 (live input queue)
+#include "stress/report_generator.h"        // ReportGenerator (same input as the stress test)
+#include "headers/allocation_counter.h"     // getAllocationCount, setAllocationBacktraces
+#include "headers/device_context.h"         // DeviceContext
+#include "headers/device_loop.h"            // serviceDevice
+#include "headers/dmx_output.h"             // DmxProtocol, DMX_DEFAULT_REFRESH_HZ
+#include "headers/input_reader.h"           // INPUT_REPORT_SIZE
+#include "headers/led_frame_receiver.h"     // writeLEDFrame (renderer frames between reports)
+#include "headers/tick_clock.h"             // MAIN_LOOP_TICK_MS
+
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+const int DEFAULT_MEASURED_REPORTS = 20000;
+const int DEFAULT_WARMUP_REPORTS = 2000;        // Every page, overlay and behavior used once
+const int MAX_QUEUED_REPORTS = MOCK_HID_LIVE_QUEUE_SIZE / 2;
+const int IDLE_TICKS_AFTER_INPUT = 30;          // Timers, flashes and overlays run out without input
+const int REPORTS_PER_LED_FRAME = 50;           // An external renderer frame now and then
+const int REPORTS_PER_FEEDBACK = 25;            // OSC feedback message and control socket request
+const uint32_t REPORT_SEED = 48;
+
+
+// =============================================================================
+// LOCAL SOCKETS - Output sinks and feedback clients, all set up before measuring
+// =============================================================================
+
+struct TestSockets {
+    int osc_sink_fd = -1;               // Receives OSC output
+    int dmx_sink_fd = -1;               // Receives Art-Net output
+    int feedback_fd = -1;               // Sends OSC feedback to the listener
+    int control_fd = -1;                // Control socket client
+    sockaddr_in listener_address = {};
+    unsigned char feedback_packets[2][64];
+    int feedback_lengths[2] = {0, 0};
+};
+
+// UDP socket on 127.0.0.1, port chosen by the kernel
+static int openUdpSink(int& port) {
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (fd < 0 || bind(fd, (const sockaddr*)&address, sizeof(address)) != 0 ||
+        getsockname(fd, (sockaddr*)&address, &length) != 0) {
+        return -1;
+    }
+    port = ntohs(address.sin_port);
+    return fd;
+}
+
+// Appends an OSC string (0-terminated, padded to 4 bytes)
+static int putOscString(unsigned char* packet, int offset, const char* text) {
+    int length = (int)strlen(text) + 1;
+    memcpy(packet + offset, text, length);
+    int padded = (length + 3) & ~3;
+    memset(packet + offset + length, 0, padded - length);
+    return offset + padded;
+}
+
+static int putOscInt(unsigned char* packet, int offset, uint32_t value) {
+    value = htonl(value);
+    memcpy(packet + offset, &value, 4);
+    return offset + 4;
+}
+
+// Two feedback messages: a pad color with brightness and the display number
+static void buildFeedbackPackets(TestSockets& sockets) {
+    float brightness = 0.5f;
+    uint32_t brightness_bits;
+    memcpy(&brightness_bits, &brightness, 4);
+    int length = putOscString(sockets.feedback_packets[0], 0, "/f1/led/matrix/2/3");
+    length = putOscString(sockets.feedback_packets[0], length, ",sf");
+    length = putOscString(sockets.feedback_packets[0], length, "red");
+    sockets.feedback_lengths[0] = putOscInt(sockets.feedback_packets[0], length, brightness_bits);
+
+    length = putOscString(sockets.feedback_packets[1], 0, "/f1/display/number");
+    length = putOscString(sockets.feedback_packets[1], length, ",i");
+    sockets.feedback_lengths[1] = putOscInt(sockets.feedback_packets[1], length, 42);
+}
+
+static int connectControlClient(const char* path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    if (fd < 0 || connect(fd, (const sockaddr*)&address, sizeof(address)) != 0) {
+        return -1;
+    }
+    return fd;
+}
+
+// Drops whatever arrived on a socket (fixed buffer, no allocation)
+static void drainSocket(int fd) {
+    static unsigned char discard[2048];
+    while (recv(fd, discard, sizeof(discard), MSG_DONTWAIT) > 0) {
+    }
+}
+
+/*
+* One OSC feedback message to the listener and one request to the control socket
+*/
+static void sendFeedback(TestSockets& sockets, int step) {
+    static const char request[] = "led stop 2 0.5; display text hi; state\n";
+    int packet = step % 2;
+    (void)!sendto(sockets.feedback_fd, sockets.feedback_packets[packet], sockets.feedback_lengths[packet], 0,
+                  (const sockaddr*)&sockets.listener_address, sizeof(sockets.listener_address));
+    (void)!send(sockets.control_fd, request, sizeof(request) - 1, MSG_NOSIGNAL);
+    drainSocket(sockets.control_fd);
+    drainSocket(sockets.osc_sink_fd);
+    drainSocket(sockets.dmx_sink_fd);
+}
+
+// =============================================================================
+// INPUT - Pushed from this thread, which does not allocate while measuring
+// =============================================================================
+
+static void sleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/*
+* Pushes reports into the F1's live input queue and waits until the device loop read all of them
+* @return: false if the device loop stopped reading
+*/
+static bool pushReports(DeviceContext& context, ReportGenerator& generator, TestSockets& sockets, int count) {
+    unsigned char report[INPUT_REPORT_SIZE];
+    ExternalLEDFrame frame = {};
+    frame.flags = LED_FRAME_HAS_MATRIX;
+    for (int i = 0; i < count; i++) {
+        if (i % REPORTS_PER_LED_FRAME == 0) {
+            frame.matrix_rgb[(i / REPORTS_PER_LED_FRAME) % 4][0][0] ^= 0xff;
+            writeLEDFrame(context.led_frame_receiver.getSegment(), frame);
+        }
+        if (i % REPORTS_PER_FEEDBACK == 0) {
+            sendFeedback(sockets, i / REPORTS_PER_FEEDBACK);
+        }
+        generator.nextReport(report);
+        while (mockHidGetPendingInputReports(0) >= MAX_QUEUED_REPORTS) {
+            sleepMs(1);
+        }
+        mockHidPushInputReport(0, report, INPUT_REPORT_SIZE, 0);
+    }
+    for (int waited_ms = 0; mockHidGetPendingInputReports(0) > 0; waited_ms++) {
+        if (waited_ms > 10000) {
+            return false;
+        }
+        sleepMs(1);
+    }
+    sleepMs(IDLE_TICKS_AFTER_INPUT * MAIN_LOOP_TICK_MS);
+    return true;
+}
+
+
+int main(int argc, char* argv[]) {
+    int measured_reports = DEFAULT_MEASURED_REPORTS;
+    int warmup_reports = DEFAULT_WARMUP_REPORTS;
+    bool backtraces = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--reports") == 0 && i + 1 < argc) {
+            measured_reports = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            warmup_reports = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--backtrace") == 0) {
+            backtraces = true;
+        } else {
+            printf("Usage: %s [--reports n] [--warmup n] [--backtrace]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!isAllocationCountingEnabled()) {
+        printf("Allocation counting is not compiled in (TRAKTOR_COUNT_ALLOCATIONS)\n");
+        return 2;
+    }
+
+    // Step 1: Mock F1 with live input, every integration of the device loop on
+    // (outputs go to sockets of this test, feedback comes from this test)
+    TestSockets sockets;
+    int osc_port = 0;
+    int dmx_port = 0;
+    sockets.osc_sink_fd = openUdpSink(osc_port);
+    sockets.dmx_sink_fd = openUdpSink(dmx_port);
+    sockets.feedback_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sockets.osc_sink_fd < 0 || sockets.dmx_sink_fd < 0 || sockets.feedback_fd < 0) {
+        printf("FAIL: cannot open local UDP sockets\n");
+        return 2;
+    }
+    buildFeedbackPackets(sockets);
+
+    mockHidEnableLiveInput(0);
+    DeviceContext context;
+    context.number = 1;
+    context.device = mockHidOpenDevice(0);
+    context.osc_sender.initialize("127.0.0.1", osc_port, context.number);
+    context.osc_listener.initialize(0);
+    context.state_publisher.openInProcess();
+    context.led_frame_receiver.openInProcess();
+    context.midi_output.openTextSink("/dev/null");
+    context.dmx_output.initialize(DmxProtocol::ARTNET, "127.0.0.1", dmx_port, 0, DMX_DEFAULT_REFRESH_HZ);
+
+    char control_path[64];
+    snprintf(control_path, sizeof(control_path), "/tmp/traktor-zero-allocation-%d.sock", (int)getpid());
+    context.control_server.start(control_path, context.state_publisher.getSegment());
+    sockets.control_fd = connectControlClient(control_path);
+
+    sockets.listener_address.sin_family = AF_INET;
+    sockets.listener_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sockets.listener_address.sin_port = htons((uint16_t)context.osc_listener.getPort());
+    if (!context.osc_listener.isOpen() || sockets.control_fd < 0) {
+        printf("FAIL: OSC listener or control socket did not open\n");
+        return 2;
+    }
+
+    // Step 2: The device loop on its own thread, exactly as the program runs it
+    RealtimeConfig realtime;
+    std::thread device_thread(serviceDevice, std::ref(context), std::cref(realtime));
+    for (int waited_ms = 0; !context.running.load(); waited_ms++) {
+        if (waited_ms > 10000) {
+            printf("FAIL: device loop did not start\n");
+            return 2;
+        }
+        sleepMs(1);
+    }
+
+    // Step 3: Warm-up (first page loads, overlays, lazily sized buffers)
+    ReportGenerator generator;
+    generator.initialize(StressPattern::MIXED, REPORT_SEED);
+    bool read_all = pushReports(context, generator, sockets, warmup_reports);
+
+    // Step 4: Steady state, every allocation from here on is a failure
+    setAllocationBacktraces(backtraces);
+    uint64_t allocations_before = getAllocationCount();
+    uint64_t bytes_before = getAllocatedBytes();
+    read_all = read_all && pushReports(context, generator, sockets, measured_reports);
+    setAllocationBacktraces(false);
+    uint64_t allocations = getAllocationCount() - allocations_before;
+    uint64_t bytes = getAllocatedBytes() - bytes_before;
+
+    context.stop_requested.store(true);
+    device_thread.join();
+    ::close(sockets.control_fd);
+    context.close();
+    ::close(sockets.osc_sink_fd);
+    ::close(sockets.dmx_sink_fd);
+    ::close(sockets.feedback_fd);
+
+    // Step 5: Result
+    printf("\n%d reports after %d warm-up reports: %llu allocations, %llu bytes\n", measured_reports, warmup_reports,
+           (unsigned long long)allocations, (unsigned long long)bytes);
+    if (!read_all) {
+        printf("FAIL: the device loop stopped reading input\n");
+        return 1;
+    }
+    printf("OSC feedback applied: %u, ignored: %u\n", context.osc_listener.getAppliedCount(),
+           context.osc_listener.getIgnoredCount());
+    if (allocations != 0) {
+        printf("FAIL: the device loop allocated (run with --backtrace to see where)\n");
+        return 1;
+    }
+    printf("PASS: no allocations in the steady state\n");
+    return 0;
+}